@@ -0,0 +1,204 @@
+/******************************************************************************/
+/**
+@file		bench_bpp_page_size.c
+@brief		Sweeps the B+ tree node page size and reports tree height, lookup
+			latency and insert throughput for each size.
+@details	Usage: bench_bpp_tree [num_keys] [value_size]
+
+			Keys are inserted and then looked up in two different scrambled
+			orders so that neither pass walks the leaves sequentially.
+@copyright	Copyright 2017
+			The University of British Columbia,
+			IonDB Project Contributors (see AUTHORS.md)
+@par Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+@par 1.Redistributions of source code must retain the above copyright notice,
+	this list of conditions and the following disclaimer.
+
+@par 2.Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+@par 3.Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+@par THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+	ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+	LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+	CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+	SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+	INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+	CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+	ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../../dictionary/dictionary.h"
+#include "../../dictionary/bpp_tree/bpp_tree_handler.h"
+
+#define BENCH_DEFAULT_NUM_KEYS		100000
+#define BENCH_DEFAULT_VALUE_SIZE	sizeof(int)
+#define BENCH_MIN_PAGE_SIZE			256
+#define BENCH_MAX_PAGE_SIZE			16384
+#define BENCH_DICTIONARY_ID			1
+
+/* multipliers coprime with every key count that is not a multiple of them */
+#define BENCH_INSERT_STRIDE			7919
+#define BENCH_LOOKUP_STRIDE			104729
+
+static double
+bench_now(
+	void
+) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/**
+@brief		Maps @p i onto a scrambled position in [0, @p num_keys).
+*/
+static int
+bench_scramble(
+	long	i,
+	long	stride,
+	long	num_keys
+) {
+	return (int) ((i * stride) % num_keys);
+}
+
+/**
+@brief		Builds a tree with @p page_size byte nodes and prints one row.
+
+@return		0 on success, nonzero if any operation failed.
+*/
+static int
+bench_page_size(
+	int		page_size,
+	long	num_keys,
+	int		value_size
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dictionary;
+	ion_dictionary_stats_t		stats;
+	ion_byte_t					*value;
+	char						filename[ION_MAX_FILENAME_LENGTH];
+	unsigned long				reads;
+	double						start;
+	double						insert_time;
+	double						lookup_time;
+	long						i;
+	int							key;
+
+	value = calloc(1, value_size);
+
+	if (NULL == value) {
+		return 1;
+	}
+
+	/* an index left by an interrupted run would keep its old page size */
+	dictionary_get_filename(BENCH_DICTIONARY_ID, "bpt", filename);
+	ion_fremove(filename);
+	dictionary_get_filename(BENCH_DICTIONARY_ID, "val", filename);
+	ion_fremove(filename);
+
+	bpptree_init(&handler);
+
+	if (err_ok != dictionary_create(&handler, &dictionary, BENCH_DICTIONARY_ID, key_type_numeric_signed, sizeof(int), value_size, page_size)) {
+		fprintf(stderr, "create failed at page size %d\n", page_size);
+		free(value);
+		return 1;
+	}
+
+	start = bench_now();
+
+	for (i = 0; i < num_keys; i++) {
+		key = bench_scramble(i, BENCH_INSERT_STRIDE, num_keys);
+
+		if (err_ok != dictionary_insert(&dictionary, &key, value).error) {
+			break;
+		}
+	}
+
+	insert_time = bench_now() - start;
+
+	if (i != num_keys) {
+		fprintf(stderr, "insert failed at page size %d\n", page_size);
+		dictionary_delete_dictionary(&dictionary);
+		free(value);
+		return 1;
+	}
+
+	dictionary_get_stats(&dictionary, &stats);
+	reads	= stats.num_reads;
+
+	start	= bench_now();
+
+	for (i = 0; i < num_keys; i++) {
+		key = bench_scramble(i, BENCH_LOOKUP_STRIDE, num_keys);
+
+		if (err_ok != dictionary_get(&dictionary, &key, value).error) {
+			break;
+		}
+	}
+
+	lookup_time = bench_now() - start;
+
+	dictionary_get_stats(&dictionary, &stats);
+
+	printf("%6d %7u %14.0f %14.0f %16.3f\n", page_size, stats.height, num_keys / insert_time, lookup_time * 1e9 / num_keys, (double) (stats.num_reads - reads) / num_keys);
+
+	dictionary_delete_dictionary(&dictionary);
+	free(value);
+
+	return (i == num_keys) ? 0 : 1;
+}
+
+int
+main(
+	int		argc,
+	char	**argv
+) {
+	long	num_keys	= BENCH_DEFAULT_NUM_KEYS;
+	int		value_size	= BENCH_DEFAULT_VALUE_SIZE;
+	int		page_size;
+	int		failed		= 0;
+
+	if (argc > 1) {
+		num_keys = atol(argv[1]);
+	}
+
+	if (argc > 2) {
+		value_size = atoi(argv[2]);
+	}
+
+	if ((num_keys <= 0) || (value_size <= 0)) {
+		fprintf(stderr, "usage: %s [num_keys] [value_size]\n", argv[0]);
+		return 1;
+	}
+
+	/* the strides must not share a factor with the key count */
+	if ((0 == num_keys % BENCH_INSERT_STRIDE) || (0 == num_keys % BENCH_LOOKUP_STRIDE)) {
+		num_keys++;
+	}
+
+	printf("%ld keys, %d byte values, %d node buffers\n", num_keys, value_size, ION_BPP_DEFAULT_BUFFER_COUNT);
+	printf("%6s %7s %14s %14s %16s\n", "page", "height", "inserts/s", "lookup ns", "reads/lookup");
+
+	for (page_size = BENCH_MIN_PAGE_SIZE; page_size <= BENCH_MAX_PAGE_SIZE; page_size *= 2) {
+		failed |= bench_page_size(page_size, num_keys, value_size);
+	}
+
+	return failed;
+}
@@ -0,0 +1,227 @@
+/******************************************************************************/
+/**
+@file		bench_compare.c
+@brief		Compares the byte-wise numeric key comparators with the native
+			fixed-width ones, on their own and inside every dictionary type.
+@details	Usage: bench_compare [num_compares] [num_keys]
+@copyright	Copyright 2017
+			The University of British Columbia,
+			IonDB Project Contributors (see AUTHORS.md)
+@par Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+@par 1.Redistributions of source code must retain the above copyright notice,
+	this list of conditions and the following disclaimer.
+
+@par 2.Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+@par 3.Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+@par THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+	ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+	LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+	CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+	SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+	INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+	CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+	ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../../dictionary/dictionary.h"
+#include "../../dictionary/bpp_tree/bpp_tree_handler.h"
+#include "../../dictionary/flat_file/flat_file_dictionary_handler.h"
+#include "../../dictionary/open_address_file_hash/open_address_file_hash_dictionary_handler.h"
+#include "../../dictionary/open_address_hash/open_address_hash_dictionary_handler.h"
+#include "../../dictionary/skip_list/skip_list_handler.h"
+#include "../../dictionary/linear_hash/linear_hash_handler.h"
+
+#define BENCH_DEFAULT_NUM_COMPARES	10000000
+#define BENCH_DEFAULT_NUM_KEYS		2000
+#define BENCH_NUM_OPERANDS			1024	/* power of two */
+#define BENCH_DICTIONARY_ID			1
+
+/* keys are visited in a scrambled order; the stride is prime */
+#define BENCH_STRIDE				7919
+
+typedef struct {
+	char						*name;
+	void						(*init)(ion_dictionary_handler_t *);
+	ion_dictionary_size_t		dictionary_size;
+} bench_dictionary_t;
+
+static double
+bench_now(
+	void
+) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/**
+@brief		Times @p num_compares calls of @p compare over random operands.
+
+@return		Nanoseconds per comparison.
+*/
+static double
+bench_comparator(
+	ion_dictionary_compare_t	compare,
+	ion_byte_t					*operands,
+	int							key_size,
+	long						num_compares
+) {
+	volatile int	sink = 0;
+	double			start;
+	long			i;
+	int				a;
+	int				b;
+
+	start = bench_now();
+
+	for (i = 0; i < num_compares; i++) {
+		a		= i & (BENCH_NUM_OPERANDS - 1);
+		b		= (i * BENCH_STRIDE) & (BENCH_NUM_OPERANDS - 1);
+		sink	+= compare(operands + a * key_size, operands + b * key_size, key_size);
+	}
+
+	(void) sink;
+	return (bench_now() - start) * 1e9 / num_compares;
+}
+
+/**
+@brief		Inserts then looks up @p num_keys int keys in a dictionary that
+			uses @p compare.
+
+@return		Seconds taken, or a negative value if an operation failed.
+*/
+static double
+bench_dictionary(
+	bench_dictionary_t			*type,
+	ion_dictionary_compare_t	compare,
+	long						num_keys
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dictionary;
+	double						start;
+	double						elapsed;
+	long						i;
+	int							key;
+	int							value;
+	int							failed = 0;
+
+	type->init(&handler);
+
+	if (err_ok != dictionary_create_with_compare(&handler, &dictionary, BENCH_DICTIONARY_ID, key_type_numeric_signed, sizeof(int), sizeof(int), type->dictionary_size, compare)) {
+		return -1;
+	}
+
+	start = bench_now();
+
+	for (i = 0; i < num_keys; i++) {
+		key		= (int) ((i * BENCH_STRIDE) % num_keys) - num_keys / 2;
+		value	= key;
+		failed	|= err_ok != dictionary_insert(&dictionary, &key, &value).error;
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		key		= (int) i - num_keys / 2;
+		failed	|= err_ok != dictionary_get(&dictionary, &key, &value).error;
+		failed	|= value != key;
+	}
+
+	elapsed = bench_now() - start;
+
+	dictionary_delete_dictionary(&dictionary);
+
+	return failed ? -1 : elapsed;
+}
+
+int
+main(
+	int		argc,
+	char	**argv
+) {
+	bench_dictionary_t types[] = {
+		{ "bpp_tree", bpptree_init, -1 },
+		{ "flat_file", ffdict_init, 15 },
+		{ "open_address_file_hash", oafdict_init, 0 },
+		{ "open_address_hash", oadict_init, 0 },
+		{ "skip_list", sldict_init, 7 },
+		{ "linear_hash", linear_hash_dict_init, 15 }
+	};
+	ion_byte_t	*operands;
+	long		num_compares	= BENCH_DEFAULT_NUM_COMPARES;
+	long		num_keys		= BENCH_DEFAULT_NUM_KEYS;
+	int			key_size;
+	int			failed			= 0;
+	int			i;
+
+	if (argc > 1) {
+		num_compares = atol(argv[1]);
+	}
+
+	if (argc > 2) {
+		num_keys = atol(argv[2]);
+	}
+
+	if ((num_compares <= 0) || (num_keys <= 0) || (0 == num_keys % BENCH_STRIDE)) {
+		fprintf(stderr, "usage: %s [num_compares] [num_keys]\n", argv[0]);
+		return 1;
+	}
+
+	operands = malloc(BENCH_NUM_OPERANDS * sizeof(uint64_t));
+
+	if (NULL == operands) {
+		return 1;
+	}
+
+	srand(1);
+
+	for (i = 0; i < BENCH_NUM_OPERANDS * (int) sizeof(uint64_t); i++) {
+		operands[i] = (ion_byte_t) rand();
+	}
+
+	printf("%ld comparisons of random keys, ns per comparison\n", num_compares);
+	printf("%5s %12s %12s %12s %12s\n", "bytes", "signed", "native", "unsigned", "native");
+
+	for (key_size = 1; key_size <= (int) sizeof(uint64_t); key_size *= 2) {
+		printf("%5d %12.2f %12.2f %12.2f %12.2f\n", key_size, bench_comparator(dictionary_compare_signed_value, operands, key_size, num_compares), bench_comparator(dictionary_switch_compare(key_type_numeric_signed, key_size), operands, key_size, num_compares), bench_comparator(dictionary_compare_unsigned_value, operands, key_size, num_compares), bench_comparator(dictionary_switch_compare(key_type_numeric_unsigned, key_size), operands, key_size, num_compares));
+	}
+
+	/* oah and oafh are fixed size, so leave room for every key */
+	types[2].dictionary_size	= num_keys * 2;
+	types[3].dictionary_size	= num_keys * 2;
+
+	printf("\n%ld int keys inserted then looked up, ms\n", num_keys);
+	printf("%-24s %12s %12s\n", "dictionary", "byte-wise", "native");
+
+	for (i = 0; i < (int) (sizeof(types) / sizeof(types[0])); i++) {
+		double	old_time	= bench_dictionary(&types[i], dictionary_compare_signed_value, num_keys);
+		double	new_time	= bench_dictionary(&types[i], dictionary_switch_compare(key_type_numeric_signed, sizeof(int)), num_keys);
+
+		if ((old_time < 0) || (new_time < 0)) {
+			fprintf(stderr, "%s failed\n", types[i].name);
+			failed = 1;
+			continue;
+		}
+
+		printf("%-24s %12.2f %12.2f\n", types[i].name, old_time * 1e3, new_time * 1e3);
+	}
+
+	free(operands);
+	return failed;
+}
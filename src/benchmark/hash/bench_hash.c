@@ -0,0 +1,352 @@
+/******************************************************************************/
+/**
+@file		bench_hash.c
+@brief		Compares how evenly the key hash functions spread the key shapes
+			used in the examples, and what each costs inside the hash dictionaries.
+@details	Usage: bench_hash [num_keys]
+@copyright	Copyright 2017
+			The University of British Columbia,
+			IonDB Project Contributors (see AUTHORS.md)
+@par Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+@par 1.Redistributions of source code must retain the above copyright notice,
+	this list of conditions and the following disclaimer.
+
+@par 2.Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+@par 3.Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+@par THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+	ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+	LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+	CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+	SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+	INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+	CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+	ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+/******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../../dictionary/dictionary.h"
+#include "../../dictionary/open_address_file_hash/open_address_file_hash_dictionary_handler.h"
+#include "../../dictionary/open_address_hash/open_address_hash_dictionary_handler.h"
+#include "../../dictionary/linear_hash/linear_hash_handler.h"
+
+#define BENCH_DEFAULT_NUM_KEYS	2000
+#define BENCH_MAX_KEY_SIZE		16
+#define BENCH_DICTIONARY_ID		1
+
+/* stride of the strided int keys, a multiple of every power-of-two table */
+#define BENCH_INT_STRIDE		1024
+
+typedef struct {
+	char				*name;
+	ion_key_type_t		key_type;
+	ion_key_size_t		key_size;
+	/* writes key number i to key, which holds BENCH_MAX_KEY_SIZE bytes */
+	void				(*make_key)(long, ion_byte_t *);
+} bench_shape_t;
+
+typedef struct {
+	char						*name;
+	ion_dictionary_hash_type_t	hash_type;
+} bench_hash_t;
+
+typedef struct {
+	char						*name;
+	void						(*init)(ion_dictionary_handler_t *);
+	ion_dictionary_size_t		dictionary_size;
+} bench_dictionary_t;
+
+static double
+bench_now(
+	void
+) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* 3, 4, 9, 42 ... small int keys as in the string example */
+static void
+bench_key_int(
+	long		i,
+	ion_byte_t	*key
+) {
+	int value = (int) i;
+
+	memcpy(key, &value, sizeof(value));
+}
+
+static void
+bench_key_int_strided(
+	long		i,
+	ion_byte_t	*key
+) {
+	int value = (int) i * BENCH_INT_STRIDE;
+
+	memcpy(key, &value, sizeof(value));
+}
+
+/* three letter words in sizeof("one") bytes */
+static void
+bench_key_word(
+	long		i,
+	ion_byte_t	*key
+) {
+	key[0]	= (ion_byte_t) ('a' + i % 26);
+	key[1]	= (ion_byte_t) ('a' + i / 26 % 26);
+	key[2]	= (ion_byte_t) ('a' + i / 676 % 26);
+	key[3]	= '\0';
+}
+
+static void
+bench_key_prefixed(
+	long		i,
+	ion_byte_t	*key
+) {
+	memset(key, 0, BENCH_MAX_KEY_SIZE);
+	sprintf((char *) key, "key_%05ld", i % 100000);
+}
+
+/* as above, but the bytes after the terminator are left over from other keys */
+static void
+bench_key_string(
+	long		i,
+	ion_byte_t	*key
+) {
+	memset(key, (int) (i * 7919), BENCH_MAX_KEY_SIZE);
+	sprintf((char *) key, "key_%05ld", i % 100000);
+}
+
+/**
+@brief		Places every key of @p shape into @p num_slots slots with linear
+			probing, using @p hash_type.
+@details	The built-in hash is modelled by the open address hash one, the
+			first int of the key modulo the table size.
+@param		num_collisions
+				Written back with the number of keys that did not get a slot
+				to themselves.
+@return		The average number of slots looked at per insert, or a negative
+			value if out of memory.
+*/
+static double
+bench_probe(
+	bench_shape_t				*shape,
+	ion_dictionary_hash_type_t	hash_type,
+	long						num_keys,
+	long						num_slots,
+	long						*num_collisions
+) {
+	ion_dictionary_hash_t	hash	= dictionary_switch_hash(hash_type, shape->key_type);
+	ion_byte_t				key[BENCH_MAX_KEY_SIZE];
+	char					*used	= calloc(num_slots, 1);
+	char					*homes	= calloc(num_slots, 1);
+	long					probes	= 0;
+	long					slot;
+	long					i;
+	int						value;
+
+	if ((NULL == used) || (NULL == homes)) {
+		free(used);
+		free(homes);
+		return -1;
+	}
+
+	*num_collisions = 0;
+
+	for (i = 0; i < num_keys; i++) {
+		shape->make_key(i, key);
+
+		if (NULL != hash) {
+			slot = (long) (hash(key, shape->key_size) % (uint64_t) num_slots);
+		}
+		else {
+			memcpy(&value, key, sizeof(value));
+			slot = ((value % num_slots) + num_slots) % num_slots;
+		}
+
+		*num_collisions += homes[slot];
+		homes[slot]		= 1;
+
+		for (probes++; used[slot]; probes++) {
+			slot = (slot + 1) % num_slots;
+		}
+
+		used[slot] = 1;
+	}
+
+	free(used);
+	free(homes);
+	return (double) probes / num_keys;
+}
+
+/**
+@brief		Inserts then looks up every key of @p shape in a dictionary
+			created with @p hash_type.
+
+@return		Seconds taken, or a negative value if an operation failed.
+*/
+static double
+bench_dictionary(
+	bench_dictionary_t			*type,
+	bench_shape_t				*shape,
+	ion_dictionary_hash_type_t	hash_type,
+	long						num_keys
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dictionary;
+	ion_byte_t					key[BENCH_MAX_KEY_SIZE];
+	double						start;
+	double						elapsed;
+	long						i;
+	int							value;
+	int							failed = 0;
+
+	type->init(&handler);
+
+	if (err_ok != dictionary_create_with_hash(&handler, &dictionary, BENCH_DICTIONARY_ID, shape->key_type, shape->key_size, sizeof(int), type->dictionary_size, hash_type)) {
+		return -1;
+	}
+
+	start = bench_now();
+
+	for (i = 0; i < num_keys; i++) {
+		shape->make_key(i, key);
+		value	= (int) i;
+		failed	|= err_ok != dictionary_insert(&dictionary, key, &value).error;
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		shape->make_key(i, key);
+		failed	|= err_ok != dictionary_get(&dictionary, key, &value).error;
+		failed	|= value != (int) i;
+	}
+
+	elapsed = bench_now() - start;
+
+	dictionary_delete_dictionary(&dictionary);
+
+	return failed ? -1 : elapsed;
+}
+
+int
+main(
+	int		argc,
+	char	**argv
+) {
+	bench_shape_t shapes[] = {
+		{ "int", key_type_numeric_signed, sizeof(int), bench_key_int },
+		{ "int strided", key_type_numeric_signed, sizeof(int), bench_key_int_strided },
+		{ "char[4] word", key_type_char_array, sizeof("one"), bench_key_word },
+		{ "char[16] prefixed", key_type_char_array, BENCH_MAX_KEY_SIZE, bench_key_prefixed },
+		{ "string[16] prefixed", key_type_null_terminated_string, BENCH_MAX_KEY_SIZE, bench_key_string }
+	};
+	bench_hash_t hashes[] = {
+		{ "builtin", dictionary_hash_type_builtin },
+		{ "mix64", dictionary_hash_type_mix64 },
+		{ "fnv1a", dictionary_hash_type_fnv1a }
+	};
+	bench_dictionary_t types[] = {
+		{ "open_address_hash", oadict_init, 0 },
+		{ "open_address_file_hash", oafdict_init, 0 },
+		{ "linear_hash", linear_hash_dict_init, 15 }
+	};
+	long	num_keys		= BENCH_DEFAULT_NUM_KEYS;
+	long	num_slots;
+	long	num_collisions;
+	double	probes;
+	double	elapsed;
+	int		failed			= 0;
+	int		i;
+	int		j;
+	int		k;
+
+	if (argc > 1) {
+		num_keys = atol(argv[1]);
+	}
+
+	if ((num_keys <= 0) || (num_keys > 26 * 26 * 26)) {
+		fprintf(stderr, "usage: %s [num_keys], at most %d\n", argv[0], 26 * 26 * 26);
+		return 1;
+	}
+
+	/* a power of two at least twice the number of keys, as a linear hash would grow to */
+	for (num_slots = 1; num_slots < 2 * num_keys; num_slots *= 2) {}
+
+	/* oah and oafh are fixed size, so leave room for every key */
+	types[0].dictionary_size	= num_slots;
+	types[1].dictionary_size	= num_slots;
+
+	printf("%ld keys in %ld slots with linear probing: colliding keys / slots looked at per insert\n", num_keys, num_slots);
+	printf("%-24s", "keys");
+
+	for (j = 0; j < (int) (sizeof(hashes) / sizeof(hashes[0])); j++) {
+		printf(" %18s", hashes[j].name);
+	}
+
+	printf("\n");
+
+	for (i = 0; i < (int) (sizeof(shapes) / sizeof(shapes[0])); i++) {
+		printf("%-24s", shapes[i].name);
+
+		for (j = 0; j < (int) (sizeof(hashes) / sizeof(hashes[0])); j++) {
+			probes = bench_probe(&shapes[i], hashes[j].hash_type, num_keys, num_slots, &num_collisions);
+
+			if (probes < 0) {
+				return 1;
+			}
+
+			printf(" %8ld / %7.2f", num_collisions, probes);
+		}
+
+		printf("\n");
+	}
+
+	printf("\n%ld keys inserted then looked up, ms\n", num_keys);
+
+	for (k = 0; k < (int) (sizeof(types) / sizeof(types[0])); k++) {
+		printf("%-24s", types[k].name);
+
+		for (j = 0; j < (int) (sizeof(hashes) / sizeof(hashes[0])); j++) {
+			printf(" %18s", hashes[j].name);
+		}
+
+		printf("\n");
+
+		for (i = 0; i < (int) (sizeof(shapes) / sizeof(shapes[0])); i++) {
+			printf("  %-22s", shapes[i].name);
+
+			for (j = 0; j < (int) (sizeof(hashes) / sizeof(hashes[0])); j++) {
+				elapsed = bench_dictionary(&types[k], &shapes[i], hashes[j].hash_type, num_keys);
+
+				if (elapsed < 0) {
+					printf(" %18s", "failed");
+					failed = 1;
+					continue;
+				}
+
+				printf(" %18.2f", elapsed * 1e3);
+			}
+
+			printf("\n");
+		}
+	}
+
+	return failed;
+}
@@ -58,16 +58,21 @@ public:
 				The size of keys to be stored in the dictionary.
 @param		value_size
 				The size of the values to be stored in the dictionary.
+@param		page_size
+				The size, in bytes, of each node on disk. Must be a power of
+				two from @ref ION_BPP_MIN_PAGE_SIZE to @ref ION_BPP_MAX_PAGE_SIZE;
+				anything else uses @ref ION_BPP_DEFAULT_PAGE_SIZE.
 */
 BppTree(
-	ion_dictionary_id_t id,
-	ion_key_type_t		key_type,
-	int					key_size,
-	int					value_size
+	ion_dictionary_id_t		id,
+	ion_key_type_t			key_type,
+	int						key_size,
+	int						value_size,
+	ion_dictionary_size_t	page_size = 0
 ) {
 	bpptree_init(&this->handler);
 
-	this->initializeDictionary(id, key_type, key_size, value_size, 0);
+	this->initializeDictionary(id, key_type, key_size, value_size, page_size);
 }
 
 BppTree(
@@ -45,6 +45,83 @@
 
 #include "Cursor.h"
 
+/**
+@brief		Native comparator for integer keys of @p size bytes.
+@details	Sizes without a native comparator give @c NULL.
+*/
+template<int size, bool is_signed>
+struct NativeCompare {
+	static ion_dictionary_compare_t
+	get(
+	) {
+		return NULL;
+	}
+};
+
+#define ION_CPP_NATIVE_COMPARE(size, is_signed, compare) \
+	template<> \
+	struct NativeCompare<size, is_signed> { \
+		static ion_dictionary_compare_t \
+		get( \
+		) { \
+			return compare; \
+		} \
+	};
+
+ION_CPP_NATIVE_COMPARE(1, true, dictionary_compare_int8)
+ION_CPP_NATIVE_COMPARE(1, false, dictionary_compare_uint8)
+ION_CPP_NATIVE_COMPARE(2, true, dictionary_compare_int16)
+ION_CPP_NATIVE_COMPARE(2, false, dictionary_compare_uint16)
+ION_CPP_NATIVE_COMPARE(4, true, dictionary_compare_int32)
+ION_CPP_NATIVE_COMPARE(4, false, dictionary_compare_uint32)
+ION_CPP_NATIVE_COMPARE(8, true, dictionary_compare_int64)
+ION_CPP_NATIVE_COMPARE(8, false, dictionary_compare_uint64)
+
+/**
+@brief		Picks the key comparison function for a key of type @p K.
+@details	The choice for integer key types is fixed when the template is
+			instantiated, and follows the signedness of @p K rather than the
+			key type given at run time. Any other key type, or a key size that
+			does not match @p K, uses @ref dictionary_switch_compare.
+*/
+template<typename K>
+struct DictionaryCompare {
+	static ion_dictionary_compare_t
+	select(
+		ion_key_type_t	key_type,
+		ion_key_size_t	key_size
+	) {
+		return dictionary_switch_compare(key_type, key_size);
+	}
+};
+
+#define ION_CPP_INTEGER_COMPARE(type, is_signed) \
+	template<> \
+	struct DictionaryCompare<type> { \
+		static ion_dictionary_compare_t \
+		select( \
+			ion_key_type_t	key_type, \
+			ion_key_size_t	key_size \
+		) { \
+			if ((sizeof(type) != key_size) || (NULL == NativeCompare<sizeof(type), is_signed>::get())) { \
+				return dictionary_switch_compare(key_type, key_size); \
+			} \
+ \
+			return NativeCompare<sizeof(type), is_signed>::get(); \
+		} \
+	};
+
+ION_CPP_INTEGER_COMPARE(signed char, true)
+ION_CPP_INTEGER_COMPARE(unsigned char, false)
+ION_CPP_INTEGER_COMPARE(short, true)
+ION_CPP_INTEGER_COMPARE(unsigned short, false)
+ION_CPP_INTEGER_COMPARE(int, true)
+ION_CPP_INTEGER_COMPARE(unsigned int, false)
+ION_CPP_INTEGER_COMPARE(long, true)
+ION_CPP_INTEGER_COMPARE(unsigned long, false)
+ION_CPP_INTEGER_COMPARE(long long, true)
+ION_CPP_INTEGER_COMPARE(unsigned long long, false)
+
 template<typename K, typename V>
 class Dictionary {
 public:
@@ -71,7 +148,8 @@ ion_status_t				last_status;
 				the master table, this identifier can be 0.
 @param		k_type
 				The type of key to be used with this dictionary, which
-				determines the key comparison operator.
+				determines the key comparison operator unless @p K is an
+				integer type; see @ref DictionaryCompare.
 @param		k_size
 				The size of the key type to be used with this dictionary.
 @param		v_size
@@ -94,7 +172,7 @@ initializeDictionary(
 	value_size	= v_size;
 	dict_size	= dictionary_size;
 
-	ion_err_t err = dictionary_create(&handler, &dict, dict_id, k_type, k_size, v_size, dictionary_size);
+	ion_err_t err = dictionary_create_with_compare(&handler, &dict, dict_id, k_type, k_size, v_size, dictionary_size, DictionaryCompare<K>::select(k_type, k_size));
 
 	last_status.error = err;
 
@@ -222,6 +300,8 @@ destroyDictionary(
 /**
 @brief	  Opens a dictionary, given the desired config.
 
+@details	Keys are compared as they were when the dictionary was created;
+			see @ref DictionaryCompare.
 @param	  config_info
 				The configuration of the dictionary to be opened.
 @return	 An error message describing the result of of the open.
@@ -230,7 +310,7 @@ ion_err_t
 open(
 	ion_dictionary_config_info_t config_info
 ) {
-	ion_err_t err = dictionary_open(&handler, &dict, &config_info);
+	ion_err_t err = dictionary_open_with_compare(&handler, &dict, &config_info, DictionaryCompare<K>::select(config_info.type, config_info.key_size));
 
 	key_type			= config_info.type;
 	key_size			= config_info.key_size;
@@ -254,6 +334,24 @@ close(
 	return err;
 }
 
+/**
+@brief	  Retrieves the performance counters of the dictionary.
+
+@param	  stats
+				The statistics to fill in.
+@return	 An error message describing the result of the retrieval.
+*/
+ion_err_t
+getStats(
+	ion_dictionary_stats_t *stats
+) {
+	ion_err_t err = dictionary_get_stats(&dict, stats);
+
+	last_status.error = err;
+
+	return err;
+}
+
 /**
 @brief	  Sets up cursor and predicate to perform a range query on a
 			dictionary.
@@ -314,7 +314,7 @@ initializeDictionary(
 
 	switch (dictionary_type) {
 		case dictionary_type_bpp_tree_t: {
-			dictionary = new BppTree<K, V>(id, key_type, key_size, value_size);
+			dictionary = new BppTree<K, V>(id, key_type, key_size, value_size, dictionary_size);
 
 			break;
 		}
@@ -55,9 +55,14 @@
  *	each 3/4 full.  On deletion, if 3 nodes are 1/2 full, they are
  *	joined to create 2 nodes 3/4 full.
  *
- *	A LRR (least-recently-read) buffering scheme for nodes is used to
- *	simplify storage management, and, assuming some locality of reference,
- *	improve performance.
+ *	Nodes are cached in a pool of buffers indexed by a hash on the node
+ *	address.  Buffers are replaced using 2Q: a node read for the first
+ *	time enters a FIFO probation queue (A1in), and only nodes that are
+ *	referenced again after leaving it (remembered by address in A1out)
+ *	are admitted to the LRU main queue (Am).  A long sequential scan
+ *	therefore cannot flush the upper levels of the tree from the pool.
+ *	The most recently assigned buffers are never chosen as victims, as
+ *	insert/delete work on several of them at once.
  *
  *	To simplify matters, both internal nodes and leafs contain the
  *	same fields.
@@ -70,11 +75,12 @@
 #define bAdr(p)		*(ion_bpp_address_t *) (p)
 #define eAdr(p)		*(ion_bpp_external_address_t *) (p)
 
-/* based on k = &[key,rec,childGE] */
+/* based on k = &[key,rec,value,childGE] */
 #define childLT(k)	bAdr((char *) k - sizeof(ion_bpp_address_t))
 #define key(k)		(k)
 #define rec(k)		eAdr((char *) (k) + h->keySize)
-#define childGE(k)	bAdr((char *) (k) + h->keySize + sizeof(ion_bpp_external_address_t))
+#define val(k)		((char *) (k) + h->keySize + sizeof(ion_bpp_external_address_t))
+#define childGE(k)	bAdr(val(k) + h->valSize)
 
 /* based on b = &ion_bpp_buffer_t */
 #define leaf(b)		b->p->leaf
@@ -88,15 +94,6 @@
 /* shortcuts */
 #define ks(ct)		((ct) * h->ks)
 
-/* statistics */
-int maxHeight;	/* maximum height attained */
-int nNodesIns;	/* number of nodes inserted */
-int nNodesDel;	/* number of nodes deleted */
-int nKeysIns;	/* number of keys inserted */
-int nKeysDel;	/* number of keys deleted */
-int nDiskReads;	/* number of disk reads */
-int nDiskWrites;/* number of disk writes */
-
 /* line number for last IO or memory error */
 int bErrLineNo;
 
@@ -119,25 +116,76 @@ typedef struct {
 	ion_bpp_key_t		fkey;			/* first occurrence */
 } ion_bpp_node_t;
 
+typedef enum ION_BPP_QUEUE { QUEUE_FREE, QUEUE_A1IN, QUEUE_AM } ion_bpp_queue_e;
+
 typedef struct ion_bpp_buffer_tag {
 	/* location of node */
 	struct ion_bpp_buffer_tag	*next;	/* next */
 	struct ion_bpp_buffer_tag	*prev;	/* previous */
+	struct ion_bpp_buffer_tag	*hashNext;	/* next buffer in hash chain */
 	ion_bpp_address_t			adr;	/* on disk */
 	ion_bpp_node_t				*p;	/* in memory */
 	ion_bpp_bool_t				valid;		/* true if buffer contents valid */
 	ion_bpp_bool_t				modified;	/* true if buffer modified */
+	char						queue;		/* replacement queue holding buffer */
+	unsigned long				stamp;		/* tick of last assignment */
 } ion_bpp_buffer_t;
 
+/* bulk load keeps the rightmost node of each level in memory */
+typedef struct {
+	ion_bpp_buffer_t	cur;	/* node being filled */
+	ion_bpp_buffer_t	prev;	/* left sibling of cur, until cur is half full */
+	ion_bpp_bool_t		prevHeld;	/* true if prev not yet written */
+	ion_bpp_bool_t		pushed;	/* true if cur has been added to parent */
+	long				nNodes;	/* # nodes started on this level */
+	ion_bpp_key_t		*curMin;/* [key,rec,value] of first entry in cur's subtree */
+	void				*malloc1;	/* malloc'd resources */
+} ion_bpp_bulk_level_t;
+
+#define ION_BPP_BULK_MAX_LEVELS 32
+
+typedef struct ion_bpp_bulk_tag {
+	int						target;	/* # keys per node when filling */
+	int						minCt;	/* # keys a node needs to be left alone */
+	int						nLevels;/* # levels started */
+	ion_bpp_bool_t			haveLast;	/* true if lastKey is set */
+	ion_bpp_key_t			*lastKey;	/* [key,rec,value] of last key added */
+	ion_bpp_bulk_level_t	level[ION_BPP_BULK_MAX_LEVELS];
+} ion_bpp_bulk_t;
+
+struct ion_bpp_h_node_tag;
+
+/* # keys before the first key > key (upper) or >= key (!upper) in node */
+typedef int (*ion_bpp_lower_bound_t)(
+	struct ion_bpp_h_node_tag	*h,
+	ion_bpp_buffer_t			*buf,
+	void						*key,
+	int							upper
+);
+
 /* one node for each open handle */
 typedef struct ion_bpp_h_node_tag {
 	ion_file_handle_t		fp;		/* idx file */
 	int						keySize;/* key length */
+	int						valSize;/* length of value stored after rec */
 	ion_bpp_bool_t			dupKeys;/* true if duplicate keys */
 	int						sectorSize;	/* block size for idx records */
 	ion_bpp_comparison_t	comp;			/* pointer to compare routine */
+	ion_bpp_lower_bound_t	lowerBound;		/* in-node search for native keys, or NULL */
 	ion_bpp_buffer_t		root;			/* root of b-tree, room for 3 sets */
-	ion_bpp_buffer_t		bufList;		/* head of buf list */
+	ion_bpp_buffer_t		freeList;		/* head of unused buffers */
+	ion_bpp_buffer_t		a1in;			/* head of probation (FIFO) queue */
+	ion_bpp_buffer_t		am;				/* head of main (LRU) queue */
+	int						a1inCt;	/* # buffers in a1in */
+	int						a1inMax;/* a1in size before it is preferred for eviction */
+	int						bufCt;	/* # buffers in pool */
+	ion_bpp_buffer_t		**hashTable;	/* adr -> buffer index */
+	unsigned int			hashMask;	/* # hash buckets - 1 */
+	ion_bpp_address_t		*a1out;	/* ring of adrs recently evicted from a1in */
+	int						a1outMax;	/* size of a1out ring */
+	int						a1outPos;	/* next a1out slot to overwrite */
+	unsigned long			tick;	/* # calls to assignBuf */
+	ion_bpp_stats_t			stats;	/* statistics */
 	void					*malloc1;	/* malloc'd resources */
 	void					*malloc2;	/* malloc'd resources */
 	ion_bpp_buffer_t		gbuf;			/* gather buffer, room for 3 sets */
@@ -146,8 +194,26 @@ typedef struct ion_bpp_h_node_tag {
 	unsigned int			maxCt;	/* minimum # keys in node */
 	int						ks;	/* sizeof key entry */
 	ion_bpp_address_t		nextFreeAdr;/* next free b-tree record address */
+	struct ion_bpp_bulk_tag *bulk;	/* bulk load state, NULL if none */
+	unsigned long			version;/* # changes to the tree, for open scans */
 } ion_bpp_h_node_t;
 
+/* first sector of the idx file, ahead of the root */
+typedef struct {
+	char	magic[4];	/* ION_BPP_MAGIC */
+	int		version;	/* ION_BPP_VERSION */
+	int		sectorSize;	/* block size for idx records */
+	int		keySize;	/* key length */
+	int		valSize;	/* length of value stored after rec */
+	int		dupKeys;	/* true if duplicate keys */
+} ion_bpp_header_t;
+
+#define ION_BPP_MAGIC	"IBPT"
+#define ION_BPP_VERSION 1
+
+/* file offset of node at adr; the header takes the first sector */
+#define diskAdr(adr) ((adr) + h->sectorSize)
+
 #define error(rc) lineError(__LINE__, rc)
 
 static ion_bpp_err_t
@@ -192,7 +258,7 @@ flush(
 		len *= 3;	/* root */
 	}
 
-	err = ion_fwrite_at(h->fp, buf->adr, len, (ion_byte_t *) buf->p);
+	err = ion_fwrite_at(h->fp, diskAdr(buf->adr), len, (ion_byte_t *) buf->p);
 
 	if (err_ok != err) {
 		return error(bErrIO);
@@ -239,10 +305,22 @@ flush(
 #endif
 
 	buf->modified = boolean_false;
-	nDiskWrites++;
+	h->stats.nDiskWrites++;
+	h->stats.nBytesWritten += len;
 	return bErrOk;
 }
 
+static int
+compareBufAdr(
+	const void	*a,
+	const void	*b
+) {
+	ion_bpp_address_t	adrA	= (*(ion_bpp_buffer_t *const *) a)->adr;
+	ion_bpp_address_t	adrB	= (*(ion_bpp_buffer_t *const *) b)->adr;
+
+	return (adrA > adrB) - (adrA < adrB);
+}
+
 static ion_bpp_err_t
 flushAll(
 	ion_bpp_handle_t handle
@@ -250,26 +328,148 @@ flushAll(
 	ion_bpp_h_node_t	*h = handle;
 	ion_bpp_err_t		rc;			/* return code */
 	ion_bpp_buffer_t	*buf;				/* buffer */
+	ion_bpp_buffer_t	**dirty;	/* modified buffers, by address */
+	ion_file_io_t		*ios;		/* one write per modified buffer */
+	int					ct;			/* number of modified buffers */
+	int					i;
 
-	if (h->root.modified) {
-		if ((rc = flush(handle, &h->root)) != 0) {
-			return rc;
+	dirty	= malloc((h->bufCt + 1) * sizeof(ion_bpp_buffer_t *));
+	ios		= malloc((h->bufCt + 1) * sizeof(ion_file_io_t));
+
+	if ((NULL == dirty) || (NULL == ios)) {
+		/* flush one buffer at a time */
+		free(dirty);
+		free(ios);
+
+		if (h->root.modified) {
+			if ((rc = flush(handle, &h->root)) != 0) {
+				return rc;
+			}
+		}
+
+		for (buf = h->malloc1; buf < (ion_bpp_buffer_t *) h->malloc1 + h->bufCt; buf++) {
+			if (buf->modified) {
+				if ((rc = flush(handle, buf)) != 0) {
+					return rc;
+				}
+			}
 		}
+
+		return bErrOk;
 	}
 
-	buf = h->bufList.next;
+	ct = 0;
+
+	if (h->root.modified) {
+		dirty[ct++] = &h->root;
+	}
 
-	while (buf != &h->bufList) {
+	for (buf = h->malloc1; buf < (ion_bpp_buffer_t *) h->malloc1 + h->bufCt; buf++) {
 		if (buf->modified) {
-			if ((rc = flush(handle, buf)) != 0) {
-				return rc;
-			}
+			dirty[ct++] = buf;
 		}
+	}
+
+	/* in address order, neighbouring nodes go out in one write */
+	qsort(dirty, ct, sizeof(ion_bpp_buffer_t *), compareBufAdr);
 
-		buf = buf->next;
+	for (i = 0; i < ct; i++) {
+		ios[i].offset		= diskAdr(dirty[i]->adr);
+		ios[i].num_bytes	= dirty[i]->adr == 0 ? 3 * h->sectorSize : h->sectorSize;
+		ios[i].buffer		= (ion_byte_t *) dirty[i]->p;
 	}
 
-	return bErrOk;
+	rc = bErrOk;
+
+	if (err_ok != ion_fwritev_at(h->fp, ios, ct)) {
+		rc = error(bErrIO);
+	}
+	else {
+		for (i = 0; i < ct; i++) {
+			dirty[i]->modified			= boolean_false;
+			h->stats.nDiskWrites++;
+			h->stats.nBytesWritten		+= ios[i].num_bytes;
+		}
+	}
+
+	free(dirty);
+	free(ios);
+	return rc;
+}
+
+#define hashBucket(adr) (&h->hashTable[((adr) / h->sectorSize) & h->hashMask])
+
+static void
+unlinkBuf(
+	ion_bpp_buffer_t *buf
+) {
+	buf->next->prev = buf->prev;
+	buf->prev->next = buf->next;
+}
+
+static void
+pushBuf(
+	ion_bpp_buffer_t	*list,
+	ion_bpp_buffer_t	*buf
+) {
+	/* place at front of list */
+	buf->next		= list->next;
+	buf->prev		= list;
+	buf->next->prev = buf;
+	buf->prev->next = buf;
+}
+
+static void
+hashRemove(
+	ion_bpp_handle_t	handle,
+	ion_bpp_buffer_t	*buf
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_buffer_t	**link;
+
+	for (link = hashBucket(buf->adr); *link; link = &(*link)->hashNext) {
+		if (*link == buf) {
+			*link = buf->hashNext;
+			break;
+		}
+	}
+}
+
+static ion_bpp_bool_t
+a1outTake(
+	ion_bpp_handle_t	handle,
+	ion_bpp_address_t	adr
+) {
+	ion_bpp_h_node_t	*h = handle;
+	int					i;
+
+	/* only consulted on a miss, which is about to cost a disk read anyway */
+	for (i = 0; i < h->a1outMax; i++) {
+		if (h->a1out[i] == adr) {
+			h->a1out[i] = 0;
+			return boolean_true;
+		}
+	}
+
+	return boolean_false;
+}
+
+static ion_bpp_buffer_t *
+lastUnpinned(
+	ion_bpp_handle_t	handle,
+	ion_bpp_buffer_t	*list
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_buffer_t	*buf;
+
+	/* the buffers assigned by the last few calls may still be in use */
+	for (buf = list->prev; buf != list; buf = buf->prev) {
+		if (h->tick - buf->stamp >= ION_BPP_MIN_BUFFER_COUNT) {
+			return buf;
+		}
+	}
+
+	return NULL;
 }
 
 static ion_bpp_err_t
@@ -288,42 +488,91 @@ assignBuf(
 		return bErrOk;
 	}
 
-	/* search for buf with matching adr */
-	buf = h->bufList.next;
+	h->tick++;
 
-	while (buf->next != &h->bufList) {
-		if (buf->valid && (buf->adr == adr)) {
+	/* search for buf with matching adr */
+	for (buf = *hashBucket(adr); buf; buf = buf->hashNext) {
+		if (buf->adr == adr) {
 			break;
 		}
+	}
+
+	if (buf && buf->valid) {
+		h->stats.nBufHits++;
+
+		/* a1in is FIFO, only am is kept in LRU order */
+		if (QUEUE_AM == buf->queue) {
+			unlinkBuf(buf);
+			pushBuf(&h->am, buf);
+		}
 
-		buf = buf->next;
+		buf->stamp	= h->tick;
+		*b			= buf;
+		return bErrOk;
 	}
 
-	/* either buf points to a match, or it's last one in list (LRR) */
-	if (buf->valid) {
-		if (buf->adr != adr) {
+	h->stats.nBufMisses++;
+
+	if (NULL == buf) {
+		/* choose a victim */
+		if (h->freeList.next != &h->freeList) {
+			buf = h->freeList.next;
+		}
+		else {
+			if ((h->a1inCt > h->a1inMax) || (h->am.next == &h->am)) {
+				if ((buf = lastUnpinned(handle, &h->a1in)) == NULL) {
+					buf = lastUnpinned(handle, &h->am);
+				}
+			}
+			else if ((buf = lastUnpinned(handle, &h->am)) == NULL) {
+				buf = lastUnpinned(handle, &h->a1in);
+			}
+
 			if (buf->modified) {
 				if ((rc = flush(handle, buf)) != 0) {
 					return rc;
 				}
 			}
 
-			buf->adr	= adr;
-			buf->valid	= boolean_false;
+			if (buf->valid) {
+				h->stats.nBufEvictions++;
+
+				/* remember adr, a later miss on it proves reuse */
+				if (QUEUE_A1IN == buf->queue) {
+					h->a1out[h->a1outPos]	= buf->adr;
+					h->a1outPos				= (h->a1outPos + 1) % h->a1outMax;
+				}
+			}
+
+			hashRemove(handle, buf);
 		}
+
+		buf->adr		= adr;
+		buf->hashNext	= *hashBucket(adr);
+		*hashBucket(adr) = buf;
+	}
+
+	buf->valid = boolean_false;
+
+	/* admit to am only if recently seen, otherwise on probation in a1in */
+	unlinkBuf(buf);
+
+	if (QUEUE_A1IN == buf->queue) {
+		h->a1inCt--;
+	}
+
+	if (a1outTake(handle, adr)) {
+		buf->queue = QUEUE_AM;
+		pushBuf(&h->am, buf);
 	}
 	else {
-		buf->adr = adr;
+		buf->queue = QUEUE_A1IN;
+		pushBuf(&h->a1in, buf);
+		h->a1inCt++;
 	}
 
-	/* remove from current position and place at front of list */
-	buf->next->prev = buf->prev;
-	buf->prev->next = buf->next;
-	buf->next		= h->bufList.next;
-	buf->prev		= &h->bufList;
-	buf->next->prev = buf;
-	buf->prev->next = buf;
-	*b				= buf;
+	buf->stamp	= h->tick;
+	*b			= buf;
 	return bErrOk;
 }
 
@@ -360,7 +609,7 @@ readDisk(
 			len *= 3;	/* root */
 		}
 
-		ion_err_t err = ion_fread_at(h->fp, adr, len, (ion_byte_t *) buf->p);
+		ion_err_t err = ion_fread_at(h->fp, diskAdr(adr), len, (ion_byte_t *) buf->p);
 
 		if (err_ok != err) {
 			return error(bErrIO);
@@ -368,7 +617,8 @@ readDisk(
 
 		buf->modified	= boolean_false;
 		buf->valid		= boolean_true;
-		nDiskReads++;
+		h->stats.nDiskReads++;
+		h->stats.nBytesRead += len;
 
 #if 0
 		len = 1;
@@ -408,10 +658,6 @@ readDisk(
 		}
 
 #endif
-
-		buf->modified	= boolean_false;
-		buf->valid		= boolean_true;
-		nDiskReads++;
 	}
 
 	*b = buf;
@@ -420,6 +666,106 @@ readDisk(
 
 typedef enum ION_BPP_MODE { MODE_FIRST, MODE_MATCH, MODE_FGEQ, MODE_LLEQ } ion_bpp_mode_e;
 
+/* below this many keys a node is scanned rather than halved further */
+#define ION_BPP_LINEAR_SEARCH 8
+
+/*
+ * In-node search kernels for keys that are native integers.  Keys are
+ * loaded whole and compared in registers instead of a call to comp per
+ * probe.  The binary search halves without branching on the comparison,
+ * and the last few keys are counted rather than searched.
+ */
+#define ION_BPP_LOWER_BOUND(name, type) \
+	static int \
+	name( \
+		ion_bpp_h_node_t	*h, \
+		ion_bpp_buffer_t	*buf, \
+		void				*key, \
+		int					upper \
+	) { \
+		ion_bpp_key_t	*base	= fkey(buf); \
+		int				lo		= 0; \
+		int				n		= ct(buf); \
+		int				half; \
+		int				i; \
+		int				tail	= 0; \
+		type			k; \
+		type			v; \
+ \
+		memcpy(&k, key, sizeof(type)); \
+ \
+		while (n > ION_BPP_LINEAR_SEARCH) { \
+			half	= n / 2; \
+			memcpy(&v, base + ks(lo + half), sizeof(type)); \
+			lo		+= half * ((v < k) | (upper & (v == k))); \
+			n		-= half; \
+		} \
+ \
+		for (i = 0; i < n; i++) { \
+			memcpy(&v, base + ks(lo + i), sizeof(type)); \
+			tail += (v < k) | (upper & (v == k)); \
+		} \
+ \
+		return lo + tail; \
+	}
+
+ION_BPP_LOWER_BOUND(lowerBoundS8, int8_t)
+ION_BPP_LOWER_BOUND(lowerBoundU8, uint8_t)
+ION_BPP_LOWER_BOUND(lowerBoundS16, int16_t)
+ION_BPP_LOWER_BOUND(lowerBoundU16, uint16_t)
+ION_BPP_LOWER_BOUND(lowerBoundS32, int32_t)
+ION_BPP_LOWER_BOUND(lowerBoundU32, uint32_t)
+ION_BPP_LOWER_BOUND(lowerBoundS64, int64_t)
+ION_BPP_LOWER_BOUND(lowerBoundU64, uint64_t)
+
+static ion_bpp_lower_bound_t
+pickLowerBound(
+	ion_bpp_comparison_t	comp,
+	int						keySize
+) {
+	/* the byte-wise comparators handle any size, so go by keySize */
+	if (dictionary_compare_signed_value == comp) {
+		comp = dictionary_switch_compare(key_type_numeric_signed, keySize);
+	}
+	else if (dictionary_compare_unsigned_value == comp) {
+		comp = dictionary_switch_compare(key_type_numeric_unsigned, keySize);
+	}
+
+	if ((dictionary_compare_int8 == comp) && (sizeof(int8_t) == keySize)) {
+		return lowerBoundS8;
+	}
+
+	if ((dictionary_compare_uint8 == comp) && (sizeof(uint8_t) == keySize)) {
+		return lowerBoundU8;
+	}
+
+	if ((dictionary_compare_int16 == comp) && (sizeof(int16_t) == keySize)) {
+		return lowerBoundS16;
+	}
+
+	if ((dictionary_compare_uint16 == comp) && (sizeof(uint16_t) == keySize)) {
+		return lowerBoundU16;
+	}
+
+	if ((dictionary_compare_int32 == comp) && (sizeof(int32_t) == keySize)) {
+		return lowerBoundS32;
+	}
+
+	if ((dictionary_compare_uint32 == comp) && (sizeof(uint32_t) == keySize)) {
+		return lowerBoundU32;
+	}
+
+	if ((dictionary_compare_int64 == comp) && (sizeof(int64_t) == keySize)) {
+		return lowerBoundS64;
+	}
+
+	if ((dictionary_compare_uint64 == comp) && (sizeof(uint64_t) == keySize)) {
+		return lowerBoundU64;
+	}
+
+	return NULL;
+}
+
 static int
 search(
 	ion_bpp_handle_t			handle,
@@ -450,61 +796,81 @@ search(
 
 	/* scan current node for key using binary search */
 	foundDup	= boolean_false;
+	cc			= ION_CC_LT;
 	lb			= 0;
 	ub			= ct(buf) - 1;
 
-	while (lb <= ub) {
-		m		= (lb + ub) / 2;
-		*mkey	= fkey(buf) + ks(m);
-		cc		= h->comp(key, key(*mkey), (ion_key_size_t) (h->keySize));
+	if ((NULL != h->lowerBound) && !h->dupKeys) {
+		/* lb, ub as the binary search below would leave them */
+		lb	= h->lowerBound(h, buf, key, MODE_LLEQ == mode);
+		ub	= lb - 1;
 
-		if ((cc < 0) || ((cc == 0) && (MODE_FGEQ == mode))) {
-			/* key less than key[m] */
-			ub = m - 1;
-		}
-		else if ((cc > 0) || ((cc == 0) && (MODE_LLEQ == mode))) {
-			/* key greater than key[m] */
-			lb = m + 1;
+		if ((MODE_FIRST == mode) || (MODE_MATCH == mode)) {
+			if (lb < ct(buf)) {
+				*mkey = fkey(buf) + ks(lb);
+				return (0 == memcmp(key, key(*mkey), h->keySize)) ? ION_CC_EQ : ION_CC_LT;
+			}
+
+			if (0 != lb) {
+				*mkey = fkey(buf) + ks(lb - 1);
+				return ION_CC_GT;
+			}
 		}
-		else {
-			/* keys match */
-			if (h->dupKeys) {
-				switch (mode) {
-					case MODE_FIRST:
-						/* backtrack to first key */
-						ub = m - 1;
-
-						if (lb > ub) {
-							return ION_CC_EQ;
-						}
-
-						foundDup = boolean_true;
-						break;
-
-					case MODE_MATCH:
-
-						/* rec's must also match */
-						if (rec < rec(*mkey)) {
-							ub	= m - 1;
-							cc	= ION_CC_LT;
-						}
-						else if (rec > rec(*mkey)) {
-							lb	= m + 1;
-							cc	= ION_CC_GT;
-						}
-						else {
-							return ION_CC_EQ;
-						}
-
-						break;
-
-					case MODE_FGEQ:
-					case MODE_LLEQ:	/* nop */
-						break;
-				}
+	}
+	else {
+		while (lb <= ub) {
+			m		= (lb + ub) / 2;
+			*mkey	= fkey(buf) + ks(m);
+			cc		= h->comp(key, key(*mkey), (ion_key_size_t) (h->keySize));
+
+			if ((cc < 0) || ((cc == 0) && (MODE_FGEQ == mode))) {
+				/* key less than key[m] */
+				ub = m - 1;
+			}
+			else if ((cc > 0) || ((cc == 0) && (MODE_LLEQ == mode))) {
+				/* key greater than key[m] */
+				lb = m + 1;
 			}
 			else {
-				return cc;
+				/* keys match */
+				if (h->dupKeys) {
+					switch (mode) {
+						case MODE_FIRST:
+							/* backtrack to first key */
+							ub = m - 1;
+
+							if (lb > ub) {
+								return ION_CC_EQ;
+							}
+
+							foundDup = boolean_true;
+							break;
+
+						case MODE_MATCH:
+
+							/* rec's must also match */
+							if (rec < rec(*mkey)) {
+								ub	= m - 1;
+								cc	= ION_CC_LT;
+							}
+							else if (rec > rec(*mkey)) {
+								lb	= m + 1;
+								cc	= ION_CC_GT;
+							}
+							else {
+								return ION_CC_EQ;
+							}
+
+							break;
+
+						case MODE_FGEQ:
+						case MODE_LLEQ:	/* nop */
+							break;
+					}
+				}
+				else {
+					return cc;
+				}
 			}
 		}
 	}
@@ -654,7 +1020,7 @@ scatter(
 			}
 
 			iu++;
-			nNodesIns++;
+			h->stats.nNodesIns++;
 		}
 		else if ((iu > 1) && (ct < (k0Min + (iu - 1) * knMin))) {
 			/* del a buffer */
@@ -666,7 +1032,7 @@ scatter(
 			}
 
 			next(tmp[iu - 1]) = next(tmp[iu]);
-			nNodesDel++;
+			h->stats.nNodesDel++;
 		}
 		else {
 			break;
@@ -696,6 +1062,13 @@ scatter(
 	 * update sequential links and parent *
 	 **************************************/
 	if (iu != is) {
+		if (iu > is) {
+			h->stats.nSplits++;
+		}
+		else {
+			h->stats.nMerges++;
+		}
+
 		/* link last node to next */
 		if (leaf(gbuf) && next(tmp[iu - 1])) {
 			ion_bpp_buffer_t *buf;
@@ -895,6 +1268,79 @@ gather(
 	return bErrOk;
 }
 
+static void
+bulkFree(
+	ion_bpp_handle_t handle
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_bulk_t		*b = h->bulk;
+	int					i;
+
+	if (NULL == b) {
+		return;
+	}
+
+	for (i = 0; i < ION_BPP_BULK_MAX_LEVELS; i++) {
+		if (b->level[i].malloc1) {
+			free(b->level[i].malloc1);
+		}
+	}
+
+	if (b->lastKey) {
+		free(b->lastKey);
+	}
+
+	free(b);
+	h->bulk = NULL;
+}
+
+static ion_bpp_err_t
+readHeader(
+	ion_file_handle_t	fp,
+	ion_bpp_open_t		*info
+) {
+	ion_bpp_header_t hdr;
+
+	if (err_ok != ion_fread_at(fp, 0, sizeof(hdr), (ion_byte_t *) &hdr)) {
+		return bErrHeader;
+	}
+
+	if ((0 != memcmp(hdr.magic, ION_BPP_MAGIC, sizeof(hdr.magic))) || (ION_BPP_VERSION != hdr.version)) {
+		return bErrHeader;
+	}
+
+	/* layout of the existing file must match what the caller expects */
+	if ((hdr.keySize != info->keySize) || (hdr.valSize != info->valSize) || (hdr.dupKeys != (int) info->dupKeys)) {
+		return bErrHeader;
+	}
+
+	/* sector size is fixed when the file is created */
+	info->sectorSize = hdr.sectorSize;
+	return bErrOk;
+}
+
+static ion_bpp_err_t
+writeHeader(
+	ion_bpp_handle_t handle
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_header_t	hdr;
+
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, ION_BPP_MAGIC, sizeof(hdr.magic));
+	hdr.version		= ION_BPP_VERSION;
+	hdr.sectorSize	= h->sectorSize;
+	hdr.keySize		= h->keySize;
+	hdr.valSize		= h->valSize;
+	hdr.dupKeys		= h->dupKeys;
+
+	if (err_ok != ion_fwrite_at(h->fp, 0, sizeof(hdr), (ion_byte_t *) &hdr)) {
+		return error(bErrIO);
+	}
+
+	return bErrOk;
+}
+
 ion_bpp_err_t
 b_open(
 	ion_bpp_open_t		info,
@@ -908,18 +1354,40 @@ b_open(
 	ion_bpp_buffer_t	*root;
 	int					i;
 	ion_bpp_node_t		*p;
+	ion_bpp_bool_t		exists;	/* true if opening an existing file */
+	ion_file_handle_t	fp;		/* idx file */
+
+	/* an existing file dictates its own sector size */
+	exists = ion_fexists(info.iName);
+
+	if (exists) {
+		fp = ion_fopen(info.iName);
+
+		if ((rc = readHeader(fp, &info)) != bErrOk) {
+			ion_fclose(fp);
+			return rc;
+		}
+	}
+
+	if ((info.sectorSize < sizeof(ion_bpp_node_t)) || (0 != info.sectorSize % 4)) {
+		if (exists) {
+			ion_fclose(fp);
+		}
 
-	if ((info.sectorSize < sizeof(ion_bpp_h_node_t)) || (0 != info.sectorSize % 4)) {
 		return bErrSectorSize;
 	}
 
 	/* determine sizes and offsets */
-	/* leaf/n, prev, next, [childLT,key,rec]... childGE */
+	/* leaf/n, prev, next, [childLT,key,rec,value]... childGE */
 	/* ensure that there are at least 3 children/parent for gather/scatter */
 	maxCt	= info.sectorSize - (sizeof(ion_bpp_node_t) - sizeof(ion_bpp_key_t));
-	maxCt	/= sizeof(ion_bpp_address_t) + info.keySize + sizeof(ion_bpp_external_address_t);
+	maxCt	/= sizeof(ion_bpp_address_t) + info.keySize + sizeof(ion_bpp_external_address_t) + info.valSize;
 
 	if (maxCt < 6) {
+		if (exists) {
+			ion_fclose(fp);
+		}
+
 		return bErrSectorSize;
 	}
 
@@ -929,12 +1397,14 @@ b_open(
 	}
 
 	h->keySize		= info.keySize;
+	h->valSize		= info.valSize;
 	h->dupKeys		= info.dupKeys;
 	h->sectorSize	= info.sectorSize;
 	h->comp			= info.comp;
+	h->lowerBound	= pickLowerBound(info.comp, info.keySize);
 
-	/* childLT, key, rec */
-	h->ks			= sizeof(ion_bpp_address_t) + h->keySize + sizeof(ion_bpp_external_address_t);
+	/* childLT, key, rec, value */
+	h->ks			= sizeof(ion_bpp_address_t) + h->keySize + sizeof(ion_bpp_external_address_t) + h->valSize;
 	h->maxCt		= maxCt;
 
 	/* Allocate buflist.
@@ -944,12 +1414,43 @@ b_open(
 	 *  - 1 next sequential link
 	 *  - 1 lastGE
 	*/
-	bufCt			= 7;
+	bufCt			= info.bufCt;
+
+	if (0 == bufCt) {
+		bufCt = ION_BPP_DEFAULT_BUFFER_COUNT;
+	}
+	else if (bufCt < ION_BPP_MIN_BUFFER_COUNT) {
+		bufCt = ION_BPP_MIN_BUFFER_COUNT;
+	}
+
+	h->bufCt		= bufCt;
+	h->stats.bufCt	= bufCt;
 
 	if ((h->malloc1 = calloc(bufCt, sizeof(ion_bpp_buffer_t))) == NULL) {
 		return error(bErrMemory);
 	}
 
+	/* at least twice as many hash buckets as buffers */
+	i = 1;
+
+	while (i < 2 * bufCt) {
+		i <<= 1;
+	}
+
+	h->hashMask = i - 1;
+
+	if ((h->hashTable = calloc(i, sizeof(ion_bpp_buffer_t *))) == NULL) {
+		return error(bErrMemory);
+	}
+
+	/* 2Q tuning: a1in holds 1/4 of the pool, a1out remembers 1/2 of it */
+	h->a1inMax	= bufCt / 4;
+	h->a1outMax = bufCt / 2;
+
+	if ((h->a1out = calloc(h->a1outMax, sizeof(ion_bpp_address_t))) == NULL) {
+		return error(bErrMemory);
+	}
+
 	buf = h->malloc1;
 
 	/*
@@ -971,22 +1472,23 @@ b_open(
 	p				= h->malloc2;
 
 	/* initialize buflist */
-	h->bufList.next = buf;
-	h->bufList.prev = buf + (bufCt - 1);
+	h->freeList.next	= h->freeList.prev = &h->freeList;
+	h->a1in.next		= h->a1in.prev = &h->a1in;
+	h->am.next			= h->am.prev = &h->am;
 
 	for (i = 0; i < bufCt; i++) {
-		buf->next		= buf + 1;
-		buf->prev		= buf - 1;
 		buf->modified	= boolean_false;
 		buf->valid		= boolean_false;
+		buf->queue		= QUEUE_FREE;
 		buf->p			= p;
 		p				= (ion_bpp_node_t *) ((char *) p + h->sectorSize);
+		h->freeList.prev->next	= buf;
+		buf->prev				= h->freeList.prev;
+		buf->next				= &h->freeList;
+		h->freeList.prev		= buf;
 		buf++;
 	}
 
-	h->bufList.next->prev	= &h->bufList;
-	h->bufList.prev->next	= &h->bufList;
-
 	/* initialize root */
 	root					= &h->root;
 	root->p					= p;
@@ -997,9 +1499,9 @@ b_open(
 	h->curKey				= NULL;
 
 	/* initialize root */
-	if (ion_fexists(info.iName)) {
+	if (exists) {
 		/* open an existing database */
-		h->fp = ion_fopen(info.iName);
+		h->fp = fp;
 
 		if ((rc = readDisk(h, 0, &root)) != 0) {
 			return rc;
@@ -1012,6 +1514,8 @@ b_open(
 		if ((h->nextFreeAdr = ion_ftell(h->fp)) == -1) {
 			return error(bErrIO);
 		}
+
+		h->nextFreeAdr -= h->sectorSize;
 	}
 
 #if defined(ARDUINO)
@@ -1024,6 +1528,11 @@ b_open(
 		leaf(root)		= 1;
 		h->nextFreeAdr	= 3 * h->sectorSize;
 		root->modified	= 1;
+
+		if ((rc = writeHeader(h)) != bErrOk) {
+			return rc;
+		}
+
 		flushAll(h);
 	}
 	else {
@@ -1058,6 +1567,8 @@ b_close(
 		ion_fclose(h->fp);
 	}
 
+	bulkFree(handle);
+
 	if (h->malloc2) {
 		free(h->malloc2);
 	}
@@ -1066,6 +1577,14 @@ b_close(
 		free(h->malloc1);
 	}
 
+	if (h->hashTable) {
+		free(h->hashTable);
+	}
+
+	if (h->a1out) {
+		free(h->a1out);
+	}
+
 	free(h);
 	return bErrOk;
 }
@@ -1131,12 +1650,26 @@ b_find_first_greater_or_equal(
 	/* find key, and return address */
 	while (1) {
 		if (leaf(buf)) {
+			if (0 == ct(buf)) {
+				return bErrKeyNotFound;
+			}
+
 			if ((cc = search(handle, buf, key, 0, &lgeqkey, MODE_LLEQ)) > 0) {
-				if ((lgeqkey - fkey(buf)) / (h->ks) == (ct(buf))) {
-					return bErrKeyNotFound;
-				}
+				if (lgeqkey == lkey(buf)) {
+					/* every key in this leaf is smaller, so take the next leaf's first */
+					if (!next(buf)) {
+						return bErrKeyNotFound;
+					}
 
-				lgeqkey += ks(1);
+					if ((rc = readDisk(handle, next(buf), &buf)) != 0) {
+						return rc;
+					}
+
+					lgeqkey = fkey(buf);
+				}
+				else {
+					lgeqkey += ks(1);
+				}
 			}
 
 			h->curBuf	= buf;
@@ -1184,6 +1717,7 @@ b_insert(
 
 	ion_bpp_h_node_t *h = handle;
 
+	h->version++;
 	root		= &h->root;
 	lastGEvalid = boolean_false;
 	lastLTvalid = boolean_false;
@@ -1208,8 +1742,8 @@ b_insert(
 		if (leaf(buf)) {
 			/* in leaf, and there' room guaranteed */
 
-			if (height > maxHeight) {
-				maxHeight = height;
+			if (height > h->stats.maxHeight) {
+				h->stats.maxHeight = height;
 			}
 
 			/* set mkey to point to insertion point */
@@ -1247,6 +1781,7 @@ b_insert(
 			/* insert new key */
 			memcpy(key(mkey), key, h->keySize);
 			rec(mkey)		= rec;
+			memset(val(mkey), 0, h->valSize);
 			childGE(mkey)	= 0;
 			ct(buf)++;
 
@@ -1254,6 +1789,10 @@ b_insert(
 				return rc;
 			}
 
+			/* new key is current, for b_put_value */
+			h->curBuf	= buf;
+			h->curKey	= mkey;
+
 			/* if new key is first key, then fixup lastGE key */
 			if (!keyOff && lastLTvalid) {
 				ion_bpp_buffer_t	*tbuf;
@@ -1273,7 +1812,7 @@ b_insert(
 				}
 			}
 
-			nKeysIns++;
+			h->stats.nKeysIns++;
 			break;
 		}
 		else {
@@ -1356,6 +1895,7 @@ b_update(
 
 	ion_bpp_h_node_t *h = handle;
 
+	h->version++;
 	root = &h->root;
 
 	/* check for full root */
@@ -1378,8 +1918,8 @@ b_update(
 		if (leaf(buf)) {
 			/* in leaf, and there' room guaranteed */
 
-			if (height > maxHeight) {
-				maxHeight = height;
+			if (height > h->stats.maxHeight) {
+				h->stats.maxHeight = height;
 			}
 
 			/* set mkey to point to update point */
@@ -1398,10 +1938,15 @@ b_update(
 
 			/* update key */
 			rec(mkey) = rec;
-			break;
-		}
-		else {
-			/* internal node, descend to child */
+
+			if ((rc = writeDisk(buf)) != 0) {
+				return rc;
+			}
+
+			break;
+		}
+		else {
+			/* internal node, descend to child */
 			ion_bpp_buffer_t *cbuf;	/* child buf */
 
 			height++;
@@ -1471,6 +2016,7 @@ b_delete(
 
 	ion_bpp_h_node_t *h = handle;
 
+	h->version++;
 	root		= &h->root;
 	gbuf		= &h->gbuf;
 	lastGEvalid = boolean_false;
@@ -1520,7 +2066,7 @@ b_delete(
 				}
 			}
 
-			nKeysDel++;
+			h->stats.nKeysDel++;
 			break;
 		}
 		else {
@@ -1550,7 +2096,8 @@ b_delete(
 				if ((buf == root) && (ct(root) == 2) && (ct(gbuf) < (3 * (3 * h->maxCt)) / 4)) {
 					/* collapse tree by one level */
 					scatterRoot(handle);
-					nNodesDel += 3;
+					h->stats.nNodesDel += 3;
+					h->stats.nMerges++;
 					continue;
 				}
 
@@ -1763,3 +2310,723 @@ b_find_prev_key(
 	h->curKey	= pkey;
 	return bErrOk;
 }
+
+/* based on s = &ion_bpp_scan_t */
+#define scanNode(s) ((ion_bpp_node_t *) (s)->leaf)
+#define scanKey(s)	(&scanNode(s)->fkey + ks((s)->pos))
+
+static ion_bpp_err_t
+scanReadAhead(
+	ion_bpp_handle_t	handle,
+	ion_bpp_scan_t		*scan
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_buffer_t	*buf;
+	ion_bpp_err_t		rc;		/* return code */
+
+	if ((rc = readDisk(handle, scanNode(scan)->next, &buf)) != 0) {
+		return rc;
+	}
+
+	memcpy(scan->ahead, buf->p, h->sectorSize);
+	scan->aheadAdr = scanNode(scan)->next;
+	return bErrOk;
+}
+
+static void
+scanLoad(
+	ion_bpp_handle_t handle,
+	ion_bpp_scan_t	*scan
+) {
+	ion_bpp_h_node_t	*h		= handle;
+	ion_bpp_buffer_t	*buf	= h->curBuf;
+
+	/* take over the leaf the handle was just positioned in */
+	memcpy(scan->leaf, buf->p, h->sectorSize);
+	scan->pos		= (int) ((h->curKey - fkey(buf)) / h->ks);
+	scan->aheadAdr	= 0;
+	scan->version	= h->version;
+}
+
+static ion_bpp_err_t
+scanStep(
+	ion_bpp_handle_t handle,
+	ion_bpp_scan_t	*scan
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_address_t	adr;
+	ion_bpp_buffer_t	*buf;
+	ion_bpp_err_t		rc;		/* return code */
+	char				*tmp;
+
+	while (scan->pos + 1 >= (int) scanNode(scan)->ct) {
+		if (0 == (adr = scanNode(scan)->next)) {
+			return bErrKeyNotFound;
+		}
+
+		if (scan->aheadAdr == adr) {
+			tmp			= scan->leaf;
+			scan->leaf	= scan->ahead;
+			scan->ahead = tmp;
+		}
+		else {
+			if ((rc = readDisk(handle, adr, &buf)) != 0) {
+				return rc;
+			}
+
+			memcpy(scan->leaf, buf->p, h->sectorSize);
+		}
+
+		scan->pos		= -1;
+		scan->aheadAdr	= 0;
+	}
+
+	scan->pos++;
+
+	/* halfway through a leaf, fetch the next one before it is needed */
+	if ((0 == scan->aheadAdr) && (0 != scanNode(scan)->next) && (2 * scan->pos >= (int) scanNode(scan)->ct - 1)) {
+		return scanReadAhead(handle, scan);
+	}
+
+	return bErrOk;
+}
+
+static void
+scanEmit(
+	ion_bpp_handle_t			handle,
+	ion_bpp_scan_t				*scan,
+	void						*key,
+	ion_bpp_external_address_t	*rec,
+	void						*value
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_key_t		*k = scanKey(scan);
+
+	memcpy(key, key(k), h->keySize);
+	*rec = rec(k);
+
+	if (NULL != value) {
+		memcpy(value, val(k), h->valSize);
+	}
+}
+
+ion_bpp_err_t
+b_scan_open(
+	ion_bpp_handle_t	handle,
+	ion_bpp_scan_t		*scan
+) {
+	ion_bpp_h_node_t *h = handle;
+
+	scan->leaf		= malloc(h->sectorSize);
+	scan->ahead		= malloc(h->sectorSize);
+	scan->aheadAdr	= 0;
+	scan->pos		= -1;
+	scan->version	= h->version;
+
+	if ((NULL == scan->leaf) || (NULL == scan->ahead)) {
+		b_scan_close(scan);
+		return error(bErrMemory);
+	}
+
+	return bErrOk;
+}
+
+void
+b_scan_close(
+	ion_bpp_scan_t *scan
+) {
+	free(scan->leaf);
+	free(scan->ahead);
+	scan->leaf	= NULL;
+	scan->ahead = NULL;
+	scan->pos	= -1;
+}
+
+ion_bpp_err_t
+b_scan_first(
+	ion_bpp_handle_t			handle,
+	ion_bpp_scan_t				*scan,
+	void						*key,
+	ion_bpp_external_address_t	*rec,
+	void						*value
+) {
+	ion_bpp_err_t rc;	/* return code */
+
+	scan->pos = -1;
+
+	if ((rc = b_find_first_key(handle, key, rec)) != 0) {
+		return rc;
+	}
+
+	scanLoad(handle, scan);
+	scanEmit(handle, scan, key, rec, value);
+	return bErrOk;
+}
+
+ion_bpp_err_t
+b_scan_seek(
+	ion_bpp_handle_t			handle,
+	ion_bpp_scan_t				*scan,
+	void						*target,
+	void						*key,
+	ion_bpp_external_address_t	*rec,
+	void						*value
+) {
+	ion_bpp_err_t rc;	/* return code */
+
+	scan->pos = -1;
+
+	if ((rc = b_find_first_greater_or_equal(handle, target, key, rec)) != 0) {
+		return rc;
+	}
+
+	scanLoad(handle, scan);
+	scanEmit(handle, scan, key, rec, value);
+	return bErrOk;
+}
+
+ion_bpp_err_t
+b_scan_next(
+	ion_bpp_handle_t			handle,
+	ion_bpp_scan_t				*scan,
+	void						*key,
+	ion_bpp_external_address_t	*rec,
+	void						*value
+) {
+	ion_bpp_h_node_t			*h = handle;
+	ion_bpp_key_t				*k;
+	ion_bpp_external_address_t	lastRec;
+	ion_bpp_err_t				rc;	/* return code */
+
+	if (scan->pos < 0) {
+		return bErrKeyNotFound;
+	}
+
+	if (scan->version == h->version) {
+		if ((rc = scanStep(handle, scan)) != 0) {
+			return rc;
+		}
+	}
+	else {
+		/* the copies may be stale, so find the last key again and skip past it */
+		k		= scanKey(scan);
+		lastRec = rec(k);
+		memcpy(key, key(k), h->keySize);
+
+		if ((rc = b_scan_seek(handle, scan, key, scan->ahead, rec, NULL)) != 0) {
+			return rc;
+		}
+
+		k = scanKey(scan);
+
+		while (ION_CC_EQ == h->comp(key(k), key, (ion_key_size_t) (h->keySize)) && (!h->dupKeys || (rec(k) <= lastRec))) {
+			if ((rc = scanStep(handle, scan)) != 0) {
+				return rc;
+			}
+
+			k = scanKey(scan);
+		}
+	}
+
+	scanEmit(handle, scan, key, rec, value);
+	return bErrOk;
+}
+
+int
+b_scan_recs(
+	ion_bpp_handle_t			handle,
+	ion_bpp_scan_t				*scan,
+	ion_bpp_external_address_t	*recs,
+	int							max
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_key_t		*k;
+	int					n;
+	int					i;
+
+	if (scan->pos < 0) {
+		return 0;
+	}
+
+	n = (int) scanNode(scan)->ct - scan->pos;
+	k = scanKey(scan);
+
+	for (i = 0; i < n && i < max; i++) {
+		recs[i]	= rec(k);
+		k		+= ks(1);
+	}
+
+	return n;
+}
+
+static ion_bpp_err_t
+bulkStart(
+	ion_bpp_handle_t	handle,
+	int					lvl
+) {
+	ion_bpp_h_node_t		*h = handle;
+	ion_bpp_bulk_level_t	*l;
+	ion_bpp_buffer_t		tmp;
+
+	/*
+	 * input:
+	 *   lvl					level to start a new node on
+	 * notes:
+	 *   The current node becomes the held left sibling, and an empty
+	 *   node is started in its place.  Node 0 of a level gets its
+	 *   address only when node 1 is started, so that a level with a
+	 *   single node can be copied to the root without wasting a sector.
+	*/
+	if (lvl >= ION_BPP_BULK_MAX_LEVELS) {
+		return bErrBulkLoad;
+	}
+
+	l = &h->bulk->level[lvl];
+
+	if (NULL == l->malloc1) {
+		/* cur, prev, curMin */
+		if ((l->malloc1 = calloc(1, 2 * h->sectorSize + h->ks)) == NULL) {
+			return error(bErrMemory);
+		}
+
+		l->cur.p	= l->malloc1;
+		l->prev.p	= (ion_bpp_node_t *) ((char *) l->malloc1 + h->sectorSize);
+		l->curMin	= (ion_bpp_key_t *) ((char *) l->malloc1 + 2 * h->sectorSize);
+		h->bulk->nLevels = lvl + 1;
+	}
+
+	if (l->nNodes > 0) {
+		tmp		= l->prev;
+		l->prev = l->cur;
+		l->cur	= tmp;
+
+		if (1 == l->nNodes) {
+			l->prev.adr = allocAdr(handle);
+		}
+
+		l->prevHeld = boolean_true;
+		l->cur.adr	= allocAdr(handle);
+	}
+
+	memset(l->cur.p, 0, h->sectorSize);
+	leaf((&l->cur)) = (0 == lvl);
+	l->pushed		= boolean_false;
+
+	if (l->prevHeld && (0 == lvl)) {
+		next((&l->prev))	= l->cur.adr;
+		prev((&l->cur))		= l->prev.adr;
+	}
+
+	l->nNodes++;
+	h->stats.nNodesIns++;
+	return bErrOk;
+}
+
+static ion_bpp_err_t bulkAppend(ion_bpp_handle_t handle, int lvl, ion_bpp_key_t *entry, ion_bpp_address_t child);
+
+static ion_bpp_err_t
+bulkConfirm(
+	ion_bpp_handle_t	handle,
+	int					lvl
+) {
+	ion_bpp_h_node_t		*h = handle;
+	ion_bpp_bulk_level_t	*l = &h->bulk->level[lvl];
+	ion_bpp_err_t			rc;		/* return code */
+
+	/* cur is at least half full, so its left sibling is final */
+	if ((rc = flush(handle, &l->prev)) != 0) {
+		return rc;
+	}
+
+	l->prevHeld = boolean_false;
+
+	if (2 == l->nNodes) {
+		/* first separator on this level, so parent starts with node 0 */
+		if ((rc = bulkAppend(handle, lvl + 1, NULL, l->prev.adr)) != 0) {
+			return rc;
+		}
+	}
+
+	if ((rc = bulkAppend(handle, lvl + 1, l->curMin, l->cur.adr)) != 0) {
+		return rc;
+	}
+
+	l->pushed = boolean_true;
+	return bErrOk;
+}
+
+static ion_bpp_err_t
+bulkAppend(
+	ion_bpp_handle_t	handle,
+	int					lvl,
+	ion_bpp_key_t		*entry,
+	ion_bpp_address_t	child
+) {
+	ion_bpp_h_node_t		*h = handle;
+	ion_bpp_bulk_t			*b = h->bulk;
+	ion_bpp_bulk_level_t	*l;
+	ion_bpp_buffer_t		*buf;
+	ion_bpp_key_t			*k;
+	ion_bpp_err_t			rc;		/* return code */
+	int						es;		/* size of [key,rec,value] */
+
+	/*
+	 * input:
+	 *   lvl					level to append to, 0 for leaves
+	 *   entry				  [key,rec] to append, NULL for first child
+	 *   child				  child node, internal levels only
+	*/
+	es = h->ks - sizeof(ion_bpp_address_t);
+
+	if ((lvl >= b->nLevels) || (0 == b->level[lvl].nNodes)) {
+		/* first node on level */
+		if ((rc = bulkStart(handle, lvl)) != 0) {
+			return rc;
+		}
+
+		l	= &b->level[lvl];
+		buf = &l->cur;
+
+		if (lvl > 0) {
+			childLT(fkey(buf)) = child;
+			return bErrOk;
+		}
+	}
+	else {
+		l	= &b->level[lvl];
+		buf = &l->cur;
+
+		if (ct(buf) == b->target) {
+			if ((rc = bulkStart(handle, lvl)) != 0) {
+				return rc;
+			}
+
+			if (lvl > 0) {
+				/* entry separates the new node from its left sibling */
+				childLT(fkey(buf)) = child;
+				memcpy(l->curMin, entry, es);
+				return bErrOk;
+			}
+		}
+	}
+
+	k = fkey(buf) + ks(ct(buf));
+	memcpy(k, entry, es);
+	childGE(k) = (lvl > 0) ? child : 0;
+	ct(buf)++;
+
+	if ((0 == lvl) && (1 == ct(buf))) {
+		memcpy(l->curMin, entry, es);
+	}
+
+	if ((l->nNodes > 1) && !l->pushed && (ct(buf) == b->minCt)) {
+		return bulkConfirm(handle, lvl);
+	}
+
+	return bErrOk;
+}
+
+static ion_bpp_err_t
+bulkBalance(
+	ion_bpp_handle_t	handle,
+	int					lvl
+) {
+	ion_bpp_h_node_t		*h = handle;
+	ion_bpp_bulk_level_t	*l = &h->bulk->level[lvl];
+	ion_bpp_buffer_t		*pbuf;
+	ion_bpp_buffer_t		*cbuf;
+	ion_bpp_buffer_t		*gbuf;
+	ion_bpp_buffer_t		tmp;
+	ion_bpp_key_t			*gkey;
+	int						total;	/* # keys in prev and cur */
+	int						a;		/* # keys left in prev */
+	int						es;		/* size of [key,rec,value] */
+
+	/*
+	 * notes:
+	 *   cur has fewer than minCt keys, and prev is still held.  Either
+	 *   merge them into prev, or share keys evenly between them.
+	*/
+	es		= h->ks - sizeof(ion_bpp_address_t);
+	pbuf	= &l->prev;
+	cbuf	= &l->cur;
+	gbuf	= &h->gbuf;
+
+	/* gather prev and cur to gbuf */
+	gkey				= fkey(gbuf);
+	childLT(gkey)		= childLT(fkey(pbuf));
+	memcpy(gkey, fkey(pbuf), ks(ct(pbuf)));
+	gkey				+= ks(ct(pbuf));
+	total				= ct(pbuf);
+
+	if (0 != lvl) {
+		/* separator from parent's point of view */
+		memcpy(gkey, l->curMin, es);
+		childGE(gkey)	= childLT(fkey(cbuf));
+		gkey			+= ks(1);
+		total++;
+	}
+
+	memcpy(gkey, fkey(cbuf), ks(ct(cbuf)));
+	total += ct(cbuf);
+
+	if (total <= (int) h->maxCt) {
+		/* merge into prev */
+		memcpy(fkey(pbuf), fkey(gbuf), ks(total));
+		ct(pbuf)	= total;
+		next(pbuf)	= 0;
+		tmp			= l->cur;
+		l->cur		= l->prev;
+		l->prev		= tmp;
+		l->prevHeld = boolean_false;
+		l->nNodes--;
+		l->pushed	= (l->nNodes > 1);
+		h->stats.nNodesIns--;
+		return bErrOk;
+	}
+
+	if (0 == lvl) {
+		a = total / 2;
+		memcpy(fkey(pbuf), fkey(gbuf), ks(a));
+		memcpy(fkey(cbuf), fkey(gbuf) + ks(a), ks(total - a));
+		ct(pbuf)	= a;
+		ct(cbuf)	= total - a;
+		memcpy(l->curMin, fkey(cbuf), es);
+	}
+	else {
+		/* key a moves up to parent */
+		a = (total - 1) / 2;
+		memcpy(fkey(pbuf), fkey(gbuf), ks(a));
+		gkey				= fkey(gbuf) + ks(a);
+		memcpy(l->curMin, gkey, es);
+		childLT(fkey(cbuf)) = childGE(gkey);
+		memcpy(fkey(cbuf), gkey + ks(1), ks(total - 1 - a));
+		ct(pbuf)			= a;
+		ct(cbuf)			= total - 1 - a;
+	}
+
+	return bulkConfirm(handle, lvl);
+}
+
+ion_bpp_err_t
+b_bulk_begin(
+	ion_bpp_handle_t	handle,
+	int					fillFactor
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_bulk_t		*b;
+	ion_bpp_buffer_t	*root = &h->root;
+
+	if ((NULL != h->bulk) || !leaf(root) || (0 != ct(root))) {
+		return bErrBulkLoad;
+	}
+
+	if (fillFactor <= 0) {
+		fillFactor = ION_BPP_DEFAULT_FILL_FACTOR;
+	}
+
+	if ((b = calloc(1, sizeof(ion_bpp_bulk_t))) == NULL) {
+		return error(bErrMemory);
+	}
+
+	if ((b->lastKey = malloc(h->ks)) == NULL) {
+		free(b);
+		return error(bErrMemory);
+	}
+
+	/* nodes with fewer than maxCt/2 keys would never be merged by b_delete */
+	b->minCt	= h->maxCt / 2;
+	b->target	= (int) ((long) h->maxCt * fillFactor / 100);
+
+	if (b->target < b->minCt) {
+		b->target = b->minCt;
+	}
+
+	if (b->target > (int) h->maxCt) {
+		b->target = h->maxCt;
+	}
+
+	h->bulk		= b;
+	h->curBuf	= NULL;
+	h->version++;
+	return bErrOk;
+}
+
+ion_bpp_err_t
+b_bulk_add(
+	ion_bpp_handle_t			handle,
+	void						*key,
+	ion_bpp_external_address_t	rec,
+	void						*value
+) {
+	ion_bpp_h_node_t	*h = handle;
+	ion_bpp_bulk_t		*b = h->bulk;
+	ion_bpp_err_t		rc;		/* return code */
+	int					cc;		/* condition code */
+
+	if (NULL == b) {
+		return bErrBulkLoad;
+	}
+
+	if (b->haveLast) {
+		cc = h->comp(key, key(b->lastKey), (ion_key_size_t) (h->keySize));
+
+		if ((cc < 0) || ((0 == cc) && (!h->dupKeys || (rec <= rec(b->lastKey))))) {
+			return bErrBulkLoad;
+		}
+	}
+
+	memcpy(key(b->lastKey), key, h->keySize);
+	rec(b->lastKey) = rec;
+	b->haveLast		= boolean_true;
+
+	if (NULL != value) {
+		memcpy(val(b->lastKey), value, h->valSize);
+	}
+	else {
+		memset(val(b->lastKey), 0, h->valSize);
+	}
+
+	if ((rc = bulkAppend(handle, 0, b->lastKey, 0)) != 0) {
+		return rc;
+	}
+
+	h->stats.nKeysIns++;
+	return bErrOk;
+}
+
+ion_bpp_err_t
+b_bulk_end(
+	ion_bpp_handle_t handle
+) {
+	ion_bpp_h_node_t		*h = handle;
+	ion_bpp_bulk_t			*b = h->bulk;
+	ion_bpp_bulk_level_t	*l;
+	ion_bpp_buffer_t		*root = &h->root;
+	ion_bpp_buffer_t		*top;
+	ion_bpp_buffer_t		*lbuf;
+	ion_bpp_buffer_t		*rbuf;
+	ion_bpp_key_t			*rkey;
+	ion_bpp_err_t			rc;		/* return code */
+	int						lvl;
+
+	if (NULL == b) {
+		return bErrBulkLoad;
+	}
+
+	if (0 == b->nLevels) {
+		/* no keys, root stays empty */
+		bulkFree(handle);
+		return bErrOk;
+	}
+
+	/* finish each level; balancing may still push to the level above */
+	for (lvl = 0; lvl < b->nLevels; lvl++) {
+		l = &b->level[lvl];
+
+		if ((l->nNodes > 1) && !l->pushed) {
+			if ((rc = bulkBalance(handle, lvl)) != 0) {
+				bulkFree(handle);
+				return rc;
+			}
+		}
+
+		if (lvl < b->nLevels - 1) {
+			if ((rc = flush(handle, &l->cur)) != 0) {
+				bulkFree(handle);
+				return rc;
+			}
+		}
+	}
+
+	/* top level has a single node, which becomes the root */
+	lvl = b->nLevels - 1;
+	top = &b->level[lvl].cur;
+	memset(root->p, 0, 3 * h->sectorSize);
+	root->adr = 0;
+
+	if (leaf(top) || (ct(top) > 1)) {
+		memcpy(root->p, top->p, h->sectorSize);
+		prev(root) = 0;
+		next(root) = 0;
+	}
+	else {
+		/* an internal root needs 3 children, so absorb both children */
+		if (((rc = readDisk(handle, childLT(fkey(top)), &lbuf)) != 0) || ((rc = readDisk(handle, childGE(fkey(top)), &rbuf)) != 0)) {
+			bulkFree(handle);
+			return rc;
+		}
+
+		leaf(root)		= leaf(lbuf);
+		rkey			= fkey(root);
+		childLT(rkey)	= childLT(fkey(lbuf));
+		memcpy(rkey, fkey(lbuf), ks(ct(lbuf)));
+		rkey			+= ks(ct(lbuf));
+		ct(root)		= ct(lbuf);
+
+		if (!leaf(lbuf)) {
+			memcpy(rkey, fkey(top), ks(1));
+			childGE(rkey)	= childLT(fkey(rbuf));
+			rkey			+= ks(1);
+			ct(root)++;
+		}
+
+		memcpy(rkey, fkey(rbuf), ks(ct(rbuf)));
+		ct(root)	+= ct(rbuf);
+		lvl--;
+	}
+
+	if (lvl > h->stats.maxHeight) {
+		h->stats.maxHeight = lvl;
+	}
+
+	bulkFree(handle);
+
+	if ((rc = flush(handle, root)) != 0) {
+		return rc;
+	}
+
+	return bErrOk;
+}
+
+ion_bpp_err_t
+b_get_value(
+	ion_bpp_handle_t	handle,
+	void				*value
+) {
+	ion_bpp_h_node_t *h = handle;
+
+	if (h->curBuf == NULL) {
+		return bErrKeyNotFound;
+	}
+
+	memcpy(value, val(h->curKey), h->valSize);
+	return bErrOk;
+}
+
+ion_bpp_err_t
+b_put_value(
+	ion_bpp_handle_t	handle,
+	void				*value
+) {
+	ion_bpp_h_node_t *h = handle;
+
+	if (h->curBuf == NULL) {
+		return bErrKeyNotFound;
+	}
+
+	memcpy(val(h->curKey), value, h->valSize);
+	h->version++;
+	return writeDisk(h->curBuf);
+}
+
+ion_bpp_err_t
+b_get_stats(
+	ion_bpp_handle_t	handle,
+	ion_bpp_stats_t		*stats
+) {
+	ion_bpp_h_node_t *h = handle;
+
+	*stats = h->stats;
+	return bErrOk;
+}
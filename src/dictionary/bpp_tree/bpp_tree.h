@@ -80,11 +80,23 @@ typedef ion_boolean_e ion_bpp_bool_t;
 
 /* typedef enum {false, true} bool; */
 typedef enum ION_BPP_ERR {
-	bErrOk, bErrKeyNotFound, bErrDupKeys, bErrSectorSize, bErrFileNotOpen, bErrFileExists, bErrIO, bErrMemory
+	bErrOk, bErrKeyNotFound, bErrDupKeys, bErrSectorSize, bErrFileNotOpen, bErrFileExists, bErrIO, bErrMemory, bErrBulkLoad, bErrHeader
 } ion_bpp_err_t;
 
 typedef void *ion_bpp_handle_t;
 
+/* During insert/delete, need simultaneous access to 7 buffers */
+#define ION_BPP_MIN_BUFFER_COUNT 7
+
+#if defined(ARDUINO)
+#define ION_BPP_DEFAULT_BUFFER_COUNT ION_BPP_MIN_BUFFER_COUNT
+#else
+#define ION_BPP_DEFAULT_BUFFER_COUNT 64
+#endif
+
+/* default percentage of each node filled by a bulk load */
+#define ION_BPP_DEFAULT_FILL_FACTOR 100
+
 typedef struct {
 	/* info for bOpen() */
 	char					*iName;	/* name of index file */
@@ -92,8 +104,37 @@ typedef struct {
 	ion_bpp_bool_t			dupKeys;		/* true if duplicate keys allowed */
 	size_t					sectorSize;	/* size of sector on disk */
 	ion_bpp_comparison_t	comp;			/* pointer to compare function */
+	int						bufCt;	/* number of node buffers, 0 for default */
+	int						valSize;/* bytes of value stored with each key, 0 for none */
 } ion_bpp_open_t;
 
+typedef struct {
+	int		maxHeight;	/* maximum height attained */
+	long	nNodesIns;	/* number of nodes inserted */
+	long	nNodesDel;	/* number of nodes deleted */
+	long	nKeysIns;	/* number of keys inserted */
+	long	nKeysDel;	/* number of keys deleted */
+	long	nSplits;	/* number of node splits */
+	long	nMerges;	/* number of node merges */
+	long	nDiskReads;	/* number of disk reads */
+	long	nDiskWrites;/* number of disk writes */
+	long	nBytesRead;	/* number of bytes read */
+	long	nBytesWritten;	/* number of bytes written */
+	long	nBufHits;	/* node requests served from the buffer pool */
+	long	nBufMisses;	/* node requests that needed a buffer (re)assigned */
+	long	nBufEvictions;	/* valid buffers replaced to satisfy a miss */
+	int		bufCt;		/* number of node buffers in the pool */
+} ion_bpp_stats_t;
+
+/* position of a scan over the leaves, kept apart from the handle's current key */
+typedef struct {
+	char				*leaf;	/* copy of the leaf holding the current key */
+	char				*ahead;	/* copy of the leaf after it, once read ahead */
+	ion_bpp_address_t	aheadAdr;	/* address ahead was read from, 0 if not read */
+	int					pos;	/* index of the current key in leaf, -1 if none */
+	unsigned long		version;/* tree version the copies were taken at */
+} ion_bpp_scan_t;
+
 /***********************
  * function prototypes *
  ***********************/
@@ -113,6 +154,11 @@ b_open(
  *   bErrMemory			 insufficient memory
  *   bErrSectorSize		 sector size too small or not 0 mod 4
  *   bErrFileNotOpen		unable to open index file
+ *   bErrHeader			 existing index file has a bad header, or was
+ *						  created with a different keySize/valSize/dupKeys
+ * notes:
+ *   An existing index file keeps the sector size it was created with;
+ *   info.sectorSize only applies to new files.
 */
 
 ion_bpp_err_t
@@ -287,6 +333,255 @@ b_find_next_key(
  *   bErrKeyNotFound		key not found
 */
 
+ion_bpp_err_t
+b_find_prev_key(
+	ion_bpp_handle_t			handle,
+	void						*key,
+	ion_bpp_external_address_t	*rec
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ * output:
+ *   key					key found
+ *   rec					record address
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrKeyNotFound		key not found
+*/
+
+ion_bpp_err_t
+b_scan_open(
+	ion_bpp_handle_t	handle,
+	ion_bpp_scan_t		*scan
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ * output:
+ *   scan				   scan with no current key
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrMemory			 insufficient memory
+ * notes:
+ *   A scan keeps its own copy of the leaf it is in, and reads the next
+ *   leaf ahead once it is halfway through.  Any number of scans may be
+ *   open on one handle, and other calls may be made on the handle
+ *   between their steps.  A scan that finds the tree changed since its
+ *   last step looks its key up again and carries on after it.
+*/
+
+void
+b_scan_close(
+	ion_bpp_scan_t *scan
+);
+
+/*
+ * input:
+ *   scan				   scan opened by b_scan_open
+ * notes:
+ *   Frees the leaf copies.  A scan zeroed with memset may also be closed.
+*/
+
+ion_bpp_err_t
+b_scan_first(
+	ion_bpp_handle_t			handle,
+	ion_bpp_scan_t				*scan,
+	void						*key,
+	ion_bpp_external_address_t	*rec,
+	void						*value
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ *   scan				   scan opened by b_scan_open
+ * output:
+ *   key					first key in sequential set
+ *   rec					record address
+ *   value				  valSize bytes stored with key, unless NULL
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrKeyNotFound		tree is empty
+*/
+
+ion_bpp_err_t
+b_scan_seek(
+	ion_bpp_handle_t			handle,
+	ion_bpp_scan_t				*scan,
+	void						*target,
+	void						*key,
+	ion_bpp_external_address_t	*rec,
+	void						*value
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ *   scan				   scan opened by b_scan_open
+ *   target				 key to position at
+ * output:
+ *   key					least key greater than or equal to target
+ *   rec					record address
+ *   value				  valSize bytes stored with key, unless NULL
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrKeyNotFound		every key is less than target
+*/
+
+ion_bpp_err_t
+b_scan_next(
+	ion_bpp_handle_t			handle,
+	ion_bpp_scan_t				*scan,
+	void						*key,
+	ion_bpp_external_address_t	*rec,
+	void						*value
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ *   scan				   scan positioned by b_scan_first or b_scan_seek
+ * output:
+ *   key					key after the scan's current key
+ *   rec					record address
+ *   value				  valSize bytes stored with key, unless NULL
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrKeyNotFound		no more keys
+*/
+
+int
+b_scan_recs(
+	ion_bpp_handle_t			handle,
+	ion_bpp_scan_t				*scan,
+	ion_bpp_external_address_t	*recs,
+	int							max
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ *   scan				   scan positioned by b_scan_first, b_scan_seek or
+ *						  b_scan_next
+ *   max					# addresses recs has room for
+ * output:
+ *   recs				   record addresses of the current key and the keys
+ *						  after it in the same leaf, in key order
+ * returns:
+ *   # keys from the current key to the end of its leaf, which may be
+ *   more than max, or 0 if the scan has no current key
+*/
+
+ion_bpp_err_t
+b_bulk_begin(
+	ion_bpp_handle_t	handle,
+	int					fillFactor
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ *   fillFactor			 percentage of each node to fill, 0 for default
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrBulkLoad		   tree not empty, or bulk load already started
+ *   bErrMemory			 insufficient memory
+ * notes:
+ *   Starts building the tree bottom-up from keys given in sorted order
+ *   by b_bulk_add.  Nodes are written sequentially as they fill, and
+ *   only one node per level is kept in memory.  No other calls may be
+ *   made on the handle until b_bulk_end.
+*/
+
+ion_bpp_err_t
+b_bulk_add(
+	ion_bpp_handle_t			handle,
+	void						*key,
+	ion_bpp_external_address_t	rec,
+	void						*value
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ *   key					key to append
+ *   rec					record address
+ *   value				  valSize bytes stored with key, or NULL
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrBulkLoad		   key not greater than previous key, or no bulk load
+ *   bErrIO				 write failed
+*/
+
+ion_bpp_err_t
+b_bulk_end(
+	ion_bpp_handle_t handle
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrBulkLoad		   no bulk load in progress
+ *   bErrIO				 write failed
+ * notes:
+ *   Completes the partially filled node on each level and installs
+ *   the top level as the root.  The tree then accepts normal calls.
+*/
+
+ion_bpp_err_t
+b_get_value(
+	ion_bpp_handle_t	handle,
+	void				*value
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ * output:
+ *   value				  valSize bytes stored with the current key
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrKeyNotFound		no current key
+ * notes:
+ *   The current key is the one last located by b_get, b_insert or a
+ *   b_find_* call, and must be used before any other call on the handle.
+*/
+
+ion_bpp_err_t
+b_put_value(
+	ion_bpp_handle_t	handle,
+	void				*value
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ *   value				  valSize bytes to store with the current key
+ * returns:
+ *   bErrOk				 operation successful
+ *   bErrKeyNotFound		no current key
+*/
+
+ion_bpp_err_t
+b_get_stats(
+	ion_bpp_handle_t	handle,
+	ion_bpp_stats_t		*stats
+);
+
+/*
+ * input:
+ *   handle				 handle returned by bOpen
+ * output:
+ *   stats				  counters for this handle since it was opened
+ * returns:
+ *   bErrOk				 operation successful
+*/
+
 #if defined(__cplusplus)
 }
 #endif
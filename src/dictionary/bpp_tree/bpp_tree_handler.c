@@ -44,12 +44,37 @@ bpptree_get_filename(
 	sprintf(str, "%d.val", id);
 }
 
+/**
+@brief		Picks the node page size for a new tree.
+
+@param		dictionary_size
+				The size given at creation.
+@return		@p dictionary_size if it is a power of two in the allowed
+			range, otherwise @ref ION_BPP_DEFAULT_PAGE_SIZE.
+*/
+static int
+bpptree_page_size(
+	ion_dictionary_size_t dictionary_size
+) {
+	if ((dictionary_size < ION_BPP_MIN_PAGE_SIZE) || (dictionary_size > ION_BPP_MAX_PAGE_SIZE)) {
+		return ION_BPP_DEFAULT_PAGE_SIZE;
+	}
+
+	if (0 != (dictionary_size & (dictionary_size - 1))) {
+		return ION_BPP_DEFAULT_PAGE_SIZE;
+	}
+
+	return (int) dictionary_size;
+}
+
 /**
 @brief		Creates an instance of a dictionary.
 
 @details	Creates as instance of a dictionary given a @p key_size and
-			@p value_size, in bytes. The @p dictionary_size parameter is
-			not used for this implementation, as there is no size bound.
+			@p value_size, in bytes. There is no size bound, so the
+			@p dictionary_size parameter instead selects the size of each
+			node page on disk; see @ref ION_BPP_DEFAULT_PAGE_SIZE. An
+			existing tree keeps the page size it was created with.
 @param		id
 				ID of a dictionary that's given to us.
 @param		key_type
@@ -59,7 +84,8 @@ bpptree_get_filename(
 @param		value_size
 				The size of the value in bytes.
 @param		dictionary_size
-				The size of the hashmap in discrete units
+				The node page size in bytes, or any other value for the
+				default.
 @param		compare
 				Function pointer for the comparison function for the dictionary.
 @param		handler
@@ -80,14 +106,13 @@ bpptree_create_dictionary(
 	ion_dictionary_handler_t	*handler,
 	ion_dictionary_t			*dictionary
 ) {
-	UNUSED(dictionary_size);
-
 /*	if (key_size != sizeof(int)) {
 		return err_invalid_initial_size;
 	}*/
 
-	ion_bpptree_t	*bpptree;
-	ion_bpp_open_t	info;
+	ion_bpptree_t		*bpptree;
+	ion_bpp_open_t		info;
+	ion_file_handle_t	value_file;
 
 	bpptree = malloc(sizeof(ion_bpptree_t));
 
@@ -98,31 +123,57 @@ bpptree_create_dictionary(
 	char value_filename[20];
 
 	bpptree_get_filename(id, value_filename);
-	bpptree->values.file_handle = ion_fopen(value_filename);
+	value_file = ion_fopen(value_filename);
+
+	if (ION_NOFILE == value_file) {
+		free(bpptree);
+		return err_file_open_error;
+	}
 
-	bpptree->values.next_empty	= ION_FILE_NULL;
+	if (err_ok != rh_open(&(bpptree->values), value_file, value_size)) {
+		ion_fclose(value_file);
+		free(bpptree);
+		return err_uninitialized;
+	}
 
 	char addr_filename[ION_MAX_FILENAME_LENGTH];
 
 	int actual_filename_length = dictionary_get_filename(id, "bpt", addr_filename);
 
 	if (actual_filename_length >= ION_MAX_FILENAME_LENGTH) {
+		rh_close(&(bpptree->values));
+		ion_fclose(value_file);
+		free(bpptree);
 		return err_uninitialized;
 	}
 
 	info.iName		= addr_filename;
 	info.keySize	= key_size;
 	info.dupKeys	= boolean_false;
-	info.sectorSize = 256;
+	info.sectorSize = bpptree_page_size(dictionary_size);
 	info.comp		= compare;
+	info.bufCt		= ION_BPP_DEFAULT_BUFFER_COUNT;
+	info.valSize	= (value_size <= ION_BPP_MAX_INLINE_VALUE_SIZE) ? value_size : 0;
 
 	ion_bpp_err_t bErr = b_open(info, &(bpptree->tree));
 
-	if (bErrOk != bErr) {
-		return err_uninitialized;
+	if (((bErrSectorSize == bErr) || (bErrHeader == bErr)) && (0 != info.valSize)) {
+		/* key too large to leave room for values, or an existing tree kept them in the value file */
+		info.valSize	= 0;
+		bErr			= b_open(info, &(bpptree->tree));
+	}
+
+	bpptree->inline_values	= (0 != info.valSize);
+	bpptree->version		= 0;
+
+	if ((bErrOk == bErr) && (NULL == handler)) {
+		b_close(bpptree->tree);
 	}
 
-	if (NULL == handler) {
+	if ((bErrOk != bErr) || (NULL == handler)) {
+		rh_close(&(bpptree->values));
+		ion_fclose(value_file);
+		free(bpptree);
 		return err_uninitialized;
 	}
 
@@ -134,9 +185,68 @@ bpptree_create_dictionary(
 	dictionary->instance->type				= dictionary_type_bpp_tree_t;
 	dictionary->handler						= handler;
 
+	bpptree_set_batch_values(dictionary, ION_BPP_DEFAULT_BATCH_VALUES);
+
 	return err_ok;
 }
 
+/**
+@brief		Inserts into a BppTree instance that keeps values in its leaves.
+
+@details	The newest value of a key is always the one in the leaf, so a
+			duplicate moves the value it displaces to the head of the key's
+			chain in the value file.  This keeps the newest-first order that
+			the value file alone would give.
+
+@param		bpptree
+				The BppTree instance to insert into.
+@param		key
+				The key to use.
+@param		value
+				The value to use.
+@param		bErr
+				The result of looking up @p key.
+@param		offset
+				The value file chain of @p key, if it was found.
+@return		The status on the insertion of the record.
+*/
+static ion_status_t
+bpptree_insert_inline(
+	ion_bpptree_t		*bpptree,
+	ion_key_t			key,
+	ion_value_t			value,
+	ion_bpp_err_t		bErr,
+	ion_file_offset_t	offset
+) {
+	ion_value_size_t	value_size = bpptree->super.record.value_size;
+	ion_byte_t			displaced[value_size];
+
+	if (bErrKeyNotFound == bErr) {
+		bErr = b_insert(bpptree->tree, key, ION_FILE_NULL);
+
+		if (bErrOk == bErr) {
+			bErr = b_put_value(bpptree->tree, value);
+		}
+	}
+	else {
+		b_get_value(bpptree->tree, displaced);
+
+		if (err_ok != rh_put(&(bpptree->values), displaced, value_size, offset, &offset)) {
+			return ION_STATUS_ERROR(err_unable_to_insert);
+		}
+
+		/* leaf is still current, since rh_put does not touch the tree */
+		b_put_value(bpptree->tree, value);
+		bErr = b_update(bpptree->tree, key, offset);
+	}
+
+	if (bErrOk != bErr) {
+		return ION_STATUS_ERROR(err_unable_to_insert);
+	}
+
+	return ION_STATUS_OK(1);
+}
+
 /**
 @brief		Inserts a @p key and @p value into the dictionary.
 
@@ -160,15 +270,20 @@ bpptree_insert(
 	ion_file_offset_t	offset;
 
 	bpptree = (ion_bpptree_t *) dictionary->instance;
+	bpptree->version++;
 
 	offset	= ION_FILE_NULL;
 	bErr	= b_get(bpptree->tree, key, &offset);
 
+	if (bpptree->inline_values) {
+		return bpptree_insert_inline(bpptree, key, value, bErr, offset);
+	}
+
 	if (bErrKeyNotFound == bErr) {
 		offset = ION_FILE_NULL;
 	}
 
-	err = lfb_put(&(bpptree->values), (ion_byte_t *) value, bpptree->super.record.value_size, offset, &offset);
+	err = rh_put(&(bpptree->values), (ion_byte_t *) value, bpptree->super.record.value_size, offset, &offset);
 
 	if (err_ok == err) {
 		if (bErrKeyNotFound == bErr) {
@@ -233,7 +348,12 @@ bpptree_get(
 		return ION_STATUS_ERROR(err_item_not_found);
 	}
 
-	err = lfb_get(&(bpptree->values), offset, bpptree->super.record.value_size, (ion_byte_t *) value, &next);
+	if (bpptree->inline_values) {
+		b_get_value(bpptree->tree, value);
+		return ION_STATUS_OK(1);
+	}
+
+	err = rh_get(&(bpptree->values), offset, bpptree->super.record.value_size, (ion_byte_t *) value, &next);
 
 	if (err_ok == err) {
 		return ION_STATUS_OK(1);
@@ -265,11 +385,14 @@ bpptree_delete(
 	status	= ION_STATUS_INITIALIZE;
 
 	bpptree = (ion_bpptree_t *) dictionary->instance;
+	bpptree->version++;
 
 	bErr	= b_delete(bpptree->tree, key, &offset);
 
 	if (bErrKeyNotFound != bErr) {
-		status.error = lfb_delete_all(&(bpptree->values), offset, &(status.count));
+		/* with inline values, offset only chains older duplicates */
+		status.count	= bpptree->inline_values ? 1 : 0;
+		status.error	= rh_delete_all(&(bpptree->values), offset, &(status.count));
 	}
 	else {
 		status.error = err_item_not_found;
@@ -292,14 +415,16 @@ bpptree_close_dictionary(
 ) {
 	ion_bpptree_t	*bpptree;
 	ion_bpp_err_t	bErr;
+	ion_err_t		err;
 
 	bpptree					= (ion_bpptree_t *) dictionary->instance;
 	bErr					= b_close(bpptree->tree);
+	err						= rh_close(&(bpptree->values));
 	ion_fclose(bpptree->values.file_handle);
 	free(dictionary->instance);
 	dictionary->instance	= NULL;
 
-	if (bErrOk != bErr) {
+	if ((bErrOk != bErr) || (err_ok != err)) {
 		return err_dictionary_destruction_error;
 	}
 
@@ -395,11 +520,17 @@ bpptree_update(
 
 	count	= 0;
 	bpptree = (ion_bpptree_t *) dictionary->instance;
+	bpptree->version++;
 
 	bErr	= b_get(bpptree->tree, key, &offset);
 
 	if (bErrKeyNotFound != bErr) {
-		lfb_update_all(&(bpptree->values), offset, bpptree->super.record.value_size, (ion_byte_t *) value, &count);
+		if (bpptree->inline_values) {
+			b_put_value(bpptree->tree, value);
+			count++;
+		}
+
+		rh_update_all(&(bpptree->values), offset, bpptree->super.record.value_size, (ion_byte_t *) value, &count);
 	}
 	else {
 		return bpptree_insert(dictionary, key, value);
@@ -408,6 +539,182 @@ bpptree_update(
 	return ION_STATUS_OK(count);
 }
 
+/**
+@brief		Holds the inline value of the key a cursor has just moved to.
+
+@param		bpptree
+				The BppTree instance the cursor is over.
+@param		bCursor
+				The cursor, positioned by the last call on the tree.
+*/
+static void
+bpptree_cursor_take_value(
+	ion_bpptree_t		*bpptree,
+	ion_bpp_cursor_t	*bCursor
+) {
+	if (bpptree->inline_values) {
+		b_get_value(bpptree->tree, bCursor->cur_value);
+		bCursor->value_pending = boolean_true;
+	}
+}
+
+/**
+@brief		Orders batch entries by value file offset.
+*/
+static int
+bpptree_batch_compare(
+	const void	*a,
+	const void	*b
+) {
+	ion_bpp_external_address_t	x	= ((const ion_bpp_batch_entry_t *) a)->rec;
+	ion_bpp_external_address_t	y	= ((const ion_bpp_batch_entry_t *) b)->rec;
+
+	return (x > y) - (x < y);
+}
+
+/**
+@brief		Reads the head of the value chain of every key from the cursor's
+			to the end of its leaf.
+@details	The offsets are sorted, and values that fit in one read of
+			@ref ION_BPP_BATCH_READ_SIZE bytes are read together.  If the
+			batch cannot be filled the cursor reads each value on its own.
+@param		bpptree
+				The BppTree instance the cursor is over.
+@param		bCursor
+				The cursor, just moved to a key.
+*/
+static void
+bpptree_batch_fill(
+	ion_bpptree_t		*bpptree,
+	ion_bpp_cursor_t	*bCursor
+) {
+	ion_bpp_batch_t		*batch		= &bCursor->batch;
+	int					slot_size	= sizeof(ion_file_offset_t) + bpptree->super.record.value_size;
+	int					read_size	= slot_size > ION_BPP_BATCH_READ_SIZE ? slot_size : ION_BPP_BATCH_READ_SIZE;
+	ion_file_offset_t	start;
+	void				*grown;
+	int					n;
+	int					m;
+	int					i;
+	int					j;
+	int					k;
+
+	batch->count	= 0;
+	batch->pos		= 0;
+	batch->version	= bpptree->version;
+
+	n				= b_scan_recs(bpptree->tree, &bCursor->scan, batch->recs, batch->size);
+
+	if (n > batch->size) {
+		if (NULL == (grown = realloc(batch->slots, n * slot_size))) {
+			return;
+		}
+
+		batch->slots = grown;
+
+		if (NULL == (grown = realloc(batch->recs, n * sizeof(ion_bpp_external_address_t)))) {
+			return;
+		}
+
+		batch->recs = grown;
+
+		if (NULL == (grown = realloc(batch->order, n * sizeof(ion_bpp_batch_entry_t)))) {
+			return;
+		}
+
+		batch->order	= grown;
+		batch->size		= n;
+		b_scan_recs(bpptree->tree, &bCursor->scan, batch->recs, batch->size);
+	}
+
+	for (i = 0, m = 0; i < n; i++) {
+		if (ION_FILE_NULL != batch->recs[i]) {
+			batch->order[m].rec		= batch->recs[i];
+			batch->order[m].index	= i;
+			m++;
+		}
+	}
+
+	qsort(batch->order, m, sizeof(ion_bpp_batch_entry_t), bpptree_batch_compare);
+
+	/* values are read straight from the file, past the heap's pages */
+	if (err_ok != rh_flush(&(bpptree->values))) {
+		return;
+	}
+
+	for (i = 0; i < m; i = j) {
+		start = batch->order[i].rec;
+
+		for (j = i + 1; j < m && batch->order[j].rec + slot_size - start <= read_size; j++) {}
+
+		if (err_ok != ion_fread_at(bpptree->values.file_handle, start, batch->order[j - 1].rec + slot_size - start, batch->read_buffer)) {
+			return;
+		}
+
+		for (k = i; k < j; k++) {
+			memcpy(batch->slots + batch->order[k].index * slot_size, batch->read_buffer + (batch->order[k].rec - start), slot_size);
+		}
+	}
+
+	batch->count = n;
+}
+
+/**
+@brief		Reads the value at a cursor's offset in the value file, and moves
+			the offset along the chain.
+@details	The head of the chain is taken from the batch if it holds it.
+@param		bpptree
+				The BppTree instance the cursor is over.
+@param		bCursor
+				The cursor.
+@param		value
+				Where to write the value.
+*/
+static void
+bpptree_cursor_read_value(
+	ion_bpptree_t		*bpptree,
+	ion_bpp_cursor_t	*bCursor,
+	ion_value_t			value
+) {
+	ion_bpp_batch_t *batch = &bCursor->batch;
+
+	if ((batch->pos < batch->count) && (batch->recs[batch->pos] == bCursor->offset) && (batch->version == bpptree->version)) {
+		ion_byte_t *slot = batch->slots + batch->pos * (sizeof(ion_file_offset_t) + bpptree->super.record.value_size);
+
+		memcpy(&bCursor->offset, slot, sizeof(ion_file_offset_t));
+		memcpy(value, slot + sizeof(ion_file_offset_t), bpptree->super.record.value_size);
+		return;
+	}
+
+	rh_get(&(bpptree->values), bCursor->offset, bpptree->super.record.value_size, value, &bCursor->offset);
+}
+
+/**
+@brief		Moves a range or all records cursor to the next key in the tree.
+@details	The cursor keeps its own place in the leaves, so other cursors
+			and calls on the tree may come between its steps.
+@param		bpptree
+				The BppTree instance the cursor is over.
+@param		bCursor
+				The cursor to move.
+@return		The status of the step.
+*/
+static ion_bpp_err_t
+bpptree_cursor_step(
+	ion_bpptree_t		*bpptree,
+	ion_bpp_cursor_t	*bCursor
+) {
+	ion_bpp_err_t err = b_scan_next(bpptree->tree, &bCursor->scan, bCursor->cur_key, &bCursor->offset, bpptree->inline_values ? bCursor->cur_value : NULL);
+
+	bCursor->value_pending = bpptree->inline_values && (bErrOk == err);
+
+	if ((bErrOk == err) && (NULL != bCursor->batch.read_buffer) && ((++bCursor->batch.pos >= bCursor->batch.count) || (bCursor->batch.version != bpptree->version))) {
+		bpptree_batch_fill(bpptree, bCursor);
+	}
+
+	return err;
+}
+
 /**
 @brief		Next function to query and retrieve the next
 			<K,V> that stratifies the predicate of the cursor.
@@ -438,45 +745,48 @@ bpptree_next(
 		if (cursor->status == cs_cursor_active) {
 			ion_boolean_t is_valid = boolean_true;
 
-			switch (cursor->predicate->type) {
-				case predicate_equality: {
-					if (-1 == bCursor->offset) {
-						/* End of results, we can quit */
-						is_valid = boolean_false;
-					}
+			/* the inline value of cur_key comes before its value file chain */
+			if (!bCursor->value_pending) {
+				switch (cursor->predicate->type) {
+					case predicate_equality: {
+						if (-1 == bCursor->offset) {
+							/* End of results, we can quit */
+							is_valid = boolean_false;
+						}
 
-					break;
-				}
+						break;
+					}
 
-				case predicate_range: {
-					/*do b_find_next_key then test_predicate */
-					if (-1 == bCursor->offset) {
-						ion_bpp_err_t bErr = b_find_next_key(bpptree->tree, bCursor->cur_key, &bCursor->offset);
+					case predicate_range: {
+						/*do b_scan_next then test_predicate */
+						if (-1 == bCursor->offset) {
+							ion_bpp_err_t bErr = bpptree_cursor_step(bpptree, bCursor);
 
-						if ((bErrOk != bErr) || (boolean_false == test_predicate(cursor, bCursor->cur_key))) {
-							is_valid = boolean_false;
+							if ((bErrOk != bErr) || (boolean_false == test_predicate(cursor, bCursor->cur_key))) {
+								is_valid = boolean_false;
+							}
 						}
-					}
 
-					break;
-				}
+						break;
+					}
 
-				case predicate_all_records: {
-					if (-1 == bCursor->offset) {
-						ion_bpp_err_t bErr = b_find_next_key(bpptree->tree, bCursor->cur_key, &bCursor->offset);
+					case predicate_all_records: {
+						if (-1 == bCursor->offset) {
+							ion_bpp_err_t bErr = bpptree_cursor_step(bpptree, bCursor);
 
-						if (bErrOk != bErr) {
-							is_valid = boolean_false;
+							if (bErrOk != bErr) {
+								is_valid = boolean_false;
+							}
 						}
-					}
 
-					break;
-				}
+						break;
+					}
 
-				case predicate_predicate: {
-					break;
+					case predicate_predicate: {
+						break;
+					}
+						/*No default since we can assume the predicate is valid. */
 				}
-					/*No default since we can assume the predicate is valid. */
 			}
 
 			if (boolean_false == is_valid) {
@@ -493,7 +803,14 @@ bpptree_next(
 		memcpy(record->key, bCursor->cur_key, cursor->dictionary->instance->record.key_size);
 
 		/* Get value */
-		lfb_get(&(bpptree->values), bCursor->offset, cursor->dictionary->instance->record.value_size, record->value, &bCursor->offset);
+		if (bCursor->value_pending) {
+			memcpy(record->value, bCursor->cur_value, cursor->dictionary->instance->record.value_size);
+			bCursor->value_pending = boolean_false;
+		}
+		else {
+			bpptree_cursor_read_value(bpptree, bCursor, record->value);
+		}
+
 		return cursor->status;
 	}
 
@@ -517,11 +834,51 @@ bpptree_destroy_cursor(
 	ion_dict_cursor_t **cursor
 ) {
 	(*cursor)->predicate->destroy(&(*cursor)->predicate);
-	free(((ion_bpp_cursor_t *) (*cursor))->cur_key);
+	ion_bpp_cursor_t *bCursor = (ion_bpp_cursor_t *) (*cursor);
+
+	b_scan_close(&bCursor->scan);
+	free(bCursor->batch.slots);
+	free(bCursor->batch.recs);
+	free(bCursor->batch.order);
+	free(bCursor->batch.read_buffer);
+	free(bCursor->cur_key);
 	free((*cursor));
 	*cursor = NULL;
 }
 
+/**
+@brief		Starts reading values together for a cursor that has just found
+			its first key, if the dictionary batches values.
+@param		bpptree
+				The BppTree instance the cursor is over.
+@param		cursor
+				The cursor, which is destroyed if it cannot be set up.
+@return		The status of the operation.
+*/
+static ion_err_t
+bpptree_cursor_start_batch(
+	ion_bpptree_t		*bpptree,
+	ion_dict_cursor_t	**cursor
+) {
+	ion_bpp_cursor_t	*bCursor	= (ion_bpp_cursor_t *) (*cursor);
+	int					slot_size	= sizeof(ion_file_offset_t) + bpptree->super.record.value_size;
+
+	/* inline values are already in the leaf, and the value file only holds older duplicates */
+	if (!bpptree->batch_values || bpptree->inline_values) {
+		return err_ok;
+	}
+
+	bCursor->batch.read_buffer = malloc(slot_size > ION_BPP_BATCH_READ_SIZE ? slot_size : ION_BPP_BATCH_READ_SIZE);
+
+	if (NULL == bCursor->batch.read_buffer) {
+		bpptree_destroy_cursor(cursor);
+		return err_out_of_memory;
+	}
+
+	bpptree_batch_fill(bpptree, bCursor);
+	return err_ok;
+}
+
 /**
 @brief	  Finds multiple instances of a keys that satisfy the provided
 			 predicate in the dictionary.
@@ -557,13 +914,19 @@ bpptree_find(
 
 	ion_bpp_cursor_t *bCursor = (ion_bpp_cursor_t *) (*cursor);
 
-	bCursor->cur_key = malloc(key_size);
+	/* an inline value is held in the same allocation, after the key */
+	bCursor->cur_key = malloc(key_size + (bpptree->inline_values ? dictionary->instance->record.value_size : 0));
 
 	if (NULL == bCursor->cur_key) {
 		free(bCursor);
 		return err_out_of_memory;
 	}
 
+	bCursor->cur_value		= (ion_value_t) ((ion_byte_t *) bCursor->cur_key + key_size);
+	bCursor->value_pending	= boolean_false;
+	memset(&bCursor->scan, 0, sizeof(bCursor->scan));
+	memset(&bCursor->batch, 0, sizeof(bCursor->batch));
+
 	(*cursor)->dictionary	= dictionary;
 	(*cursor)->status		= cs_cursor_uninitialized;
 
@@ -606,6 +969,7 @@ bpptree_find(
 				return err_ok;
 			}
 			else {
+				bpptree_cursor_take_value(bpptree, bCursor);
 				(*cursor)->status = cs_cursor_initialized;
 				return err_ok;
 			}
@@ -637,17 +1001,24 @@ bpptree_find(
 
 			memcpy((*cursor)->predicate->statement.range.upper_bound, predicate->statement.range.upper_bound, key_size);
 
+			if (bErrOk != b_scan_open(bpptree->tree, &bCursor->scan)) {
+				bpptree_destroy_cursor(cursor);
+				return err_out_of_memory;
+			}
+
 			/* We search for the FGEQ of the Lower bound. */
-			b_find_first_greater_or_equal(bpptree->tree, (*cursor)->predicate->statement.range.lower_bound, bCursor->cur_key, &bCursor->offset);
+			ion_bpp_err_t err = b_scan_seek(bpptree->tree, &bCursor->scan, (*cursor)->predicate->statement.range.lower_bound, bCursor->cur_key, &bCursor->offset, bpptree->inline_values ? bCursor->cur_value : NULL);
+
+			bCursor->value_pending = bpptree->inline_values && (bErrOk == err);
 
 			/* If the key returned doesn't satisfy the predicate, we can exit */
-			if (boolean_false == test_predicate(*cursor, bCursor->cur_key)) {
+			if ((bErrOk != err) || (boolean_false == test_predicate(*cursor, bCursor->cur_key))) {
 				(*cursor)->status = cs_end_of_results;
 				return err_ok;
 			}
 			else {
 				(*cursor)->status = cs_cursor_initialized;
-				return err_ok;
+				return bpptree_cursor_start_batch(bpptree, cursor);
 			}
 
 			break;
@@ -656,14 +1027,23 @@ bpptree_find(
 		case predicate_all_records: {
 			ion_bpp_err_t err;
 
+			if (bErrOk != b_scan_open(bpptree->tree, &bCursor->scan)) {
+				bpptree_destroy_cursor(cursor);
+				return err_out_of_memory;
+			}
+
 			/* We search for first key in B++ tree. */
-			err					= b_find_first_key(bpptree->tree, bCursor->cur_key, &bCursor->offset);
+			err						= b_scan_first(bpptree->tree, &bCursor->scan, bCursor->cur_key, &bCursor->offset, bpptree->inline_values ? bCursor->cur_value : NULL);
+			bCursor->value_pending	= bpptree->inline_values && (bErrOk == err);
 
-			(*cursor)->status	= cs_cursor_initialized;
+			(*cursor)->status		= cs_cursor_initialized;
 
 			if (bErrOk != err) {
 				(*cursor)->status = cs_end_of_results;
 			}
+			else {
+				return bpptree_cursor_start_batch(bpptree, cursor);
+			}
 
 			return err_ok;
 			break;
@@ -707,6 +1087,173 @@ bpptree_open_dictionary(
 	return bpptree_create_dictionary(config->id, config->type, config->key_size, config->value_size, config->dictionary_size, compare, handler, dictionary);
 }
 
+ion_err_t
+bpptree_set_batch_values(
+	ion_dictionary_t	*dictionary,
+	ion_boolean_t		batch_values
+) {
+	((ion_bpptree_t *) dictionary->instance)->batch_values = batch_values;
+	return err_ok;
+}
+
+/**
+@brief			Reports the performance counters of a BppTree instance.
+
+@details		Counters cover the index file and its node buffer pool; the
+				value file is not included.
+
+@param			dictionary
+					A pointer to the specific dictionary instance to report on.
+@param			stats
+					The statistics to fill in.
+
+@return			The status of retrieving the statistics.
+ */
+ion_err_t
+bpptree_get_stats(
+	ion_dictionary_t		*dictionary,
+	ion_dictionary_stats_t	*stats
+) {
+	ion_bpptree_t	*bpptree;
+	ion_bpp_stats_t bstats;
+
+	bpptree = (ion_bpptree_t *) dictionary->instance;
+
+	if (bErrOk != b_get_stats(bpptree->tree, &bstats)) {
+		return err_uninitialized;
+	}
+
+	stats->num_reads		= bstats.nDiskReads;
+	stats->num_writes		= bstats.nDiskWrites;
+	stats->bytes_read		= bstats.nBytesRead;
+	stats->bytes_written	= bstats.nBytesWritten;
+	stats->cache_hits		= bstats.nBufHits;
+	stats->cache_misses		= bstats.nBufMisses;
+	stats->num_splits		= bstats.nSplits;
+	stats->num_merges		= bstats.nMerges;
+	stats->num_inserts		= bstats.nKeysIns;
+	stats->num_deletes		= bstats.nKeysDel;
+	stats->height			= bstats.maxHeight;
+
+	return err_ok;
+}
+
+ion_status_t
+bpptree_bulk_load(
+	ion_dictionary_t	*dictionary,
+	ion_dict_cursor_t	*cursor,
+	int					fill_factor
+) {
+	ion_bpptree_t		*bpptree;
+	ion_status_t		status;
+	ion_bpp_err_t		bErr;
+	ion_err_t			err;
+	ion_record_t		record;
+	ion_key_t			run_key;
+	ion_value_t			run_value;
+	ion_file_offset_t	offset;
+	ion_file_offset_t	run_head;
+	ion_file_offset_t	run_tail;
+	int					run_len;
+	int					cc;
+	ion_key_size_t		key_size;
+	ion_value_size_t	value_size;
+
+	bpptree		= (ion_bpptree_t *) dictionary->instance;
+	key_size	= bpptree->super.record.key_size;
+	value_size	= bpptree->super.record.value_size;
+	status		= ION_STATUS_INITIALIZE;
+	bpptree->version++;
+
+	record.key		= malloc(key_size);
+	record.value	= malloc(value_size);
+	run_key			= malloc(key_size);
+	run_value		= malloc(value_size);
+
+	if ((NULL == record.key) || (NULL == record.value) || (NULL == run_key) || (NULL == run_value)) {
+		status.error = err_out_of_memory;
+	}
+	else if (bErrOk != b_bulk_begin(bpptree->tree, fill_factor)) {
+		status.error = err_unable_to_insert;
+	}
+	else {
+		status.error	= err_ok;
+		bErr			= bErrOk;
+		err				= err_ok;
+		run_head		= ION_RH_NULL;
+		run_tail		= ION_RH_NULL;
+		run_len			= 0;
+
+		while (cs_cursor_active == cursor->next(cursor, &record)) {
+			cc = (0 == run_len) ? 1 : dictionary->instance->compare(record.key, run_key, key_size);
+
+			if (cc < 0) {
+				status.error = err_sorted_order_violation;
+				break;
+			}
+
+			if (0 != cc) {
+				/* previous key has all its values */
+				if ((run_len > 0) && (bErrOk != (bErr = b_bulk_add(bpptree->tree, run_key, run_head, run_value)))) {
+					break;
+				}
+
+				memcpy(run_key, record.key, key_size);
+				run_head	= ION_RH_NULL;
+				run_len		= 0;
+			}
+
+			if (bpptree->inline_values && (0 == run_len)) {
+				memcpy(run_value, record.value, value_size);
+			}
+			else {
+				/* values fill the heap's pages in order, so a key's values sit together */
+				if (err_ok != (err = rh_put(&(bpptree->values), record.value, value_size, ION_RH_NULL, &offset))) {
+					break;
+				}
+
+				if (ION_RH_NULL == run_head) {
+					run_head = offset;
+				}
+				else {
+					/* duplicate, chain from the previous value */
+					if (err_ok != (err = rh_update_next(&(bpptree->values), run_tail, offset))) {
+						break;
+					}
+				}
+
+				run_tail = offset;
+			}
+
+			run_len++;
+			status.count++;
+		}
+
+		if ((err_ok == err) && (bErrOk == bErr) && (run_len > 0)) {
+			bErr = b_bulk_add(bpptree->tree, run_key, run_head, run_value);
+		}
+
+		/* always finish, so the keys added so far form a valid tree */
+		if (bErrOk != b_bulk_end(bpptree->tree)) {
+			bErr = bErrIO;
+		}
+
+		if (err_ok != err) {
+			status.error = err;
+		}
+		else if ((bErrOk != bErr) && (err_ok == status.error)) {
+			status.error = err_unable_to_insert;
+		}
+	}
+
+	free(record.key);
+	free(record.value);
+	free(run_key);
+	free(run_value);
+
+	return status;
+}
+
 void
 bpptree_init(
 	ion_dictionary_handler_t *handler
@@ -721,4 +1268,5 @@ bpptree_init(
 	handler->destroy_dictionary = bpptree_destroy_dictionary;
 	handler->open_dictionary	= bpptree_open_dictionary;
 	handler->close_dictionary	= bpptree_close_dictionary;
+	handler->get_stats			= bpptree_get_stats;
 }
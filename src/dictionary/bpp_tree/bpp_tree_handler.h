@@ -44,19 +44,109 @@ extern "C" {
 #include "../dictionary_types.h"
 #include "./../dictionary.h"
 #include "../../key_value/kv_system.h"
-#include "../../file/linked_file_bag.h"
+#include "../../file/record_heap.h"
 #include "bpp_tree.h"
 
+/**
+@brief		Size, in bytes, of each tree node on disk when the creator does
+			not ask for one.
+
+@details	A @p dictionary_size that is a power of two between
+			@ref ION_BPP_MIN_PAGE_SIZE and @ref ION_BPP_MAX_PAGE_SIZE is
+			used as the page size instead.  The page size is stored in the
+			index file, so reopening a tree always uses the size it was
+			created with.
+*/
+#if !defined(ION_BPP_DEFAULT_PAGE_SIZE)
+#if defined(ARDUINO)
+#define ION_BPP_DEFAULT_PAGE_SIZE 256
+#else
+#define ION_BPP_DEFAULT_PAGE_SIZE 4096
+#endif
+#endif
+
+/**
+@brief		Smallest page size that may be requested at creation.
+*/
+#define ION_BPP_MIN_PAGE_SIZE	256
+
+/**
+@brief		Largest page size that may be requested at creation.
+*/
+#define ION_BPP_MAX_PAGE_SIZE	65536
+
+/**
+@brief		Whether range and all records cursors read the values of a leaf
+			together, unless changed with @ref bpptree_set_batch_values.
+*/
+#if !defined(ION_BPP_DEFAULT_BATCH_VALUES)
+#if defined(ARDUINO)
+#define ION_BPP_DEFAULT_BATCH_VALUES boolean_false
+#else
+#define ION_BPP_DEFAULT_BATCH_VALUES boolean_true
+#endif
+#endif
+
+/**
+@brief		Largest read, in bytes, a cursor makes when reading the values of
+			a leaf together.
+@details	Values closer together than this are read at once, gaps included.
+*/
+#if !defined(ION_BPP_BATCH_READ_SIZE)
+#if defined(ARDUINO)
+#define ION_BPP_BATCH_READ_SIZE 256
+#else
+#define ION_BPP_BATCH_READ_SIZE 4096
+#endif
+#endif
+
+/**
+@brief		Largest value, in bytes, kept next to its key in the leaves.
+
+@details	Smaller values are read with the key instead of from the value
+			file.  The value file then only holds the older values of
+			duplicate keys.  Define as 0 to keep all values in the value file.
+*/
+#if !defined(ION_BPP_MAX_INLINE_VALUE_SIZE)
+#define ION_BPP_MAX_INLINE_VALUE_SIZE 8
+#endif
+
 typedef struct bplusplustree {
 	ion_dictionary_parent_t super;
 	ion_bpp_handle_t		tree;
-	ion_lfb_t				values;
+	ion_rh_t				values;
+	ion_boolean_t			inline_values;	/**< Newest value of each key is in the leaves */
+	ion_boolean_t			batch_values;	/**< Cursors read the values of a leaf together */
+	unsigned long			version;		/**< Count of changes, so cursors know when batched values are stale */
 } ion_bpptree_t;
 
+typedef struct {
+	ion_bpp_external_address_t	rec;	/**< Value file offset */
+	int							index;	/**< Position of its key in the batch */
+} ion_bpp_batch_entry_t;
+
+/**
+@brief		Values read together for the rest of a cursor's leaf.
+*/
+typedef struct {
+	ion_byte_t					*slots;	/**< [next, value] at the head of each key's value chain */
+	ion_bpp_external_address_t	*recs;	/**< Value file offset of each slot, in key order */
+	ion_bpp_batch_entry_t		*order;	/**< Slots sorted by value file offset */
+	ion_byte_t					*read_buffer;	/**< Holds one read, or NULL if not batching */
+	int							count;	/**< Keys in the batch */
+	int							pos;	/**< Index in the batch of cur_key */
+	int							size;	/**< Keys the batch has room for */
+	unsigned long				version;/**< Dictionary version the batch was read at */
+} ion_bpp_batch_t;
+
 typedef struct {
 	ion_dict_cursor_t	super;		/**< Supertype of cursor		*/
 	ion_key_t			cur_key;/**< Current key we're visiting */
 	ion_file_offset_t	offset;		/**< offset in LFB; holds value */
+	ion_value_t			cur_value;	/**< Inline value of cur_key */
+	ion_boolean_t		value_pending;	/**< cur_value not yet returned */
+	ion_bpp_scan_t		scan;		/**< Position in the leaves of a range or all records cursor */
+	ion_bpp_batch_t		batch;		/**< Values of the rest of the leaf */
 } ion_bpp_cursor_t;
 
 /**
@@ -74,6 +164,52 @@ bpptree_init(
 	ion_dictionary_handler_t *handler
 );
 
+/**
+@brief		Builds an empty BppTree instance bottom-up from sorted records.
+
+@details	Records are drawn from @p cursor until it is exhausted, and must
+			arrive in ascending key order, such as from an all records
+			cursor over another BppTree.  Leaves are written sequentially
+			and values are appended to the value file in one pass.  Records
+			with equal keys keep their cursor order.
+
+@param		dictionary
+				The empty dictionary instance to load.
+@param		cursor
+				The cursor supplying the records.
+@param		fill_factor
+				Percentage of each node to fill, or 0 for
+				@ref ION_BPP_DEFAULT_FILL_FACTOR.
+@return		The status of the load, with the number of records loaded.
+*/
+ion_status_t
+bpptree_bulk_load(
+	ion_dictionary_t	*dictionary,
+	ion_dict_cursor_t	*cursor,
+	int					fill_factor
+);
+
+/**
+@brief		Sets whether range and all records cursors read the values of a
+			leaf together.
+@details	When a cursor reaches a leaf, the value file offsets of its keys
+			are sorted and read in as few reads of up to
+			@ref ION_BPP_BATCH_READ_SIZE bytes as possible, instead of one
+			read per record.  Older values of a duplicate key are still read
+			one at a time, as are all values of a tree that keeps them in its
+			leaves.  Applies to cursors opened afterwards.
+@param		dictionary
+				The BppTree dictionary instance.
+@param		batch_values
+				@c boolean_true to read values together.
+@return		The status of the change.
+*/
+ion_err_t
+bpptree_set_batch_values(
+	ion_dictionary_t	*dictionary,
+	ion_boolean_t		batch_values
+);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -63,7 +63,10 @@ dictionary_compare_char_array(
 	ion_key_t		second_key,
 	ion_key_size_t	key_size
 ) {
-	return strncmp((char *) first_key, (char *) second_key, key_size);
+	int result = memcmp(first_key, second_key, key_size);
+
+	/* memcmp may return any magnitude, which would not survive the narrowing to char */
+	return (result > 0) - (result < 0);
 }
 
 /**
@@ -85,20 +88,155 @@ dictionary_compare_null_terminated_string(
 	return strncmp((char *) first_key, (char *) second_key, key_size);
 }
 
+/**
+@brief		Compares two native integers of type @p type stored at
+			@p first_key and @p second_key, which need not be aligned.
+*/
+#define ION_COMPARE_NATIVE(type, first_key, second_key) \
+	type	first; \
+	type	second; \
+ \
+	memcpy(&first, first_key, sizeof(type)); \
+	memcpy(&second, second_key, sizeof(type)); \
+	return (first > second) - (first < second)
+
+char
+dictionary_compare_int8(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+) {
+	UNUSED(key_size);
+	ION_COMPARE_NATIVE(int8_t, first_key, second_key);
+}
+
+char
+dictionary_compare_uint8(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+) {
+	UNUSED(key_size);
+	ION_COMPARE_NATIVE(uint8_t, first_key, second_key);
+}
+
+char
+dictionary_compare_int16(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+) {
+	UNUSED(key_size);
+	ION_COMPARE_NATIVE(int16_t, first_key, second_key);
+}
+
+char
+dictionary_compare_uint16(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+) {
+	UNUSED(key_size);
+	ION_COMPARE_NATIVE(uint16_t, first_key, second_key);
+}
+
+char
+dictionary_compare_int32(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+) {
+	UNUSED(key_size);
+	ION_COMPARE_NATIVE(int32_t, first_key, second_key);
+}
+
+char
+dictionary_compare_uint32(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+) {
+	UNUSED(key_size);
+	ION_COMPARE_NATIVE(uint32_t, first_key, second_key);
+}
+
+char
+dictionary_compare_int64(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+) {
+	UNUSED(key_size);
+	ION_COMPARE_NATIVE(int64_t, first_key, second_key);
+}
+
+char
+dictionary_compare_uint64(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+) {
+	UNUSED(key_size);
+	ION_COMPARE_NATIVE(uint64_t, first_key, second_key);
+}
+
 ion_dictionary_compare_t
 dictionary_switch_compare(
-	ion_key_type_t key_type
+	ion_key_type_t	key_type,
+	ion_key_size_t	key_size
 ) {
-	ion_dictionary_compare_t compare;
+	ion_dictionary_compare_t compare = NULL;
 
 	switch (key_type) {
 		case key_type_numeric_signed: {
-			compare = dictionary_compare_signed_value;
+			switch (key_size) {
+				case sizeof(int8_t):
+					compare = dictionary_compare_int8;
+					break;
+
+				case sizeof(int16_t):
+					compare = dictionary_compare_int16;
+					break;
+
+				case sizeof(int32_t):
+					compare = dictionary_compare_int32;
+					break;
+
+				case sizeof(int64_t):
+					compare = dictionary_compare_int64;
+					break;
+
+				default:
+					compare = dictionary_compare_signed_value;
+					break;
+			}
+
 			break;
 		}
 
 		case key_type_numeric_unsigned: {
-			compare = dictionary_compare_unsigned_value;
+			switch (key_size) {
+				case sizeof(uint8_t):
+					compare = dictionary_compare_uint8;
+					break;
+
+				case sizeof(uint16_t):
+					compare = dictionary_compare_uint16;
+					break;
+
+				case sizeof(uint32_t):
+					compare = dictionary_compare_uint32;
+					break;
+
+				case sizeof(uint64_t):
+					compare = dictionary_compare_uint64;
+					break;
+
+				default:
+					compare = dictionary_compare_unsigned_value;
+					break;
+			}
+
 			break;
 		}
 
@@ -121,6 +259,155 @@ dictionary_switch_compare(
 	return compare;
 }
 
+/* constants from the murmur3 64-bit finalizer and xxh64 */
+#define ION_HASH_MIX_SEED	0x9E3779B97F4A7C15ULL
+#define ION_HASH_MIX_M1		0xFF51AFD7ED558CCDULL
+#define ION_HASH_MIX_M2		0xC4CEB9FE1A85EC53ULL
+#define ION_HASH_MIX_PRIME	0x87C37B91114253D5ULL
+#define ION_HASH_FNV_OFFSET 2166136261UL
+#define ION_HASH_FNV_PRIME	16777619UL
+
+/**
+@brief		Spreads every bit of @p h over the whole word.
+*/
+static uint64_t
+dictionary_hash_finalize(
+	uint64_t h
+) {
+	h	^= h >> 33;
+	h	*= ION_HASH_MIX_M1;
+	h	^= h >> 33;
+	h	*= ION_HASH_MIX_M2;
+	h	^= h >> 33;
+	return h;
+}
+
+uint64_t
+dictionary_hash_mix64(
+	ion_key_t		key,
+	ion_key_size_t	key_size
+) {
+	ion_byte_t	*bytes	= key;
+	uint64_t	h		= ION_HASH_MIX_SEED ^ (uint64_t) key_size;
+	uint64_t	word	= 0;
+
+	switch (key_size) {
+		case sizeof(uint8_t):
+			return dictionary_hash_finalize(h ^ *bytes);
+
+		case sizeof(uint16_t): {
+			uint16_t value;
+
+			memcpy(&value, bytes, sizeof(value));
+			return dictionary_hash_finalize(h ^ value);
+		}
+
+		case sizeof(uint32_t): {
+			uint32_t value;
+
+			memcpy(&value, bytes, sizeof(value));
+			return dictionary_hash_finalize(h ^ value);
+		}
+
+		case sizeof(uint64_t):
+			memcpy(&word, bytes, sizeof(word));
+			return dictionary_hash_finalize(h ^ word);
+	}
+
+	for (; key_size >= (ion_key_size_t) sizeof(uint64_t); key_size -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+		memcpy(&word, bytes, sizeof(word));
+		h	^= dictionary_hash_finalize(word);
+		h	= ((h << 27) | (h >> 37)) * ION_HASH_MIX_PRIME;
+	}
+
+	if (key_size > 0) {
+		word = 0;
+		memcpy(&word, bytes, key_size);
+		h	^= dictionary_hash_finalize(word);
+	}
+
+	return dictionary_hash_finalize(h);
+}
+
+uint64_t
+dictionary_hash_fnv1a(
+	ion_key_t		key,
+	ion_key_size_t	key_size
+) {
+	ion_byte_t	*bytes	= key;
+	uint32_t	h		= ION_HASH_FNV_OFFSET;
+	int			i;
+
+	for (i = 0; i < key_size; i++) {
+		h	^= bytes[i];
+		h	*= ION_HASH_FNV_PRIME;
+	}
+
+	return h;
+}
+
+/**
+@brief		Length of a null-terminated string key, without the terminator.
+*/
+static ion_key_size_t
+dictionary_string_key_length(
+	ion_key_t		key,
+	ion_key_size_t	key_size
+) {
+	ion_byte_t *end = memchr(key, '\0', key_size);
+
+	return NULL == end ? key_size : (ion_key_size_t) (end - (ion_byte_t *) key);
+}
+
+uint64_t
+dictionary_hash_mix64_string(
+	ion_key_t		key,
+	ion_key_size_t	key_size
+) {
+	return dictionary_hash_mix64(key, dictionary_string_key_length(key, key_size));
+}
+
+uint64_t
+dictionary_hash_fnv1a_string(
+	ion_key_t		key,
+	ion_key_size_t	key_size
+) {
+	return dictionary_hash_fnv1a(key, dictionary_string_key_length(key, key_size));
+}
+
+ion_dictionary_hash_t
+dictionary_switch_hash(
+	ion_dictionary_hash_type_t	hash_type,
+	ion_key_type_t				key_type
+) {
+	ion_boolean_t is_string = key_type_null_terminated_string == key_type;
+
+	switch (hash_type) {
+		case dictionary_hash_type_mix64:
+			return is_string ? dictionary_hash_mix64_string : dictionary_hash_mix64;
+
+		case dictionary_hash_type_fnv1a:
+			return is_string ? dictionary_hash_fnv1a_string : dictionary_hash_fnv1a;
+
+		default:
+			return NULL;
+	}
+}
+
+/**
+@brief		Records the hash function a dictionary instance uses.
+@details	Called once the handler has created or opened the instance, and
+			before any record is placed.
+*/
+static void
+dictionary_bind_hash(
+	ion_dictionary_t			*dictionary,
+	ion_dictionary_hash_type_t	hash_type
+) {
+	dictionary->instance->hash_type = hash_type;
+	dictionary->instance->hash		= dictionary_switch_hash(hash_type, dictionary->instance->key_type);
+}
+
 ion_err_t
 dictionary_create(
 	ion_dictionary_handler_t	*handler,
@@ -131,14 +418,28 @@ dictionary_create(
 	ion_value_size_t			value_size,
 	ion_dictionary_size_t		dictionary_size
 ) {
-	ion_err_t					err;
-	ion_dictionary_compare_t	compare = dictionary_switch_compare(key_type);
+	return dictionary_create_with_compare(handler, dictionary, id, key_type, key_size, value_size, dictionary_size, dictionary_switch_compare(key_type, key_size));
+}
+
+ion_err_t
+dictionary_create_with_compare(
+	ion_dictionary_handler_t	*handler,
+	ion_dictionary_t			*dictionary,
+	ion_dictionary_id_t			id,
+	ion_key_type_t				key_type,
+	ion_key_size_t				key_size,
+	ion_value_size_t			value_size,
+	ion_dictionary_size_t		dictionary_size,
+	ion_dictionary_compare_t	compare
+) {
+	ion_err_t err;
 
 	err = handler->create_dictionary(id, key_type, key_size, value_size, dictionary_size, compare, handler, dictionary);
 
 	if (err_ok == err) {
 		dictionary->instance->id	= id;
 		dictionary->status			= ion_dictionary_status_ok;
+		dictionary_bind_hash(dictionary, dictionary_hash_type_builtin);
 	}
 	else {
 		dictionary->status = ion_dictionary_status_error;
@@ -147,6 +448,26 @@ dictionary_create(
 	return err;
 }
 
+ion_err_t
+dictionary_create_with_hash(
+	ion_dictionary_handler_t	*handler,
+	ion_dictionary_t			*dictionary,
+	ion_dictionary_id_t			id,
+	ion_key_type_t				key_type,
+	ion_key_size_t				key_size,
+	ion_value_size_t			value_size,
+	ion_dictionary_size_t		dictionary_size,
+	ion_dictionary_hash_type_t	hash_type
+) {
+	ion_err_t err = dictionary_create(handler, dictionary, id, key_type, key_size, value_size, dictionary_size);
+
+	if (err_ok == err) {
+		dictionary_bind_hash(dictionary, hash_type);
+	}
+
+	return err;
+}
+
 ion_status_t
 dictionary_insert(
 	ion_dictionary_t	*dictionary,
@@ -289,9 +610,21 @@ dictionary_open(
 	ion_dictionary_t				*dictionary,
 	ion_dictionary_config_info_t	*config
 ) {
-	ion_dictionary_compare_t compare	= dictionary_switch_compare(config->type);
+	return dictionary_open_with_compare(handler, dictionary, config, dictionary_switch_compare(config->type, config->key_size));
+}
+
+ion_err_t
+dictionary_open_with_compare(
+	ion_dictionary_handler_t		*handler,
+	ion_dictionary_t				*dictionary,
+	ion_dictionary_config_info_t	*config,
+	ion_dictionary_compare_t		compare
+) {
+	ion_err_t error = handler->open_dictionary(handler, dictionary, config, compare);
 
-	ion_err_t error						= handler->open_dictionary(handler, dictionary, config, compare);
+	if (err_ok == error) {
+		dictionary_bind_hash(dictionary, config->hash_type);
+	}
 
 	if (err_not_implemented == error) {
 		ion_predicate_t				predicate;
@@ -323,12 +656,14 @@ dictionary_open(
 		record.key		= alloca(config->key_size);
 		record.value	= alloca(config->value_size);
 
-		err				= dictionary_create(handler, dictionary, config->id, config->type, config->key_size, config->value_size, config->dictionary_size);
+		err				= dictionary_create_with_compare(handler, dictionary, config->id, config->type, config->key_size, config->value_size, config->dictionary_size, compare);
 
 		if (err_ok != err) {
 			return err;
 		}
 
+		dictionary_bind_hash(dictionary, config->hash_type);
+
 		ion_cursor_status_t cursor_status;
 
 		while (cs_cursor_active == (cursor_status = cursor->next(cursor, &record)) || cs_cursor_initialized == cursor_status) {
@@ -558,6 +893,20 @@ dictionary_build_predicate(
 	return err_ok;
 }
 
+ion_err_t
+dictionary_get_stats(
+	ion_dictionary_t		*dictionary,
+	ion_dictionary_stats_t	*stats
+) {
+	memset(stats, 0, sizeof(ion_dictionary_stats_t));
+
+	if (ion_dictionary_status_closed == dictionary->status) {
+		return err_uninitialized;
+	}
+
+	return dictionary->handler->get_stats(dictionary, stats);
+}
+
 ion_err_t
 dictionary_find(
 	ion_dictionary_t	*dictionary,
@@ -98,6 +98,27 @@ dictionary_create(
 	ion_dictionary_size_t		dictionary_size
 );
 
+/**
+@brief		Creates an instance of a specific type of dictionary that
+			compares keys with @p compare.
+@details	Behaves as @ref dictionary_create, which uses the comparator
+			chosen by @ref dictionary_switch_compare.
+@param		compare
+				The key comparison function the dictionary will use.
+@return		A status describing the result of dictionary creation.
+*/
+ion_err_t
+dictionary_create_with_compare(
+	ion_dictionary_handler_t	*handler,
+	ion_dictionary_t			*dictionary,
+	ion_dictionary_id_t			id,
+	ion_key_type_t				key_type,
+	ion_key_size_t				key_size,
+	ion_value_size_t			value_size,
+	ion_dictionary_size_t		dictionary_size,
+	ion_dictionary_compare_t	compare
+);
+
 /**
 @brief		Insert a value into a dictionary.
 
@@ -250,6 +271,265 @@ dictionary_compare_signed_value(
 	ion_key_size_t	key_size
 );
 
+/**
+@brief		Compares two signed 8-bit integer keys.
+@details	Keys are loaded as native @c int8_t values, so this is equivalent
+			to @ref dictionary_compare_signed_value with a @p key_size of 1.
+@param	  first_key
+				The pointer to the first key in the comparison.
+@param	  second_key
+				The pointer to the second key in the comparison.
+@param	  key_size
+				Unused, the key size is fixed.
+@return		The resulting comparison value.
+*/
+char
+dictionary_compare_int8(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Compares two unsigned 8-bit integer keys.
+@details	Keys are loaded as native @c uint8_t values, so this is equivalent
+			to @ref dictionary_compare_unsigned_value with a @p key_size of 1.
+@param	  first_key
+				The pointer to the first key in the comparison.
+@param	  second_key
+				The pointer to the second key in the comparison.
+@param	  key_size
+				Unused, the key size is fixed.
+@return		The resulting comparison value.
+*/
+char
+dictionary_compare_uint8(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Compares two signed 16-bit integer keys.
+@details	Keys are loaded as native @c int16_t values, so this is equivalent
+			to @ref dictionary_compare_signed_value with a @p key_size of 2.
+@param	  first_key
+				The pointer to the first key in the comparison.
+@param	  second_key
+				The pointer to the second key in the comparison.
+@param	  key_size
+				Unused, the key size is fixed.
+@return		The resulting comparison value.
+*/
+char
+dictionary_compare_int16(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Compares two unsigned 16-bit integer keys.
+@details	Keys are loaded as native @c uint16_t values, so this is equivalent
+			to @ref dictionary_compare_unsigned_value with a @p key_size of 2.
+@param	  first_key
+				The pointer to the first key in the comparison.
+@param	  second_key
+				The pointer to the second key in the comparison.
+@param	  key_size
+				Unused, the key size is fixed.
+@return		The resulting comparison value.
+*/
+char
+dictionary_compare_uint16(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Compares two signed 32-bit integer keys.
+@details	Keys are loaded as native @c int32_t values, so this is equivalent
+			to @ref dictionary_compare_signed_value with a @p key_size of 4.
+@param	  first_key
+				The pointer to the first key in the comparison.
+@param	  second_key
+				The pointer to the second key in the comparison.
+@param	  key_size
+				Unused, the key size is fixed.
+@return		The resulting comparison value.
+*/
+char
+dictionary_compare_int32(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Compares two unsigned 32-bit integer keys.
+@details	Keys are loaded as native @c uint32_t values, so this is equivalent
+			to @ref dictionary_compare_unsigned_value with a @p key_size of 4.
+@param	  first_key
+				The pointer to the first key in the comparison.
+@param	  second_key
+				The pointer to the second key in the comparison.
+@param	  key_size
+				Unused, the key size is fixed.
+@return		The resulting comparison value.
+*/
+char
+dictionary_compare_uint32(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Compares two signed 64-bit integer keys.
+@details	Keys are loaded as native @c int64_t values, so this is equivalent
+			to @ref dictionary_compare_signed_value with a @p key_size of 8.
+@param	  first_key
+				The pointer to the first key in the comparison.
+@param	  second_key
+				The pointer to the second key in the comparison.
+@param	  key_size
+				Unused, the key size is fixed.
+@return		The resulting comparison value.
+*/
+char
+dictionary_compare_int64(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Compares two unsigned 64-bit integer keys.
+@details	Keys are loaded as native @c uint64_t values, so this is equivalent
+			to @ref dictionary_compare_unsigned_value with a @p key_size of 8.
+@param	  first_key
+				The pointer to the first key in the comparison.
+@param	  second_key
+				The pointer to the second key in the comparison.
+@param	  key_size
+				Unused, the key size is fixed.
+@return		The resulting comparison value.
+*/
+char
+dictionary_compare_uint64(
+	ion_key_t		first_key,
+	ion_key_t		second_key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Picks the comparison function for keys of a given type and size.
+@details	Numeric keys of 1, 2, 4 or 8 bytes get a comparator that loads
+			them as native integers. Other numeric sizes use the byte-wise
+			@ref dictionary_compare_signed_value or
+			@ref dictionary_compare_unsigned_value.
+@param		key_type
+				The type of the key.
+@param		key_size
+				The size of the key in bytes.
+@return		The comparison function, or @c NULL for an unknown key type.
+*/
+ion_dictionary_compare_t
+dictionary_switch_compare(
+	ion_key_type_t	key_type,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Hashes a whole key with 64-bit multiply and xor-shift rounds.
+@details	Keys of 1, 2, 4 or 8 bytes are loaded as a single native integer
+			and finalized, so every key bit reaches every hash bit. Longer keys
+			are folded in 8 byte words.
+@param		key
+				The key to hash.
+@param		key_size
+				The size of the key in bytes.
+@return		The hash of the key.
+*/
+uint64_t
+dictionary_hash_mix64(
+	ion_key_t		key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Hashes a whole key with 32-bit FNV-1a.
+@param		key
+				The key to hash.
+@param		key_size
+				The size of the key in bytes.
+@return		The hash of the key.
+*/
+uint64_t
+dictionary_hash_fnv1a(
+	ion_key_t		key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Hashes a null-terminated string key with
+			@ref dictionary_hash_mix64, ignoring anything after the terminator.
+*/
+uint64_t
+dictionary_hash_mix64_string(
+	ion_key_t		key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Hashes a null-terminated string key with
+			@ref dictionary_hash_fnv1a, ignoring anything after the terminator.
+*/
+uint64_t
+dictionary_hash_fnv1a_string(
+	ion_key_t		key,
+	ion_key_size_t	key_size
+);
+
+/**
+@brief		Picks the hash function for a hash type and key type.
+@details	Null-terminated string keys get a variant that stops at the
+			terminator, since they compare equal whatever follows it.
+@param		hash_type
+				The hash function wanted.
+@param		key_type
+				The type of the key.
+@return		The hash function, or @c NULL for @ref dictionary_hash_type_builtin.
+*/
+ion_dictionary_hash_t
+dictionary_switch_hash(
+	ion_dictionary_hash_type_t	hash_type,
+	ion_key_type_t				key_type
+);
+
+/**
+@brief		Creates an instance of a specific type of dictionary that
+			places keys with the hash function @p hash_type.
+@details	Behaves as @ref dictionary_create, which leaves each
+			implementation to its own hash. Dictionaries that do not hash keys
+			ignore @p hash_type.
+@param		hash_type
+				The key hash function the dictionary will use.
+@return		A status describing the result of dictionary creation.
+*/
+ion_err_t
+dictionary_create_with_hash(
+	ion_dictionary_handler_t	*handler,
+	ion_dictionary_t			*dictionary,
+	ion_dictionary_id_t			id,
+	ion_key_type_t				key_type,
+	ion_key_size_t				key_size,
+	ion_value_size_t			value_size,
+	ion_dictionary_size_t		dictionary_size,
+	ion_dictionary_hash_type_t	hash_type
+);
+
 /**
 @brief		Opens a dictionary, given the desired config.
 @param		handler
@@ -268,6 +548,24 @@ dictionary_open(
 	ion_dictionary_config_info_t	*config
 );
 
+/**
+@brief		Opens a dictionary that compares keys with @p compare.
+@details	Behaves as @ref dictionary_open, which uses the comparator
+			chosen by @ref dictionary_switch_compare. A dictionary that keeps
+			its keys in order has to be opened with the comparator it was
+			created with.
+@param		compare
+				The key comparison function the dictionary will use.
+@returns	An error describing the result of open operation.
+*/
+ion_err_t
+dictionary_open_with_compare(
+	ion_dictionary_handler_t		*handler,
+	ion_dictionary_t				*dictionary,
+	ion_dictionary_config_info_t	*config,
+	ion_dictionary_compare_t		compare
+);
+
 /**
 @brief		Closes a dictionary.
 @param		dictionary
@@ -279,6 +577,23 @@ dictionary_close(
 	ion_dictionary_t *dictionary
 );
 
+/**
+@brief		Retrieves the performance counters of an open dictionary.
+@details	The counters belong to the dictionary instance, so several open
+			dictionaries of the same implementation are reported separately.
+@param		dictionary
+				A pointer to the dictionary object to be queried.
+@param		stats
+				A pointer to the caller allocated statistics to fill in. Any
+				counter not tracked by the implementation is set to zero.
+@returns	An error describing the result of the operation.
+*/
+ion_err_t
+dictionary_get_stats(
+	ion_dictionary_t		*dictionary,
+	ion_dictionary_stats_t	*stats
+);
+
 /**
 @brief		Builds a predicate based on the type given.
 @details	The caller is responsible for allocating the memory needed
@@ -86,6 +86,36 @@ typedef char (*ion_dictionary_compare_t)(
 	ion_key_size_t
 );
 
+/**
+@brief		The key hash functions a hash-based dictionary can be created with.
+@details	The choice is stored in the master table, since records are placed
+			by it and a dictionary has to be reopened with the same one.
+*/
+enum ION_DICTIONARY_HASH {
+	/**> The implementation's own hash. Dictionaries created before a hash
+		 could be chosen use this. */
+	dictionary_hash_type_builtin,
+	/**> A 64-bit multiply and xor-shift hash over the whole key, with fast
+		 paths for 1, 2, 4 and 8 byte keys. */
+	dictionary_hash_type_mix64,
+	/**> 32-bit FNV-1a over the whole key. It needs no 64-bit multiplies, so
+		 it is the cheaper choice on 8-bit targets. */
+	dictionary_hash_type_fnv1a,
+};
+
+/**
+@brief		A type for storing which key hash function a dictionary uses.
+*/
+typedef char ion_dictionary_hash_type_t;
+
+/**
+@brief	Function pointer type for key hash functions.
+*/
+typedef uint64_t (*ion_dictionary_hash_t)(
+	ion_key_t,
+	ion_key_size_t
+);
+
 /**
 @brief		The dictionary cursor type.
 @see		dictionary_cursor
@@ -197,8 +227,41 @@ typedef struct {
 													 implementation used. */
 	ion_dictionary_status_t dictionary_status;	/**< The current status of the
 													dictionary, either closed or ok. */
+	ion_dictionary_hash_type_t	hash_type;	/**< The key hash function the
+													dictionary was created with. */
 } ion_dictionary_config_info_t;
 
+/**
+@brief		Performance counters kept by each open dictionary instance.
+@details	Every implementation reports through the same structure. Counters
+			that do not apply to an implementation are left at zero. The cache
+			hit ratio is @c cache_hits / (@c cache_hits + @c cache_misses), and
+			the mean probe length @c num_probes / @c num_lookups.
+*/
+typedef struct {
+	unsigned long	num_reads;		/**< Number of reads issued to storage. */
+	unsigned long	num_writes;		/**< Number of writes issued to storage. */
+	unsigned long	bytes_read;		/**< Number of bytes read from storage. */
+	unsigned long	bytes_written;	/**< Number of bytes written to storage. */
+	unsigned long	cache_hits;		/**< Requests served from an in-memory
+										 buffer or cache. */
+	unsigned long	cache_misses;	/**< Requests that had to go to storage. */
+	unsigned long	num_splits;		/**< Number of node or bucket splits. */
+	unsigned long	num_merges;		/**< Number of node or bucket merges. */
+	unsigned long	num_inserts;	/**< Number of records inserted. */
+	unsigned long	num_deletes;	/**< Number of records deleted. */
+	unsigned int	height;			/**< Maximum height reached by the
+										 structure, if it has one. */
+	unsigned long	num_lookups;	/**< Number of key searches, where the
+										 structure is searched by key. */
+	unsigned long	num_probes;		/**< Slots or nodes examined by those
+										 searches. */
+	unsigned int	max_displacement;	/**< Farthest a record has been placed
+											 from its home slot. */
+	unsigned long	num_records;	/**< Records held, where the
+										 implementation keeps count. */
+} ion_dictionary_stats_t;
+
 /**
 @brief		A dictionary_handler is responsible for dealing with the specific
 			interface for an underlying dictionary, but is decoupled from a
@@ -264,6 +327,11 @@ struct dictionary_handler {
 		ion_dictionary_t *
 	);
 	/**< A pointer to the dictionaries close function */
+	ion_err_t (*get_stats)(
+		ion_dictionary_t *,
+		ion_dictionary_stats_t *
+	);
+	/**< A pointer to the dictionaries statistics function */
 };
 
 /**
@@ -289,6 +357,11 @@ struct dictionary_parent {
 											  instance of map. */
 	ion_dictionary_id_t			id;		/**< ID of dictionary instance. */
 	ion_dictionary_type_t		type;	/**< Type of dictionary implementation used. */
+	ion_dictionary_hash_type_t	hash_type;	/**< Key hash function chosen for
+											  the instance. */
+	ion_dictionary_hash_t		hash;	/**< The function for @c hash_type, or
+											 @c NULL for the implementation's
+											 own hash. */
 };
 
 /**
@@ -64,6 +64,7 @@ flat_file_initialize(
 	flat_file->sorted_mode				= boolean_false;/* By default, we don't use sorted mode */
 	flat_file->num_buffered				= dictionary_size;
 	flat_file->current_loaded_region	= -1;	/* No loaded region yet */
+	memset(&flat_file->stats, 0, sizeof(flat_file->stats));
 
 	flat_file->data_file				= fopen(filename, "r+b");
 
@@ -205,6 +206,9 @@ flat_file_scan(
 				return err_file_read_error;
 			}
 
+			flat_file->stats.num_reads++;
+			flat_file->stats.bytes_read += num_records_to_process * flat_file->row_size;
+
 			if (-1 == (cur_offset = ftell(flat_file->data_file))) {
 				return err_file_read_error;
 			}
@@ -227,6 +231,9 @@ flat_file_scan(
 				return err_file_read_error;
 			}
 
+			flat_file->stats.num_reads++;
+			flat_file->stats.bytes_read += num_records_to_process * flat_file->row_size;
+
 			/* In this case, the prev_offset is actually the cur_offset. */
 			prev_offset = cur_offset;
 		}
@@ -284,7 +291,12 @@ flat_file_predicate_key_match(
 ) {
 	ion_key_t target_key = va_arg(*args, ion_key_t);
 
-	return ION_FLAT_FILE_STATUS_OCCUPIED == row->row_status && 0 == flat_file->super.compare(target_key, row->key, flat_file->super.record.key_size);
+	if (ION_FLAT_FILE_STATUS_OCCUPIED != row->row_status) {
+		return boolean_false;
+	}
+
+	flat_file->stats.num_probes++;
+	return 0 == flat_file->super.compare(target_key, row->key, flat_file->super.record.key_size);
 }
 
 ion_boolean_t
@@ -343,6 +355,9 @@ flat_file_write_row(
 		return err_file_write_error;
 	}
 
+	flat_file->stats.num_writes++;
+	flat_file->stats.bytes_written += sizeof(row->row_status) + (NULL != row->key ? flat_file->super.record.key_size : 0) + (NULL != row->value ? flat_file->super.record.value_size : 0);
+
 	return err_ok;
 }
 
@@ -357,6 +372,7 @@ flat_file_read_row(
 	if ((flat_file->current_loaded_region != -1) && (location >= flat_file->current_loaded_region) && ((unsigned) location < flat_file->current_loaded_region + flat_file->num_in_buffer)) {
 		/* Cache hit, return directly from buffer */
 		read_index = location - flat_file->current_loaded_region;
+		flat_file->stats.cache_hits++;
 	}
 	else {
 		/* Cache miss, have to re-read from file */
@@ -375,6 +391,13 @@ flat_file_read_row(
 		if (1 != fread(flat_file->buffer + sizeof(row->row_status) + flat_file->super.record.key_size, flat_file->super.record.value_size, 1, flat_file->data_file)) {
 			return err_file_write_error;
 		}
+
+		/* The row took the place of the first one in the buffer */
+		flat_file->current_loaded_region	= location;
+		flat_file->num_in_buffer			= 1;
+		flat_file->stats.cache_misses++;
+		flat_file->stats.num_reads++;
+		flat_file->stats.bytes_read			+= flat_file->row_size;
 	}
 
 	row->row_status = *((ion_flat_file_row_status_t *) &flat_file->buffer[read_index * flat_file->row_size]);
@@ -430,6 +453,7 @@ flat_file_insert(
 		return status;
 	}
 
+	flat_file->stats.num_inserts++;
 	status.error	= err_ok;
 	status.count	= 1;
 	return status;
@@ -446,6 +470,8 @@ flat_file_get(
 	ion_fpos_t			found_loc	= -1;
 	ion_flat_file_row_t row;
 
+	flat_file->stats.num_lookups++;
+
 	if (!flat_file->sorted_mode) {
 		err = flat_file_scan(flat_file, -1, &found_loc, &row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_key_match, key);
 
@@ -505,6 +531,8 @@ flat_file_delete(
 	ion_err_t			err;
 	ion_fpos_t			loc		= -1;
 
+	flat_file->stats.num_lookups++;
+
 	while (err_ok == (err = flat_file_scan(flat_file, loc, &loc, &row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_key_match, key))) {
 		ion_fpos_t			last_record_offset	= flat_file->eof_position - flat_file->row_size;
 		ion_flat_file_row_t last_row;
@@ -539,6 +567,7 @@ flat_file_delete(
 		/* Soft truncate the file by bumping the eof position back to cut off the last record. */
 		flat_file->eof_position = last_record_offset;
 		status.count++;
+		flat_file->stats.num_deletes++;
 
 		/* No location movement is done here, since we need to check the row we just swapped in to see if it is
 		   also a match. */
@@ -568,6 +597,8 @@ flat_file_update(
 	ion_flat_file_row_t row;
 	ion_err_t			err;
 
+	flat_file->stats.num_lookups++;
+
 	if (flat_file->sorted_mode) {
 		err = flat_file_binary_search(flat_file, key, &loc);
 
@@ -634,75 +665,167 @@ flat_file_close(
 	return err_ok;
 }
 
-ion_err_t
-flat_file_binary_search(
+/**
+@brief		Loads @p num_rows rows, starting at row @p first, into the buffer.
+@details	Nothing is read if the rows are already loaded.
+*/
+static ion_err_t
+flat_file_read_region(
 	ion_flat_file_t *flat_file,
-	ion_key_t		target_key,
-	ion_fpos_t		*location
+	ion_fpos_t		first,
+	size_t			num_rows
 ) {
-	if (!flat_file->sorted_mode) {
-		return err_sorted_order_violation;
+	if ((-1 != flat_file->current_loaded_region) && (first >= flat_file->current_loaded_region) && (first + num_rows <= flat_file->current_loaded_region + flat_file->num_in_buffer)) {
+		flat_file->stats.cache_hits++;
+		return err_ok;
 	}
 
-	ion_err_t			err;
-	ion_flat_file_row_t row;
-	ion_fpos_t			low_idx		= 0;
-	ion_fpos_t			high_idx	= (flat_file->eof_position - flat_file->start_of_data) / flat_file->row_size - 1;
-	ion_fpos_t			mid_idx;
+	flat_file->current_loaded_region	= -1;
+	flat_file->num_in_buffer			= 0;
 
-	if (high_idx < 0) {
-		/* We're empty, short circuit */
-		*location = -1;
-		return err_item_not_found;
+	if (0 != fseek(flat_file->data_file, flat_file->start_of_data + first * flat_file->row_size, SEEK_SET)) {
+		return err_file_bad_seek;
+	}
+
+	if (num_rows != fread(flat_file->buffer, flat_file->row_size, num_rows, flat_file->data_file)) {
+		return err_file_read_error;
 	}
 
-	while (low_idx < high_idx) {
-		mid_idx = low_idx + (high_idx - low_idx) / 2;
-		err		= flat_file_read_row(flat_file, mid_idx, &row);
+	flat_file->current_loaded_region	= first;
+	flat_file->num_in_buffer			= num_rows;
+	flat_file->stats.cache_misses++;
+	flat_file->stats.num_reads++;
+	flat_file->stats.bytes_read			+= num_rows * flat_file->row_size;
+
+	return err_ok;
+}
+
+/**
+@brief		Returns the key of row @p location, which has to be in the buffer.
+*/
+static ion_key_t
+flat_file_buffered_key(
+	ion_flat_file_t *flat_file,
+	ion_fpos_t		location
+) {
+	return &flat_file->buffer[(location - flat_file->current_loaded_region) * flat_file->row_size + sizeof(ion_flat_file_row_status_t)];
+}
+
+/**
+@brief		Compares the key of row @p location, which has to be in the
+			buffer, with @p target_key, counting the probe.
+*/
+static int
+flat_file_probe(
+	ion_flat_file_t *flat_file,
+	ion_fpos_t		location,
+	ion_key_t		target_key
+) {
+	flat_file->stats.num_probes++;
+	return flat_file->super.compare(flat_file_buffered_key(flat_file, location), target_key, flat_file->super.record.key_size);
+}
+
+/**
+@brief		Finds the first row whose key is not less than @p target_key, in
+			a flat file in sorted mode.
+@details	Each probe reads a block of @p num_buffered rows from the middle
+			of the rows left. A block whose first key is not less than the
+			target discards it and everything after it, and one whose last
+			key is less discards it and everything before. Otherwise the row
+			is in the block, and the search finishes in the buffer. The rows
+			left shrink by more than half per read, and once they fit in the
+			buffer they are read together.
+@param[out]	location
+				The row found, or the number of rows if every key is less.
+*/
+static ion_err_t
+flat_file_lower_bound(
+	ion_flat_file_t *flat_file,
+	ion_key_t		target_key,
+	ion_fpos_t		*location
+) {
+	ion_fpos_t		low			= 0;
+	ion_fpos_t		high		= (flat_file->eof_position - flat_file->start_of_data) / flat_file->row_size;
+	ion_fpos_t		start;
+	ion_fpos_t		last;
+	ion_fpos_t		mid;
+	size_t			num_rows;
+	ion_err_t		err;
+
+	while (low < high) {
+		num_rows	= (size_t) (high - low) > (size_t) flat_file->num_buffered ? (size_t) flat_file->num_buffered : (size_t) (high - low);
+		start		= low + (high - low - num_rows) / 2;
+		last		= start + num_rows - 1;
+		err			= flat_file_read_region(flat_file, start, num_rows);
 
 		if (err_ok != err) {
 			return err;
 		}
 
-		char comp_result = flat_file->super.compare(target_key, row.key, flat_file->super.record.key_size);
-
-		if (comp_result > 0) {
-			low_idx = mid_idx + 1;
+		if (flat_file_probe(flat_file, start, target_key) >= 0) {
+			high = start;
 		}
-		else if (comp_result < 0) {
-			high_idx = mid_idx - 1;
+		else if (flat_file_probe(flat_file, last, target_key) < 0) {
+			low = last + 1;
 		}
 		else {
-			/* Match found, scroll to beginning of (potential) duplicate block and return */
-			ion_fpos_t	last_dup_idx;
-			ion_fpos_t	dup_idx = mid_idx;
+			/* The row is in (start, last] */
+			low		= start + 1;
+			high	= last;
 
-			do {
-				last_dup_idx	= dup_idx;
-				dup_idx--;
-				err				= flat_file_read_row(flat_file, dup_idx, &row);
+			while (low < high) {
+				mid = low + (high - low) / 2;
 
-				if (err_ok != err) {
-					return err;
+				if (flat_file_probe(flat_file, mid, target_key) < 0) {
+					low = mid + 1;
 				}
-			} while (dup_idx >= 0 && 0 == flat_file->super.compare(row.key, target_key, flat_file->super.record.key_size));
-
-			*location = last_dup_idx;
-			return err_ok;
+				else {
+					high = mid;
+				}
+			}
 		}
 	}
 
-	/* If we reach here, then we fell through the loop - do check and adjust for LEQ as necessary */
-	err = flat_file_read_row(flat_file, low_idx, &row);
+	*location = low;
+	return err_ok;
+}
+
+ion_err_t
+flat_file_binary_search(
+	ion_flat_file_t *flat_file,
+	ion_key_t		target_key,
+	ion_fpos_t		*location
+) {
+	if (!flat_file->sorted_mode) {
+		return err_sorted_order_violation;
+	}
+
+	ion_err_t			err;
+	ion_flat_file_row_t row;
+	ion_fpos_t			num_rows = (flat_file->eof_position - flat_file->start_of_data) / flat_file->row_size;
+	ion_fpos_t			found_idx;
+
+	err = flat_file_lower_bound(flat_file, target_key, &found_idx);
 
 	if (err_ok != err) {
 		return err;
 	}
 
-	if (flat_file->super.compare(row.key, target_key, flat_file->super.record.key_size) > 0) {
-		low_idx--;
+	/* The first of a block of duplicates, if the key is there */
+	if (found_idx < num_rows) {
+		err = flat_file_read_row(flat_file, found_idx, &row);
+
+		if (err_ok != err) {
+			return err;
+		}
+
+		if (0 == flat_file->super.compare(row.key, target_key, flat_file->super.record.key_size)) {
+			*location = found_idx;
+			return err_ok;
+		}
 	}
 
-	*location = low_idx;
-	return low_idx >= 0 ? err_ok : err_item_not_found;
+	/* Otherwise the last key before it */
+	*location = found_idx - 1;
+	return found_idx > 0 ? err_ok : err_item_not_found;
 }
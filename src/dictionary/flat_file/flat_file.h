@@ -285,6 +285,10 @@ flat_file_read_row(
 			the returned index points to the first key in a contiguous block of duplicate keys. If
 			no key in the flat file satisfies the condition of being less-than-or-equal, then @p -1
 			is written back to @p location. This function will only return records that are not deleted.
+
+			The search reads blocks of @p num_buffered rows at a time, which narrow the rows left by
+			more than half each, and finishes inside the block that holds the key. The block stays
+			loaded, so reading rows near @p location afterwards is served from the buffer.
 @param[in]		flat_file
 				Which flat file instance to search within.
 @param[in]		target_key
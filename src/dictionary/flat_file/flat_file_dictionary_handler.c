@@ -70,12 +70,34 @@ ffdict_next(
 
 			switch (cursor->predicate->type) {
 				case predicate_equality: {
+					if (flat_file->sorted_mode) {
+						/* In key order the results end at the first row with another key */
+						err = flat_file_scan(flat_file, flat_file_cursor->current_location + 1, &flat_file_cursor->current_location, &throwaway_row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_not_empty);
+
+						if ((err_ok == err) && (0 != flat_file->super.compare(throwaway_row.key, cursor->predicate->statement.equality.equality_value, flat_file->super.record.key_size))) {
+							err = err_file_hit_eof;
+						}
+
+						break;
+					}
+
 					err = flat_file_scan(flat_file, flat_file_cursor->current_location + 1, &flat_file_cursor->current_location, &throwaway_row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_key_match, cursor->predicate->statement.equality.equality_value);
 
 					break;
 				}
 
 				case predicate_range: {
+					if (flat_file->sorted_mode) {
+						/* In key order the results end at the first row past the upper bound */
+						err = flat_file_scan(flat_file, flat_file_cursor->current_location + 1, &flat_file_cursor->current_location, &throwaway_row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_not_empty);
+
+						if ((err_ok == err) && (flat_file->super.compare(throwaway_row.key, cursor->predicate->statement.range.upper_bound, flat_file->super.record.key_size) > 0)) {
+							err = err_file_hit_eof;
+						}
+
+						break;
+					}
+
 					err = flat_file_scan(flat_file, flat_file_cursor->current_location + 1, &flat_file_cursor->current_location, &throwaway_row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_within_bounds, cursor->predicate->statement.range.lower_bound, cursor->predicate->statement.range.upper_bound);
 
 					break;
@@ -123,6 +145,57 @@ ffdict_next(
 	return cs_invalid_cursor;
 }
 
+/**
+@brief		Finds the first row of a flat file in sorted mode whose key is
+			within [@p lower_bound, @p upper_bound], by binary search.
+@param[out]	location
+				The row found.
+@return		err_ok, err_file_hit_eof if no key is within the bounds, or the
+			error of a read.
+*/
+static ion_err_t
+flat_file_sorted_start(
+	ion_flat_file_t *flat_file,
+	ion_key_t		lower_bound,
+	ion_key_t		upper_bound,
+	ion_fpos_t		*location
+) {
+	ion_key_size_t		key_size	= flat_file->super.record.key_size;
+	ion_fpos_t			num_rows	= (flat_file->eof_position - flat_file->start_of_data) / flat_file->row_size;
+	ion_flat_file_row_t row;
+	ion_err_t			err			= flat_file_binary_search(flat_file, lower_bound, location);
+
+	if (err_item_not_found == err) {
+		/* Every key is past the lower bound */
+		*location	= 0;
+		err			= err_ok;
+	}
+	else if (err_ok == err) {
+		err = flat_file_read_row(flat_file, *location, &row);
+
+		/* Without the bound itself, the search stops on the last key below it */
+		if ((err_ok == err) && (flat_file->super.compare(row.key, lower_bound, key_size) < 0)) {
+			++*location;
+		}
+	}
+
+	if (err_ok != err) {
+		return err;
+	}
+
+	if (*location >= num_rows) {
+		return err_file_hit_eof;
+	}
+
+	err = flat_file_read_row(flat_file, *location, &row);
+
+	if ((err_ok == err) && (flat_file->super.compare(row.key, upper_bound, key_size) > 0)) {
+		err = err_file_hit_eof;
+	}
+
+	return err;
+}
+
 /**
 @brief		Destroys and frees the given cursor.
 @details	This function should not be called directly, but instead accessed through the interface
@@ -253,7 +326,14 @@ ffdict_find(
 
 			ion_fpos_t			loc			= -1;
 			ion_flat_file_row_t row;
-			ion_err_t			scan_result = flat_file_scan(flat_file, -1, &loc, &row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_key_match, target_key);
+			ion_err_t			scan_result;
+
+			if (flat_file->sorted_mode) {
+				scan_result = flat_file_sorted_start(flat_file, target_key, target_key, &loc);
+			}
+			else {
+				scan_result = flat_file_scan(flat_file, -1, &loc, &row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_key_match, target_key);
+			}
 
 			if (err_file_hit_eof == scan_result) {
 				/* If this happens, that means the target key doesn't exist */
@@ -301,7 +381,14 @@ ffdict_find(
 			/* Find the first satisfactory key. */
 			ion_fpos_t			loc			= -1;
 			ion_flat_file_row_t row;
-			ion_err_t			scan_result = flat_file_scan(flat_file, -1, &loc, &row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_within_bounds, (*cursor)->predicate->statement.range.lower_bound, (*cursor)->predicate->statement.range.upper_bound);
+			ion_err_t			scan_result;
+
+			if (flat_file->sorted_mode) {
+				scan_result = flat_file_sorted_start(flat_file, (*cursor)->predicate->statement.range.lower_bound, (*cursor)->predicate->statement.range.upper_bound, &loc);
+			}
+			else {
+				scan_result = flat_file_scan(flat_file, -1, &loc, &row, ION_FLAT_FILE_SCAN_FORWARDS, flat_file_predicate_within_bounds, (*cursor)->predicate->statement.range.lower_bound, (*cursor)->predicate->statement.range.upper_bound);
+			}
 
 			if (err_file_hit_eof == scan_result) {
 				/* This means the returned node is smaller than the lower bound, which means that there are no valid records to return */
@@ -360,6 +447,28 @@ ffdict_find(
 	return err_ok;
 }
 
+/**
+@brief			Reports the performance counters of a flat file instance.
+
+@param			dictionary
+					A pointer to the specific dictionary instance to report on.
+@param			stats
+					The statistics to fill in.
+
+@return			The status of retrieving the statistics.
+ */
+ion_err_t
+ffdict_get_stats(
+	ion_dictionary_t		*dictionary,
+	ion_dictionary_stats_t	*stats
+) {
+	ion_flat_file_t *flat_file = (ion_flat_file_t *) dictionary->instance;
+
+	*stats				= flat_file->stats;
+	stats->num_records	= (flat_file->eof_position - flat_file->start_of_data) / flat_file->row_size;
+	return err_ok;
+}
+
 void
 ffdict_init(
 	ion_dictionary_handler_t *handler
@@ -374,6 +483,7 @@ ffdict_init(
 	handler->destroy_dictionary = ffdict_destroy_dictionary;
 	handler->open_dictionary	= ffdict_open_dictionary;
 	handler->close_dictionary	= ffdict_close_dictionary;
+	handler->get_stats			= ffdict_get_stats;
 }
 
 ion_status_t
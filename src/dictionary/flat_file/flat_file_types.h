@@ -99,6 +99,8 @@ typedef struct {
 	ion_fpos_t	current_loaded_region;
 	/**> Expresses how many valid records are currently in the buffer. */
 	size_t		num_in_buffer;
+	/**> Performance counters. */
+	ion_dictionary_stats_t stats;
 } ion_flat_file_t;
 
 /**
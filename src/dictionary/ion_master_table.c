@@ -92,6 +92,10 @@ ion_master_table_write(
 		return err_file_write_error;
 	}
 
+	if (1 != fwrite(&(config->hash_type), sizeof(config->hash_type), 1, ion_master_table_file)) {
+		return err_file_write_error;
+	}
+
 	if (0 != fseek(ion_master_table_file, old_pos, SEEK_SET)) {
 		return err_file_bad_seek;
 	}
@@ -161,6 +165,10 @@ ion_master_table_read(
 		return err_file_read_error;
 	}
 
+	if (1 != fread(&(config->hash_type), sizeof(config->hash_type), 1, ion_master_table_file)) {
+		return err_file_read_error;
+	}
+
 	if (0 != fseek(ion_master_table_file, old_pos, SEEK_SET)) {
 		return err_file_bad_seek;
 	}
@@ -172,17 +180,23 @@ ion_master_table_read(
 	return err_ok;
 }
 
+/* Writes the master row, which holds the next ID and the format version. */
+static ion_err_t
+ion_master_table_write_master_row(
+	ion_dictionary_id_t next_id
+) {
+	ion_dictionary_config_info_t master_config = { .id = next_id, .dictionary_size = ION_MASTER_TABLE_FORMAT_VERSION };
+
+	return ion_master_table_write(&master_config, 0);
+}
+
 /* Returns the next dictionary ID, then increments. */
 ion_err_t
 ion_master_table_get_next_id(
 	ion_dictionary_id_t *id
 ) {
-	ion_err_t error								= err_ok;
-
 	/* Flush master row. This writes the next ID to be used, so add 1. */
-	ion_dictionary_config_info_t master_config	= { .id = ion_master_table_next_id + 1 };
-
-	error = ion_master_table_write(&master_config, 0);
+	ion_err_t error = ion_master_table_write_master_row(ion_master_table_next_id + 1);
 
 	if (err_ok != error) {
 		return error;
@@ -218,9 +232,7 @@ ion_init_master_table(
 		ion_master_table_next_id = 1;
 
 		/* Write master row. */
-		ion_dictionary_config_info_t master_config = { .id = ion_master_table_next_id };
-
-		if (err_ok != (error = ion_master_table_write(&master_config, 0))) {
+		if (err_ok != (error = ion_master_table_write_master_row(ion_master_table_next_id))) {
 			return error;
 		}
 	}
@@ -234,6 +246,13 @@ ion_init_master_table(
 			return err_file_read_error;
 		}
 
+		/* Records of another layout would be misread, so the table is not used at all. */
+		if (ION_MASTER_TABLE_FORMAT_VERSION != master_config.dictionary_size) {
+			fclose(ion_master_table_file);
+			ion_master_table_file = NULL;
+			return err_file_read_error;
+		}
+
 		ion_master_table_next_id = master_config.id;
 	}
 
@@ -340,7 +359,7 @@ ion_add_to_master_table(
 	ion_dictionary_size_t	dictionary_size
 ) {
 	ion_dictionary_config_info_t config = {
-		.id = dictionary->instance->id, .use_type = 0, .type = dictionary->instance->key_type, .key_size = dictionary->instance->record.key_size, .value_size = dictionary->instance->record.value_size, .dictionary_size = dictionary_size, .dictionary_type = dictionary->instance->type, .dictionary_status = dictionary->status
+		.id = dictionary->instance->id, .use_type = 0, .type = dictionary->instance->key_type, .key_size = dictionary->instance->record.key_size, .value_size = dictionary->instance->record.value_size, .dictionary_size = dictionary_size, .dictionary_type = dictionary->instance->type, .dictionary_status = dictionary->status, .hash_type = dictionary->instance->hash_type
 	};
 
 	return ion_master_table_write(&config, ION_MASTER_TABLE_WRITE_FROM_END);
@@ -354,6 +373,19 @@ ion_master_table_create_dictionary(
 	ion_key_size_t				key_size,
 	ion_value_size_t			value_size,
 	ion_dictionary_size_t		dictionary_size
+) {
+	return ion_master_table_create_dictionary_with_hash(handler, dictionary, key_type, key_size, value_size, dictionary_size, dictionary_hash_type_builtin);
+}
+
+ion_err_t
+ion_master_table_create_dictionary_with_hash(
+	ion_dictionary_handler_t	*handler,
+	ion_dictionary_t			*dictionary,
+	ion_key_type_t				key_type,
+	ion_key_size_t				key_size,
+	ion_value_size_t			value_size,
+	ion_dictionary_size_t		dictionary_size,
+	ion_dictionary_hash_type_t	hash_type
 ) {
 	ion_err_t			err;
 	ion_dictionary_id_t id;
@@ -364,7 +396,7 @@ ion_master_table_create_dictionary(
 		return err;
 	}
 
-	err = dictionary_create(handler, dictionary, id, key_type, key_size, value_size, dictionary_size);
+	err = dictionary_create_with_hash(handler, dictionary, id, key_type, key_size, value_size, dictionary_size, hash_type);
 
 	if (err_ok != err) {
 		return err;
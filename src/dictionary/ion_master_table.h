@@ -63,7 +63,7 @@ extern "C" {
 
 #define ION_MASTER_TABLE_CALCULATE_POS	-1
 #define ION_MASTER_TABLE_WRITE_FROM_END -2
-#define ION_MASTER_TABLE_RECORD_SIZE(cp) (sizeof((cp)->id) + sizeof((cp)->use_type) + sizeof((cp)->type) + sizeof((cp)->key_size) + sizeof((cp)->value_size) + sizeof((cp)->dictionary_size) + sizeof((cp)->dictionary_type) + sizeof((cp)->dictionary_status))
+#define ION_MASTER_TABLE_RECORD_SIZE(cp) (sizeof((cp)->id) + sizeof((cp)->use_type) + sizeof((cp)->type) + sizeof((cp)->key_size) + sizeof((cp)->value_size) + sizeof((cp)->dictionary_size) + sizeof((cp)->dictionary_type) + sizeof((cp)->dictionary_status) + sizeof((cp)->hash_type))
 
 #if ION_USING_MASTER_TABLE
 
@@ -78,6 +78,14 @@ extern "C" {
 */
 #define ION_MASTER_TABLE_ID			0
 
+/**
+@brief		Version of the master table's record layout.
+@details	Kept in the @c dictionary_size field of the master row, which
+			that row otherwise leaves unused. Tables written before records
+			held a hash type have 0 there, and are refused on open.
+*/
+#define ION_MASTER_TABLE_FORMAT_VERSION 1
+
 /**
 @brief		Flag used when searching master table; search for first instance
 			matching criteria.
@@ -125,7 +133,9 @@ ion_master_table_write(
 
 /**
 @brief	  Opens the master table.
-@details	Can be safely called multiple times without closing.
+@details	Can be safely called multiple times without closing. A table
+			of another @ref ION_MASTER_TABLE_FORMAT_VERSION is left closed
+			and @c err_file_read_error is returned.
 */
 ion_err_t
 ion_init_master_table(
@@ -189,6 +199,26 @@ ion_master_table_create_dictionary(
 	ion_dictionary_size_t		dictionary_size
 );
 
+/**
+@brief		Creates a dictionary through use of the master table, placing
+			keys with the hash function @p hash_type.
+@details	Behaves as @ref ion_master_table_create_dictionary. The hash type
+			is kept in the master table so the dictionary is reopened with it.
+@param		hash_type
+				The key hash function the dictionary will use.
+@returns	An error code describing the result of the operation.
+*/
+ion_err_t
+ion_master_table_create_dictionary_with_hash(
+	ion_dictionary_handler_t	*handler,
+	ion_dictionary_t			*dictionary,
+	ion_key_type_t				key_type,
+	ion_key_size_t				key_size,
+	ion_value_size_t			value_size,
+	ion_dictionary_size_t		dictionary_size,
+	ion_dictionary_hash_type_t	hash_type
+);
+
 /**
 @brief		Looks up the config of the given id.
 @param		id
@@ -62,6 +62,8 @@ linear_hash_init(
 	linear_hash->super.id					= id;
 	linear_hash->dictionary_size			= dictionary_size;
 	linear_hash->super.key_type				= key_type;
+	linear_hash->super.hash_type			= dictionary_hash_type_builtin;
+	linear_hash->super.hash					= NULL;
 	linear_hash->super.record.key_size		= key_size;
 	linear_hash->super.record.value_size	= value_size;
 
@@ -74,6 +76,10 @@ linear_hash_init(
 	linear_hash->records_per_bucket			= records_per_bucket;
 	linear_hash->record_total_size			= key_size + value_size + sizeof(ion_byte_t);
 	linear_hash->cache						= malloc(128);
+	linear_hash->free_list					= linear_hash_end_of_list;
+	linear_hash->split_work					= LINEAR_HASH_DEFAULT_SPLIT_WORK;
+	linear_hash->split_in_progress			= boolean_false;
+	linear_hash->split_remainder			= linear_hash_end_of_list;
 
 	char data_filename[ION_MAX_FILENAME_LENGTH];
 
@@ -103,10 +109,26 @@ linear_hash_init(
 	}
 
 	linear_hash->bucket_map = bucket_map;
-	linear_hash->database	= fopen(data_filename, "r+b");
 
-	if (NULL == linear_hash->database) {
-		linear_hash->database = fopen(data_filename, "w+b");
+	memset(&linear_hash->stats, 0, sizeof(linear_hash->stats));
+	err = linear_hash_cache_init(LINEAR_HASH_DEFAULT_CACHE_SIZE, linear_hash);
+
+	if (err != err_ok) {
+		return err;
+	}
+
+	linear_hash->database = fopen(data_filename, "r+b");
+
+	if (NULL != linear_hash->database) {
+		if (0 != fseek(linear_hash->database, 0, SEEK_END)) {
+			return err_file_bad_seek;
+		}
+
+		linear_hash->database_size = ftell(linear_hash->database);
+	}
+	else {
+		linear_hash->database		= fopen(data_filename, "w+b");
+		linear_hash->database_size	= 0;
 
 		if (NULL == linear_hash->database) {
 			return err_file_open_error;
@@ -168,6 +190,10 @@ ion_err_t
 linear_hash_write_state(
 	linear_hash_table_t *linear_hash
 ) {
+	if (0 != fseek(linear_hash->state, 0, SEEK_SET)) {
+		return err_file_bad_seek;
+	}
+
 	if (1 != fwrite(&linear_hash->initial_size, sizeof(linear_hash->initial_size), 1, linear_hash->state)) {
 		return err_file_write_error;
 	}
@@ -196,12 +222,11 @@ linear_hash_write_state(
 		return err_file_write_error;
 	}
 
-	ion_byte_t *cached_bucket_map = alloca(sizeof(ion_fpos_t) * linear_hash->bucket_map->current_size);
-
-	memset(cached_bucket_map, 0, sizeof(ion_fpos_t) * linear_hash->bucket_map->current_size);
-	memcpy(cached_bucket_map, linear_hash->bucket_map->data, linear_hash->num_buckets * sizeof(ion_fpos_t));
+	if (1 != fwrite(linear_hash->bucket_map->data, sizeof(ion_fpos_t) * linear_hash->bucket_map->current_size, 1, linear_hash->state)) {
+		return err_file_write_error;
+	}
 
-	if (1 != fwrite(cached_bucket_map, sizeof(linear_hash->bucket_map->data), 1, linear_hash->state)) {
+	if (1 != fwrite(&linear_hash->free_list, sizeof(linear_hash->free_list), 1, linear_hash->state)) {
 		return err_file_write_error;
 	}
 
@@ -251,7 +276,20 @@ linear_hash_read_state(
 		return err_file_read_error;
 	}
 
-	if (1 != fwrite(&linear_hash->bucket_map->data, sizeof(ion_fpos_t) * linear_hash->num_buckets, 1, linear_hash->state)) {
+	ion_fpos_t *bucket_map_data = malloc(sizeof(ion_fpos_t) * linear_hash->bucket_map->current_size);
+
+	if (NULL == bucket_map_data) {
+		return err_out_of_memory;
+	}
+
+	free(linear_hash->bucket_map->data);
+	linear_hash->bucket_map->data = bucket_map_data;
+
+	if (1 != fread(linear_hash->bucket_map->data, sizeof(ion_fpos_t) * linear_hash->bucket_map->current_size, 1, linear_hash->state)) {
+		return err_file_read_error;
+	}
+
+	if (1 != fread(&linear_hash->free_list, sizeof(linear_hash->free_list), 1, linear_hash->state)) {
 		return err_file_read_error;
 	}
 
@@ -276,10 +314,10 @@ linear_hash_bucket_is_full(
 
 /**
 @brief		Helper method to increment the number of records in the linear hash.
-@details	When a record is inserted into a linear hash, the load of the linear hash increases. If this pushes the load above the split threshold, then a new bucket is created and a split is performed.
+@details	When a record is inserted into a linear hash, the load of the linear hash increases. If this pushes the load above the split threshold, a split is started. While a split is in progress each insert carries it on by split_work buckets instead.
 @param[in]	linear_hash
 				Pointer to a linear hash instance.
-@return		err_ok or the resulting status of the several file operations used to create a new bucket.
+@return		err_ok or the resulting status of the several file operations used to split.
 */
 ion_err_t
 linear_hash_increment_num_records(
@@ -287,20 +325,15 @@ linear_hash_increment_num_records(
 ) {
 	linear_hash->num_records++;
 
-	ion_err_t err = err_ok;
+	if (linear_hash->split_in_progress) {
+		return linear_hash_split_step(linear_hash->split_work, linear_hash);
+	}
 
 	if (linear_hash_above_threshold(linear_hash)) {
-		err = write_new_bucket(linear_hash->num_buckets, linear_hash);
-
-		if (err != err_ok) {
-			return err;
-		}
-
-		linear_hash_increment_num_buckets(linear_hash);
-		err = split(linear_hash);
+		return split(linear_hash);
 	}
 
-	return err;
+	return err_ok;
 }
 
 /**
@@ -354,119 +387,235 @@ linear_hash_increment_next_split(
 }
 
 /**
-@brief		Performs the split operation on a linear hash instance.
-@details	A split is triggered when the load of the linear hash surpasses the split_threshold. A new bucket is created and the bucket currently pointed to by the split pointer has all of its records checked against a condition. If this condition passes, the record is deleted from the current bucket and inserted to the new bucket. This operation may require several several calls to linear_hash_insert and linear_hash_delete methods. To avoid data loss caused by the swap-on-delete strategy used in the linear_hash_delete deleting multiple records per call potentially, a cache is used to store the values associated with records which are deleted.
+@brief		Write a record to the head of a bucket chain, starting a new head if it is full.
+@details	Does not touch the record count, so it is shared by inserts and splits. The unsplit remainder of a chain being split belongs to both of its halves, so a half that does not yet own a bucket is given one rather than writing into the remainder.
+@param[in]	bucket_idx
+				Index of the chain to write to.
+@param[in]	key
+				Pointer to the key of the record.
+@param[in]	value
+				Pointer to the value of the record.
 @param[in]	linear_hash
 				Pointer to a linear hash instance.
-@return		err_ok.
+@return		Resulting status of the several file operations used to commit the write.
 */
-ion_err_t
-split(
+static ion_err_t
+linear_hash_chain_insert(
+	int					bucket_idx,
+	ion_byte_t			*key,
+	ion_byte_t			*value,
 	linear_hash_table_t *linear_hash
 ) {
-	/* status to hold amount of records deleted */
-	ion_status_t status					= ION_STATUS_INITIALIZE;
-
-	/* get bucket to split */
-	ion_fpos_t				bucket_loc	= bucket_idx_to_ion_fpos_t(linear_hash->next_split, linear_hash);
+	ion_fpos_t				bucket_loc		= bucket_idx_to_ion_fpos_t(bucket_idx, linear_hash);
+	ion_byte_t				record_status	= linear_hash_record_status_full;
 	linear_hash_bucket_t	bucket;
+	ion_err_t				err;
 
-	status.error = linear_hash_get_bucket(bucket_loc, &bucket, linear_hash);
+	if (linear_hash->split_in_progress && (bucket_loc == linear_hash->split_remainder)) {
+		bucket.record_count = linear_hash->records_per_bucket;
+	}
+	else {
+		err = linear_hash_get_bucket(bucket_loc, &bucket, linear_hash);
 
-	if (status.error != err_ok) {
-		return status.error;
+		if (err != err_ok) {
+			return err;
+		}
 	}
 
-	/* stores for record data */
-	ion_byte_t	*record_key		= alloca(linear_hash->super.record.key_size);
-	ion_byte_t	*record_value	= alloca(linear_hash->super.record.value_size);
-	ion_byte_t	record_status	= linear_hash_record_status_empty;
+	if (linear_hash_bucket_is_full(bucket, linear_hash)) {
+		err = create_overflow_bucket(bucket_idx, &bucket_loc, linear_hash);
 
-	int split_hash_key;
-	int insert_hash_key;
+		if (err != err_ok) {
+			return err;
+		}
 
-	int			i, j;
-	ion_byte_t	*records = alloca(linear_hash->record_total_size * linear_hash->records_per_bucket);
+		err = linear_hash_get_bucket(bucket_loc, &bucket, linear_hash);
 
-	memset(records, 0, linear_hash->record_total_size * linear_hash->records_per_bucket);
+		if (err != err_ok) {
+			return err;
+		}
+	}
 
-	ion_fpos_t		record_offset	= 0;
-	ion_boolean_t	terminal		= boolean_false;
+	err = linear_hash_write_record(GET_BUCKET_RECORDS_LOC(bucket_loc) + bucket.record_count * linear_hash->record_total_size, key, value, &record_status, linear_hash);
 
-	while (terminal == boolean_false) {
-		/* if the bucket is not empty */
-		if (bucket.record_count > 0) {
-			/* read all records into memory */
-			fseek(linear_hash->database, bucket_loc + sizeof(linear_hash_bucket_t), SEEK_SET);
-			fread(records, linear_hash->record_total_size, linear_hash->records_per_bucket, linear_hash->database);
+	if (err != err_ok) {
+		return err;
+	}
 
-			/* scan records for records that should be placed in the new bucket */
-			for (i = 0; i < bucket.record_count; i++) {
-				memcpy(&record_status, records + record_offset, sizeof(record_status));
-				memcpy(record_key, records + record_offset + sizeof(record_status), linear_hash->super.record.key_size);
-				memcpy(record_value, records + record_offset + sizeof(record_status) + linear_hash->super.record.key_size, linear_hash->super.record.value_size);
+	bucket.record_count++;
+	return linear_hash_update_bucket(bucket_loc, &bucket, linear_hash);
+}
+
+/**
+@brief		Starts splitting the bucket chain at the split pointer.
+@details	A split is triggered when the load of the linear hash surpasses the split_threshold. A new bucket index is added and the chain at next_split is read once, bucket by bucket, with each record appended to the chain h1 maps it to. Both new chains are written head first as the old one is consumed, and the consumed buckets go to the free list so the new chains reuse them. Until the old chain is used up both halves end in its remainder, so every record stays reachable from the chain its key hashes to. With a split_work of 0 the whole chain is split here, otherwise the split is spread over the following inserts.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the several file operations used to split.
+*/
+ion_err_t
+split(
+	linear_hash_table_t *linear_hash
+) {
+	/* only one split runs at a time */
+	ion_err_t err = linear_hash_split_step(0, linear_hash);
 
-				insert_hash_key = insert_hash_to_bucket(record_key, linear_hash);
+	if (err != err_ok) {
+		return err;
+	}
 
-				split_hash_key	= hash_to_bucket(record_key, linear_hash);
+	linear_hash_increment_num_buckets(linear_hash);
 
-				/* if the record is not a tombstone and h0(k) != h1(k) */
-				if ((record_status == linear_hash_record_status_full) && (insert_hash_key != split_hash_key)) {
-					/* delete all records with this key from the table */
-					status = linear_hash_delete(record_key, linear_hash);
+	linear_hash->split_remainder	= bucket_idx_to_ion_fpos_t(linear_hash->next_split, linear_hash);
+	linear_hash->split_tail[0]		= linear_hash_end_of_list;
+	linear_hash->split_tail[1]		= linear_hash_end_of_list;
+	linear_hash->split_in_progress	= boolean_true;
 
-					if (status.error != err_ok) {
-						return status.error;
-					}
+	/* the new bucket index shares the chain being split until records are moved to it */
+	err								= array_list_insert(linear_hash->num_buckets - 1, linear_hash->split_remainder, linear_hash->bucket_map);
 
-					int num_deleted = status.count;
+	if (err != err_ok) {
+		return err;
+	}
 
-					linear_hash->last_cache_idx = 0;
+	return linear_hash_split_step(linear_hash->split_work, linear_hash);
+}
 
-					/* insert that many records into the table */
-					for (j = 0; j < num_deleted; j++) {
-						memcpy(record_value, linear_hash->cache + linear_hash->last_cache_idx * linear_hash->super.record.value_size, linear_hash->super.record.value_size);
-						linear_hash->last_cache_idx++;
+/**
+@brief		Carries on the split in progress, if any.
+@details	Each bucket of the chain being split is read whole, unlinked from both halves and freed before its records are written to their new chains, which then take it back from the free list. Once the chain is used up, a half left without records gets an empty bucket and the split pointer advances.
+@param[in]	budget
+				Number of buckets of the chain being split to consume, or 0 to finish the split.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the several file operations used to split.
+*/
+ion_err_t
+linear_hash_split_step(
+	int					budget,
+	linear_hash_table_t *linear_hash
+) {
+	ion_fpos_t				bucket_size = LINEAR_HASH_BUCKET_SIZE(linear_hash);
+	ion_byte_t				*bucket_data;
+	ion_byte_t				*record;
+	ion_fpos_t				bucket_loc;
+	linear_hash_bucket_t	bucket;
+	linear_hash_bucket_t	tail;
+	int						halves[2];
+	int						consumed;
+	int						half;
+	int						i;
+	ion_err_t				err;
 
-						status = linear_hash_insert(record_key, record_value, hash_to_bucket(record_key, linear_hash), linear_hash);
+	if (!linear_hash->split_in_progress) {
+		return err_ok;
+	}
 
-						if (status.error != err_ok) {
-							return status.error;
-						}
-					}
+	halves[0]	= linear_hash->next_split;
+	halves[1]	= linear_hash->num_buckets - 1;
+	bucket_data = alloca(bucket_size);
+
+	for (consumed = 0; linear_hash->split_remainder != linear_hash_end_of_list && (0 == budget || consumed < budget); consumed++) {
+		bucket_loc	= linear_hash->split_remainder;
+		err			= linear_hash_read_bucket(bucket_loc, bucket_data, linear_hash);
+
+		if (err != err_ok) {
+			return err;
+		}
+
+		memcpy(&bucket, bucket_data, sizeof(linear_hash_bucket_t));
+		linear_hash->split_remainder = bucket.overflow_location;
 
-					/* refresh cached data and restart iteration and offset tracker */
-					fseek(linear_hash->database, bucket_loc + sizeof(linear_hash_bucket_t), SEEK_SET);
-					fread(records, linear_hash->record_total_size, linear_hash->records_per_bucket, linear_hash->database);
-					status.error	= linear_hash_get_bucket(bucket_loc, &bucket, linear_hash);
-					i				= -1;
-					record_offset	= -1 * linear_hash->record_total_size;
+		/* unlink the bucket from both halves */
+		for (half = 0; half < 2; half++) {
+			if (linear_hash->split_tail[half] != linear_hash_end_of_list) {
+				err = linear_hash_get_bucket(linear_hash->split_tail[half], &tail, linear_hash);
+
+				if (err != err_ok) {
+					return err;
 				}
 
-				/* track offset from locations of records in memory the next record is at */
-				record_offset += linear_hash->record_total_size;
+				tail.overflow_location	= linear_hash->split_remainder;
+				err						= linear_hash_update_bucket(linear_hash->split_tail[half], &tail, linear_hash);
+
+				if (err != err_ok) {
+					return err;
+				}
 			}
 
-			/* reset offset */
-			record_offset = 0;
+			if (bucket_idx_to_ion_fpos_t(halves[half], linear_hash) == bucket_loc) {
+				err = array_list_insert(halves[half], linear_hash->split_remainder, linear_hash->bucket_map);
+
+				if (err != err_ok) {
+					return err;
+				}
+			}
 		}
 
-		if (bucket.overflow_location == linear_hash_end_of_list) {
-			terminal = boolean_true;
+		err = linear_hash_free_bucket(bucket_loc, linear_hash);
+
+		if (err != err_ok) {
+			return err;
 		}
-		else {
-			bucket_loc		= bucket.overflow_location;
-			status.error	= linear_hash_get_bucket(bucket_loc, &bucket, linear_hash);
 
-			if (status.error != err_ok) {
-				return status.error;
+		record = bucket_data + sizeof(linear_hash_bucket_t);
+
+		for (i = 0; i < linear_hash->records_per_bucket; i++) {
+			if (*record == linear_hash_record_status_full) {
+				half	= hash_to_bucket(record + sizeof(ion_byte_t), linear_hash) == halves[0] ? 0 : 1;
+				err		= linear_hash_chain_insert(halves[half], record + sizeof(ion_byte_t), record + sizeof(ion_byte_t) + linear_hash->super.record.key_size, linear_hash);
+
+				if (err != err_ok) {
+					return err;
+				}
+			}
+
+			record += linear_hash->record_total_size;
+		}
+	}
+
+	if (linear_hash->split_remainder != linear_hash_end_of_list) {
+		return err_ok;
+	}
+
+	/* every chain needs a head, even an empty one */
+	for (half = 0; half < 2; half++) {
+		if (bucket_idx_to_ion_fpos_t(halves[half], linear_hash) == linear_hash_end_of_list) {
+			err = write_new_bucket(halves[half], linear_hash);
+
+			if (err != err_ok) {
+				return err;
 			}
 		}
 	}
 
+	linear_hash->split_in_progress = boolean_false;
+	linear_hash->stats.num_splits++;
 	return linear_hash_increment_next_split(linear_hash);
 }
 
+/**
+@brief		Sets how many buckets of a splitting chain each insert redistributes.
+@details	A split then costs each insert a bounded amount of work, instead of one insert paying for a whole chain. A split already in progress continues at the new rate.
+@param[in]	split_work
+				Buckets per insert, or 0 to split a whole chain as soon as the split threshold is passed.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		err_ok, or err_invalid_initial_size if @p split_work is negative.
+*/
+ion_err_t
+linear_hash_set_split_work(
+	int					split_work,
+	linear_hash_table_t *linear_hash
+) {
+	if (split_work < 0) {
+		return err_invalid_initial_size;
+	}
+
+	linear_hash->split_work = split_work;
+	return err_ok;
+}
+
 /**
 @brief		Helper method to increment check if a linear hash's load is above its split threshold.
 @param[in]	linear_hash
@@ -515,9 +664,16 @@ linear_hash_get_bucket_swap_record(
 	/* read in bucket currently swapping to obtain the last record */
 	ion_fpos_t				bucket_loc = array_list_get(bucket_idx, linear_hash->bucket_map);
 	linear_hash_bucket_t	bucket;
+	int						half;
 
 	linear_hash_get_bucket(bucket_loc, &bucket, linear_hash);
 
+	/* the head can only be empty if it is the remainder of a split that the other half has emptied */
+	while ((bucket.record_count == 0) && (bucket.overflow_location != linear_hash_end_of_list)) {
+		bucket_loc = bucket.overflow_location;
+		linear_hash_get_bucket(bucket_loc, &bucket, linear_hash);
+	}
+
 	ion_fpos_t swap_record_loc	= bucket_loc + sizeof(linear_hash_bucket_t) + ((bucket.record_count - 1) * linear_hash->record_total_size);
 
 	/* read in the record to swap with next */
@@ -539,9 +695,23 @@ linear_hash_get_bucket_swap_record(
 	*record_loc = swap_record_loc;
 	bucket.record_count--;
 
-	/* garuntee the bucket in the bucket map has records in it - THIS LEAVES EMPTY BUCKETS FLOATING ABOUT */
-	if ((bucket.record_count == 0) && (bucket.overflow_location != linear_hash_end_of_list)) {
-		array_list_insert(bucket.idx, bucket.overflow_location, linear_hash->bucket_map);
+	/* garuntee the bucket in the bucket map has records in it - THIS LEAVES EMPTY BUCKETS FLOATING ABOUT.
+	 * A half of a split that starts in the chain being split keeps pointing at it, since the split relinks the halves from there */
+	if ((bucket.record_count == 0) && (bucket.overflow_location != linear_hash_end_of_list) && (bucket_loc == array_list_get(bucket_idx, linear_hash->bucket_map)) && !(linear_hash->split_in_progress && (bucket_loc == linear_hash->split_remainder))) {
+		err = array_list_insert(bucket_idx, bucket.overflow_location, linear_hash->bucket_map);
+
+		if (err != err_ok) {
+			return err;
+		}
+
+		/* a half whose only bucket of its own is dropped starts in the chain being split again */
+		if (linear_hash->split_in_progress && (bucket_idx == linear_hash->next_split || bucket_idx == linear_hash->num_buckets - 1)) {
+			half = bucket_idx == linear_hash->next_split ? 0 : 1;
+
+			if (linear_hash->split_tail[half] == bucket_loc) {
+				linear_hash->split_tail[half] = linear_hash_end_of_list;
+			}
+		}
 	}
 
 	/* only to update bucket if not becoming junk bucket */
@@ -578,66 +748,11 @@ linear_hash_insert(
 ) {
 	ion_status_t status = ION_STATUS_INITIALIZE;
 
-	if (hash_bucket_idx < linear_hash->next_split) {
+	if ((hash_bucket_idx < linear_hash->next_split) || (linear_hash->split_in_progress && (hash_bucket_idx == linear_hash->next_split))) {
 		hash_bucket_idx = hash_to_bucket(key, linear_hash);
 	}
 
-	/* create a linear_hash_record with the desired key, value, and status of full*/
-	ion_byte_t	*record_key		= alloca(linear_hash->super.record.key_size);
-	ion_byte_t	*record_value	= alloca(linear_hash->super.record.value_size);
-	ion_byte_t	record_status	= linear_hash_record_status_full;
-
-	memcpy(record_key, key, linear_hash->super.record.key_size);
-	memcpy(record_value, value, linear_hash->super.record.value_size);
-
-	/* get the appropriate bucket for insertion */
-	ion_fpos_t				bucket_loc = bucket_idx_to_ion_fpos_t(hash_bucket_idx, linear_hash);
-	linear_hash_bucket_t	bucket;
-
-	status.error = linear_hash_get_bucket(bucket_loc, &bucket, linear_hash);
-
-	if (status.error != err_ok) {
-		return status;
-	}
-
-	/* location of the records in the bucket to be stored in */
-	ion_fpos_t	bucket_records_loc = GET_BUCKET_RECORDS_LOC(bucket_loc);
-	ion_fpos_t	record_loc;
-
-	/* Case the bucket is empty */
-	if (bucket.record_count == 0) {
-		record_loc = bucket_records_loc;
-	}
-	else {
-		/* Case that the bucket is full but there is not yet an overflow bucket */
-		if (linear_hash_bucket_is_full(bucket, linear_hash)) {
-			/* Get location of overflow bucket and update the tail record for the linked list of buckets storing
-			 * items that hash to this bucket and update the tail bucket with the overflow's location */
-			ion_fpos_t *overflow_location = alloca(sizeof(ion_fpos_t));
-
-			status.error = create_overflow_bucket(bucket.idx, overflow_location, linear_hash);
-
-			if (err_ok != status.error) {
-				return status;
-			}
-
-			/* update parameters of bucket to match that of overflow just created */
-			bucket.record_count			= 0;
-			bucket.overflow_location	= bucket_loc;
-
-			/* update the locations to write to in the file for the record and bucket */
-			record_loc					= GET_BUCKET_RECORDS_LOC(*overflow_location);
-			bucket_loc					= *overflow_location;
-		}
-		/* case there is >= 1 record in the bucket but it is not full */
-		else {
-			/* create a linear_hash_record with the desired key, value, and status of full*/
-			record_loc = bucket_loc + sizeof(linear_hash_bucket_t) + bucket.record_count * linear_hash->record_total_size;
-		}
-	}
-
-	/* write new record to the db */
-	status.error = linear_hash_write_record(record_loc, record_key, record_value, &record_status, linear_hash);
+	status.error = linear_hash_chain_insert(hash_bucket_idx, key, value, linear_hash);
 
 	if (status.error != err_ok) {
 		return status;
@@ -645,16 +760,7 @@ linear_hash_insert(
 
 	status.count++;
 
-	/* update bucket */
-	bucket.record_count++;
-	status.error = linear_hash_update_bucket(bucket_loc, &bucket, linear_hash);
-
-	if (status.error != err_ok) {
-		return status;
-	}
-
-	status.error = err_ok;
-	linear_hash_increment_num_records(linear_hash);
+	status.error = linear_hash_increment_num_records(linear_hash);
 	return status;
 }
 
@@ -678,11 +784,7 @@ linear_hash_get(
 	/* status for result count */
 	ion_status_t status = ION_STATUS_INITIALIZE;
 	/* get the index of the bucket to read */
-	int bucket_idx		= insert_hash_to_bucket(key, linear_hash);
-
-	if (bucket_idx < linear_hash->next_split) {
-		bucket_idx = hash_to_bucket(key, linear_hash);
-	}
+	int bucket_idx		= linear_hash_bucket_idx(key, linear_hash);
 
 	/* get the bucket where the record would be located */
 	ion_fpos_t				bucket_loc = bucket_idx_to_ion_fpos_t(bucket_idx, linear_hash);
@@ -712,8 +814,7 @@ linear_hash_get(
 
 	while (terminal == boolean_false && found == boolean_false) {
 		record_loc = bucket_loc + sizeof(linear_hash_bucket_t);
-		fseek(linear_hash->database, bucket_loc + sizeof(linear_hash_bucket_t), SEEK_SET);
-		fread(records, linear_hash->record_total_size, linear_hash->records_per_bucket, linear_hash->database);
+		linear_hash_cache_read(GET_BUCKET_RECORDS_LOC(bucket_loc), records, linear_hash->record_total_size * linear_hash->records_per_bucket, linear_hash);
 
 		for (i = 0; i < linear_hash->records_per_bucket; i++) {
 			memcpy(&record_status, records + record_offset, sizeof(record_status));
@@ -778,11 +879,7 @@ linear_hash_update(
 ) {
 	ion_status_t status = ION_STATUS_INITIALIZE;
 	/* get the index of the bucket to read */
-	int bucket_idx		= insert_hash_to_bucket(key, linear_hash);
-
-	if (bucket_idx < linear_hash->next_split) {
-		bucket_idx = hash_to_bucket(key, linear_hash);
-	}
+	int bucket_idx		= linear_hash_bucket_idx(key, linear_hash);
 
 	/* get the bucket where the record would be located */
 	ion_fpos_t				bucket_loc = bucket_idx_to_ion_fpos_t(bucket_idx, linear_hash);
@@ -871,11 +968,7 @@ linear_hash_delete(
 	/* status for result count */
 	ion_status_t status = ION_STATUS_INITIALIZE;
 	/* get the index of the bucket to read */
-	int bucket_idx		= insert_hash_to_bucket(key, linear_hash);
-
-	if (bucket_idx < linear_hash->next_split) {
-		bucket_idx = hash_to_bucket(key, linear_hash);
-	}
+	int bucket_idx		= linear_hash_bucket_idx(key, linear_hash);
 
 	/* get the bucket where the record would be located */
 	ion_fpos_t				bucket_loc = bucket_idx_to_ion_fpos_t(bucket_idx, linear_hash);
@@ -912,8 +1005,7 @@ linear_hash_delete(
 
 	while (terminal == boolean_false) {
 		record_loc = bucket_loc + sizeof(linear_hash_bucket_t);
-		fseek(linear_hash->database, bucket_loc + sizeof(linear_hash_bucket_t), SEEK_SET);
-		fread(records, linear_hash->record_total_size, linear_hash->records_per_bucket, linear_hash->database);
+		linear_hash_cache_read(GET_BUCKET_RECORDS_LOC(bucket_loc), records, linear_hash->record_total_size * linear_hash->records_per_bucket, linear_hash);
 
 		for (i = 0; i < bucket.record_count; i++) {
 			/* read in record */
@@ -998,157 +1090,604 @@ linear_hash_delete(
 	return status;
 }
 
-/* returns the struct representing the bucket at the specified index */
+/* BUCKET CACHE */
 /**
-@brief		Read the record data at the location specified from the linear hash's .lhd file.
-@param[in]	loc
-				Location of the record in the linear hash's data file.
-@param[in]	key
-				Pointer where the key of the record is written back to.
-@param[in]	value
-				Pointer where the value of the record is written back to.
-@param[in]	status
-				Pointer where the status of the record is written back to.
+@brief		Maps a bucket location to its hash slot in the bucket cache.
+@param[in]	bucket_loc
+				Location of the bucket in the linear hash's .lhd file.
 @param[in]	linear_hash
 				Pointer to a linear hash instance.
-@return		Resulting status of the several file operations used to commit the write.
+@return		The hash slot.
 */
-ion_err_t
-linear_hash_get_record(
-	ion_fpos_t			loc,
-	ion_byte_t			*key,
-	ion_byte_t			*value,
-	ion_byte_t			*status,
+static int
+linear_hash_cache_slot(
+	ion_fpos_t			bucket_loc,
 	linear_hash_table_t *linear_hash
 ) {
-	/* seek to location of record in file */
-	if (0 != fseek(linear_hash->database, loc, SEEK_SET)) {
-		return err_file_bad_seek;
-	}
+	return (int) ((bucket_loc / LINEAR_HASH_BUCKET_SIZE(linear_hash)) % linear_hash->bucket_cache.num_frames);
+}
 
-	/* cache record data from file */
-	ion_byte_t *record = alloca(linear_hash->record_total_size);
+/**
+@brief		Finds the cache frame holding a bucket.
+@param[in]	bucket_loc
+				Location of the bucket in the linear hash's .lhd file.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		The frame index, or -1 if the bucket is not cached.
+*/
+int
+linear_hash_cache_lookup(
+	ion_fpos_t			bucket_loc,
+	linear_hash_table_t *linear_hash
+) {
+	linear_hash_bucket_cache_t	*cache	= &linear_hash->bucket_cache;
+	int							frame	= cache->slots[linear_hash_cache_slot(bucket_loc, linear_hash)];
 
-	if (1 != fread(record, linear_hash->record_total_size, 1, linear_hash->database)) {
-		return err_file_read_error;
+	while (-1 != frame && cache->frames[frame].bucket_loc != bucket_loc) {
+		frame = cache->frames[frame].next;
 	}
 
-	/* read record data elements */
-	memcpy(status, record, sizeof(*status));
-	memcpy(key, record + sizeof(*status), linear_hash->super.record.key_size);
-	memcpy(value, record + sizeof(*status) + linear_hash->super.record.key_size, linear_hash->super.record.value_size);
-
-	return err_ok;
+	return frame;
 }
 
 /**
-@brief		Write record data to the location specified from the linear hash's .lhd file.
-@param[in]	record_loc
-				Location to write the record data in the linear hash's data file.
-@param[in]	key
-				Pointer to the key to be written.
-@param[in]	value
-				Pointer to the value to be written.
-@param[in]	status
-				Pointer to the status to be written.
+@brief		Writes a frame's page back to the .lhd file if it is dirty.
+@param[in]	frame
+				Index of the frame to write back.
 @param[in]	linear_hash
 				Pointer to a linear hash instance.
-@return		Resulting status of the several file operations used to commit the write.
+@return		Resulting status of the file operations used to commit the write.
 */
-ion_err_t
-linear_hash_write_record(
-	ion_fpos_t			record_loc,
-	ion_byte_t			*key,
-	ion_byte_t			*value,
-	ion_byte_t			*status,
+static ion_err_t
+linear_hash_cache_write_back(
+	int					frame,
 	linear_hash_table_t *linear_hash
 ) {
-	/* check the file is open */
-	if (!linear_hash->database) {
-		return err_file_close_error;
+	linear_hash_frame_t *cached			= &linear_hash->bucket_cache.frames[frame];
+	ion_fpos_t			bucket_size		= LINEAR_HASH_BUCKET_SIZE(linear_hash);
+
+	if (!cached->dirty) {
+		return err_ok;
 	}
 
-	/* seek to end of file to append new bucket */
-	if (0 != fseek(linear_hash->database, record_loc, SEEK_SET)) {
+	if (0 != fseek(linear_hash->database, cached->bucket_loc, SEEK_SET)) {
 		return err_file_bad_seek;
 	}
 
-	ion_byte_t *record = alloca(linear_hash->record_total_size);
+	if (1 != fwrite(linear_hash->bucket_cache.pages + frame * bucket_size, bucket_size, 1, linear_hash->database)) {
+		return err_file_write_error;
+	}
 
-	memcpy(record, status, sizeof(*status));
-	memcpy(record + sizeof(*status), key, linear_hash->super.record.key_size);
-	memcpy(record + linear_hash->super.record.key_size + sizeof(*status), value, linear_hash->super.record.value_size);
+	cached->dirty = boolean_false;
+	linear_hash->stats.num_writes++;
+	linear_hash->stats.bytes_written += bucket_size;
 
-	if (1 != fwrite(record, linear_hash->record_total_size, 1, linear_hash->database)) {
-		return err_file_write_error;
+	return err_ok;
+}
+
+/**
+@brief		Frees up a frame with the clock algorithm.
+@details	The hand takes one from the weight of each frame it passes and stops at the first free frame or the first
+			frame already worn down to zero. That frame is written back if it is dirty and unlinked from its hash slot.
+@param[out]	frame
+				The index of the freed frame.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of writing back the evicted page.
+*/
+static ion_err_t
+linear_hash_cache_evict(
+	int					*frame,
+	linear_hash_table_t *linear_hash
+) {
+	linear_hash_bucket_cache_t	*cache = &linear_hash->bucket_cache;
+	linear_hash_frame_t			*victim;
+	int							*link;
+	ion_err_t					err;
+
+	victim = &cache->frames[cache->clock_hand];
+
+	while (linear_hash_end_of_list != victim->bucket_loc && 0 != victim->weight) {
+		victim->weight--;
+		cache->clock_hand	= (cache->clock_hand + 1) % cache->num_frames;
+		victim				= &cache->frames[cache->clock_hand];
 	}
 
+	*frame				= cache->clock_hand;
+	cache->clock_hand	= (cache->clock_hand + 1) % cache->num_frames;
+
+	if (linear_hash_end_of_list == victim->bucket_loc) {
+		return err_ok;
+	}
+
+	err = linear_hash_cache_write_back(*frame, linear_hash);
+
+	if (err_ok != err) {
+		return err;
+	}
+
+	link = &cache->slots[linear_hash_cache_slot(victim->bucket_loc, linear_hash)];
+
+	while (*link != *frame) {
+		link = &cache->frames[*link].next;
+	}
+
+	*link				= victim->next;
+	victim->bucket_loc	= linear_hash_end_of_list;
+
 	return err_ok;
 }
 
 /**
-@brief		Write a new bucket to the linear hash's .lhd file.
-@details	The new bucket is intialized with empty memory, including space for all its record. The bucket is appended to the end of the .lhd file.
-@param[in]	idx
-				Index of the new bucket to be written
+@brief		Makes sure a bucket is in the cache.
+@details	Every use raises the frame's clock weight by one. Chain heads, which every operation on their chain passes
+			through, are raised straight to LINEAR_HASH_CACHE_HEAD_WEIGHT so that they outlive overflow buckets.
+@param[in]	bucket_loc
+				Location of the bucket in the linear hash's .lhd file.
+@param[in]	load
+				Whether to read the bucket from the file on a miss. A bucket being created starts out zeroed instead.
+@param[out]	frame
+				The index of the frame holding the bucket.
 @param[in]	linear_hash
 				Pointer to a linear hash instance.
-@return		Resulting status of the several file operations used to commit the write.
+@return		Resulting status of the file operations needed to bring the bucket in.
 */
-ion_err_t
-write_new_bucket(
-	int					idx,
+static ion_err_t
+linear_hash_cache_fetch(
+	ion_fpos_t			bucket_loc,
+	ion_boolean_t		load,
+	int					*frame,
 	linear_hash_table_t *linear_hash
 ) {
-	if (linear_hash->database == NULL) {
-		return err_file_open_error;
+	linear_hash_bucket_cache_t	*cache		= &linear_hash->bucket_cache;
+	ion_fpos_t					bucket_size = LINEAR_HASH_BUCKET_SIZE(linear_hash);
+	linear_hash_frame_t			*cached;
+	ion_byte_t					*page;
+	int							slot;
+	int							idx;
+	ion_err_t					err;
+
+	*frame = linear_hash_cache_lookup(bucket_loc, linear_hash);
+
+	if (-1 != *frame) {
+		linear_hash->stats.cache_hits++;
+		cached	= &cache->frames[*frame];
+		page	= cache->pages + *frame * bucket_size;
 	}
+	else {
+		err = linear_hash_cache_evict(frame, linear_hash);
 
-	linear_hash_bucket_t bucket;
+		if (err_ok != err) {
+			return err;
+		}
 
-	/* initialize bucket fields */
-	bucket.idx					= idx;
-	bucket.record_count			= 0;
-	bucket.overflow_location	= linear_hash_end_of_list;
+		cached	= &cache->frames[*frame];
+		page	= cache->pages + *frame * bucket_size;
 
-	/* seek to end of file to append new bucket */
-	ion_fpos_t bucket_loc;
+		if (load) {
+			linear_hash->stats.cache_misses++;
 
-	if (0 != fseek(linear_hash->database, 0, SEEK_END)) {
-		return err_file_bad_seek;
+			if (!linear_hash->database) {
+				return err_file_close_error;
+			}
+
+			if (0 != fseek(linear_hash->database, bucket_loc, SEEK_SET)) {
+				return err_file_bad_seek;
+			}
+
+			if (1 != fread(page, bucket_size, 1, linear_hash->database)) {
+				return err_file_read_error;
+			}
+
+			linear_hash->stats.num_reads++;
+			linear_hash->stats.bytes_read += bucket_size;
+		}
+		else {
+			memset(page, 0, bucket_size);
+		}
+
+		slot				= linear_hash_cache_slot(bucket_loc, linear_hash);
+		cached->bucket_loc	= bucket_loc;
+		cached->next		= cache->slots[slot];
+		cached->dirty		= !load;
+		cached->weight		= 0;
+		cache->slots[slot]	= *frame;
 	}
 
-	bucket_loc = ftell(linear_hash->database);
+	/* the bucket header starts with the index of the chain the bucket belongs to */
+	memcpy(&idx, page, sizeof(idx));
 
-	/* write bucket data to file */
-	if (1 != fwrite(&bucket, sizeof(linear_hash_bucket_t), 1, linear_hash->database)) {
-		return err_file_write_error;
+	if ((idx >= 0) && (array_list_get(idx, linear_hash->bucket_map) == bucket_loc)) {
+		cached->weight = LINEAR_HASH_CACHE_HEAD_WEIGHT;
+	}
+	else if (cached->weight < LINEAR_HASH_CACHE_HEAD_WEIGHT) {
+		cached->weight++;
+	}
+
+	return err_ok;
+}
+
+/**
+@brief		Allocates a linear hash's bucket cache.
+@param[in]	cache_size
+				Memory budget of the cache, in bytes. At least one bucket is always cached.
+@param[in]	linear_hash
+				Pointer to a linear hash instance. Its record layout must already be set.
+@return		err_ok, or err_out_of_memory.
+*/
+ion_err_t
+linear_hash_cache_init(
+	int					cache_size,
+	linear_hash_table_t *linear_hash
+) {
+	linear_hash_bucket_cache_t	*cache		= &linear_hash->bucket_cache;
+	ion_fpos_t					bucket_size = LINEAR_HASH_BUCKET_SIZE(linear_hash);
+	int							i;
+
+	cache->num_frames	= cache_size / bucket_size;
+
+	if (cache->num_frames < 1) {
+		cache->num_frames = 1;
 	}
 
-	/* write bucket data to file */
-	ion_byte_t record_blank[linear_hash->super.record.key_size + linear_hash->super.record.value_size + sizeof(linear_hash_record_status_empty)];
+	cache->clock_hand	= 0;
+	cache->frames		= malloc(sizeof(linear_hash_frame_t) * cache->num_frames);
+	cache->slots		= malloc(sizeof(int) * cache->num_frames);
+	cache->pages		= malloc(bucket_size * cache->num_frames);
+
+	if ((NULL == cache->frames) || (NULL == cache->slots) || (NULL == cache->pages)) {
+		linear_hash_cache_free(linear_hash);
+		return err_out_of_memory;
+	}
 
-	memset(record_blank, 0, linear_hash->super.record.key_size + linear_hash->super.record.value_size);
+	for (i = 0; i < cache->num_frames; i++) {
+		cache->frames[i].bucket_loc = linear_hash_end_of_list;
+		cache->frames[i].next		= -1;
+		cache->frames[i].dirty		= boolean_false;
+		cache->frames[i].weight		= 0;
+		cache->slots[i]				= -1;
+	}
 
-	int i;
+	return err_ok;
+}
 
-	for (i = 0; i < linear_hash->records_per_bucket; i++) {
-		if (1 != fwrite(record_blank, linear_hash->super.record.key_size + linear_hash->super.record.value_size + sizeof(linear_hash_record_status_empty), 1, linear_hash->database)) {
-			return err_file_write_error;
+/**
+@brief		Writes every dirty bucket in the cache back to the .lhd file. The buckets stay cached.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the file operations used to commit the writes.
+*/
+ion_err_t
+linear_hash_cache_flush(
+	linear_hash_table_t *linear_hash
+) {
+	ion_err_t	err;
+	int			i;
+
+	for (i = 0; i < linear_hash->bucket_cache.num_frames; i++) {
+		if (linear_hash_end_of_list != linear_hash->bucket_cache.frames[i].bucket_loc) {
+			err = linear_hash_cache_write_back(i, linear_hash);
+
+			if (err_ok != err) {
+				return err;
+			}
 		}
 	}
 
-	/* write bucket_loc in mapping */
-	/* store_bucket_loc_in_map(idx, bucket_loc, linear_hash); */
-	ion_err_t err = array_list_insert(idx, bucket_loc, linear_hash->bucket_map);
+	return err_ok;
+}
+
+/**
+@brief		Frees a linear hash's bucket cache without writing anything back.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+*/
+void
+linear_hash_cache_free(
+	linear_hash_table_t *linear_hash
+) {
+	free(linear_hash->bucket_cache.frames);
+	free(linear_hash->bucket_cache.slots);
+	free(linear_hash->bucket_cache.pages);
+	linear_hash->bucket_cache.frames		= NULL;
+	linear_hash->bucket_cache.slots			= NULL;
+	linear_hash->bucket_cache.pages			= NULL;
+	linear_hash->bucket_cache.num_frames	= 0;
+}
+
+/**
+@brief		Changes the memory budget of a linear hash's bucket cache.
+@details	Dirty buckets are written back and the cache starts over empty.
+@param[in]	cache_size
+				New memory budget of the cache, in bytes. At least one bucket is always cached.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the write back, or err_out_of_memory.
+*/
+ion_err_t
+linear_hash_set_cache_size(
+	int					cache_size,
+	linear_hash_table_t *linear_hash
+) {
+	ion_err_t err = linear_hash_cache_flush(linear_hash);
+
+	if (err_ok != err) {
+		return err;
+	}
+
+	linear_hash_cache_free(linear_hash);
+	return linear_hash_cache_init(cache_size, linear_hash);
+}
+
+/**
+@brief		Reads bytes from within one bucket through the cache.
+@param[in]	loc
+				Location in the linear hash's .lhd file to read from.
+@param[out]	data
+				Buffer the bytes are written back to.
+@param[in]	size
+				Number of bytes to read. They must not run past the end of the bucket holding loc.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the file operations needed to bring the bucket in.
+*/
+ion_err_t
+linear_hash_cache_read(
+	ion_fpos_t			loc,
+	void				*data,
+	int					size,
+	linear_hash_table_t *linear_hash
+) {
+	ion_fpos_t	bucket_size = LINEAR_HASH_BUCKET_SIZE(linear_hash);
+	ion_fpos_t	offset		= loc % bucket_size;
+	int			frame;
+	ion_err_t	err			= linear_hash_cache_fetch(loc - offset, boolean_true, &frame, linear_hash);
+
+	if (err_ok != err) {
+		return err;
+	}
+
+	memcpy(data, linear_hash->bucket_cache.pages + frame * bucket_size + offset, size);
+	return err_ok;
+}
+
+/**
+@brief		Writes bytes within one bucket through the cache. They reach the file when the bucket is evicted or
+			flushed.
+@param[in]	loc
+				Location in the linear hash's .lhd file to write to.
+@param[in]	data
+				The bytes to write.
+@param[in]	size
+				Number of bytes to write. They must not run past the end of the bucket holding loc.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the file operations needed to bring the bucket in.
+*/
+ion_err_t
+linear_hash_cache_write(
+	ion_fpos_t			loc,
+	void				*data,
+	int					size,
+	linear_hash_table_t *linear_hash
+) {
+	ion_fpos_t	bucket_size = LINEAR_HASH_BUCKET_SIZE(linear_hash);
+	ion_fpos_t	offset		= loc % bucket_size;
+	int			frame;
+	ion_err_t	err			= linear_hash_cache_fetch(loc - offset, boolean_true, &frame, linear_hash);
+
+	if (err_ok != err) {
+		return err;
+	}
+
+	memcpy(linear_hash->bucket_cache.pages + frame * bucket_size + offset, data, size);
+	linear_hash->bucket_cache.frames[frame].dirty = boolean_true;
+	return err_ok;
+}
+
+/**
+@brief		Adds a bucket to the end of the linear hash's .lhd file.
+@details	The bucket is created in the cache with all of its records empty, so it costs no I/O until it is written
+			back.
+@param[in]	bucket
+				Header of the new bucket.
+@param[out]	bucket_loc
+				Location of the new bucket.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the file operations needed to make room in the cache.
+*/
+static ion_err_t
+linear_hash_append_bucket(
+	linear_hash_bucket_t	*bucket,
+	ion_fpos_t				*bucket_loc,
+	linear_hash_table_t		*linear_hash
+) {
+	int			frame;
+	ion_err_t	err = linear_hash_cache_fetch(linear_hash->database_size, boolean_false, &frame, linear_hash);
+
+	if (err_ok != err) {
+		return err;
+	}
+
+	*bucket_loc					= linear_hash->database_size;
+	linear_hash->database_size	+= LINEAR_HASH_BUCKET_SIZE(linear_hash);
+
+	return linear_hash_cache_write(*bucket_loc, bucket, sizeof(linear_hash_bucket_t), linear_hash);
+}
+
+/**
+@brief		Write a new bucket, reusing a freed one before growing the .lhd file.
+@param[in]	bucket
+				Header of the new bucket.
+@param[out]	bucket_loc
+				Location of the new bucket.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the several file operations used to commit the write.
+*/
+ion_err_t
+linear_hash_allocate_bucket(
+	linear_hash_bucket_t	*bucket,
+	ion_fpos_t				*bucket_loc,
+	linear_hash_table_t		*linear_hash
+) {
+	linear_hash_bucket_t	free_bucket;
+	ion_err_t				err;
+
+	if (linear_hash->free_list == linear_hash_end_of_list) {
+		return linear_hash_append_bucket(bucket, bucket_loc, linear_hash);
+	}
+
+	err = linear_hash_get_bucket(linear_hash->free_list, &free_bucket, linear_hash);
 
 	if (err != err_ok) {
 		return err;
 	}
 
+	*bucket_loc				= linear_hash->free_list;
+	linear_hash->free_list	= free_bucket.overflow_location;
+
+	return linear_hash_update_bucket(*bucket_loc, bucket, linear_hash);
+}
+
+/**
+@brief		Empty a bucket no chain links to and put it on the free list.
+@param[in]	bucket_loc
+				Location of the bucket to free.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the several file operations used to commit the write.
+*/
+ion_err_t
+linear_hash_free_bucket(
+	ion_fpos_t			bucket_loc,
+	linear_hash_table_t *linear_hash
+) {
+	ion_fpos_t				bucket_size = LINEAR_HASH_BUCKET_SIZE(linear_hash);
+	ion_byte_t				*bucket_data = alloca(bucket_size);
+	linear_hash_bucket_t	bucket;
+	ion_err_t				err;
+
+	/* clear every slot so that readers walking the file skip the bucket */
+	memset(bucket_data, 0, bucket_size);
+	bucket.idx					= linear_hash_end_of_list;
+	bucket.record_count			= 0;
+	bucket.overflow_location	= linear_hash->free_list;
+	memcpy(bucket_data, &bucket, sizeof(linear_hash_bucket_t));
+
+	err							= linear_hash_cache_write(bucket_loc, bucket_data, bucket_size, linear_hash);
+
+	if (err != err_ok) {
+		return err;
+	}
+
+	linear_hash->free_list = bucket_loc;
+	return err_ok;
+}
+
+/* returns the struct representing the bucket at the specified index */
+/**
+@brief		Read the record data at the location specified from the linear hash's .lhd file.
+@param[in]	loc
+				Location of the record in the linear hash's data file.
+@param[in]	key
+				Pointer where the key of the record is written back to.
+@param[in]	value
+				Pointer where the value of the record is written back to.
+@param[in]	status
+				Pointer where the status of the record is written back to.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the several file operations used to commit the write.
+*/
+ion_err_t
+linear_hash_get_record(
+	ion_fpos_t			loc,
+	ion_byte_t			*key,
+	ion_byte_t			*value,
+	ion_byte_t			*status,
+	linear_hash_table_t *linear_hash
+) {
+	/* cache record data from its bucket */
+	ion_byte_t	*record = alloca(linear_hash->record_total_size);
+	ion_err_t	err		= linear_hash_cache_read(loc, record, linear_hash->record_total_size, linear_hash);
+
+	if (err_ok != err) {
+		return err;
+	}
+
+	/* read record data elements */
+	memcpy(status, record, sizeof(*status));
+	memcpy(key, record + sizeof(*status), linear_hash->super.record.key_size);
+	memcpy(value, record + sizeof(*status) + linear_hash->super.record.key_size, linear_hash->super.record.value_size);
+
 	return err_ok;
 }
 
+/**
+@brief		Write record data to the location specified from the linear hash's .lhd file.
+@param[in]	record_loc
+				Location to write the record data in the linear hash's data file.
+@param[in]	key
+				Pointer to the key to be written.
+@param[in]	value
+				Pointer to the value to be written.
+@param[in]	status
+				Pointer to the status to be written.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the several file operations used to commit the write.
+*/
+ion_err_t
+linear_hash_write_record(
+	ion_fpos_t			record_loc,
+	ion_byte_t			*key,
+	ion_byte_t			*value,
+	ion_byte_t			*status,
+	linear_hash_table_t *linear_hash
+) {
+	ion_byte_t *record = alloca(linear_hash->record_total_size);
+
+	memcpy(record, status, sizeof(*status));
+	memcpy(record + sizeof(*status), key, linear_hash->super.record.key_size);
+	memcpy(record + linear_hash->super.record.key_size + sizeof(*status), value, linear_hash->super.record.value_size);
+
+	return linear_hash_cache_write(record_loc, record, linear_hash->record_total_size, linear_hash);
+}
+
+/**
+@brief		Write a new bucket to the linear hash's .lhd file.
+@details	The new bucket is intialized with empty memory, including space for all its record. The bucket is appended to the end of the .lhd file.
+@param[in]	idx
+				Index of the new bucket to be written
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		Resulting status of the several file operations used to commit the write.
+*/
+ion_err_t
+write_new_bucket(
+	int					idx,
+	linear_hash_table_t *linear_hash
+) {
+	linear_hash_bucket_t bucket;
+
+	/* initialize bucket fields */
+	bucket.idx					= idx;
+	bucket.record_count			= 0;
+	bucket.overflow_location	= linear_hash_end_of_list;
+
+	ion_fpos_t	bucket_loc;
+	ion_err_t	err = linear_hash_allocate_bucket(&bucket, &bucket_loc, linear_hash);
+
+	if (err != err_ok) {
+		return err;
+	}
+
+	/* write bucket_loc in mapping */
+	return array_list_insert(idx, bucket_loc, linear_hash->bucket_map);
+}
+
 /**
 @brief		Read the bucket at the location specified from the linear hash's .lhd file.
 @param[in]	bucket_loc
@@ -1165,28 +1704,56 @@ linear_hash_get_bucket(
 	linear_hash_bucket_t	*bucket,
 	linear_hash_table_t		*linear_hash
 ) {
-	if (bucket_loc == -1) {}
+	return linear_hash_cache_read(bucket_loc, bucket, sizeof(linear_hash_bucket_t), linear_hash);
+}
+
+/**
+@brief		Read a whole bucket, header and record slots, from the linear hash's .lhd file in a single read.
+@param[in]	bucket_loc
+				Location of the bucket to read.
+@param[out]	bucket_data
+				Buffer of at least LINEAR_HASH_BUCKET_SIZE bytes the bucket is written back to.
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		err_ok, err_file_hit_eof if there is no bucket at bucket_loc, or the failing file operation's status.
+*/
+ion_err_t
+linear_hash_read_bucket(
+	ion_fpos_t			bucket_loc,
+	ion_byte_t			*bucket_data,
+	linear_hash_table_t *linear_hash
+) {
+	ion_fpos_t	bucket_size = LINEAR_HASH_BUCKET_SIZE(linear_hash);
+	int			frame;
+
+	if (bucket_loc >= linear_hash->database_size) {
+		return err_file_hit_eof;
+	}
+
+	frame = linear_hash_cache_lookup(bucket_loc, linear_hash);
 
-	/* check if file is open */
+	if (-1 != frame) {
+		memcpy(bucket_data, linear_hash->bucket_cache.pages + frame * bucket_size, bucket_size);
+		linear_hash->stats.cache_hits++;
+		return err_ok;
+	}
+
+	/* a scan reads around the cache so that it does not push out the hot buckets */
 	if (!linear_hash->database) {
 		return err_file_close_error;
 	}
 
-	/* seek to location of record in file */
 	if (0 != fseek(linear_hash->database, bucket_loc, SEEK_SET)) {
 		return err_file_bad_seek;
 	}
 
-	ion_byte_t *bucket_cache = alloca(sizeof(linear_hash_bucket_t));
-
-	if (1 != fread(bucket_cache, sizeof(linear_hash_bucket_t), 1, linear_hash->database)) {
+	if (1 != fread(bucket_data, bucket_size, 1, linear_hash->database)) {
 		return err_file_read_error;
 	}
 
-	/* read record data elements */
-	memcpy(&bucket->idx, bucket_cache, sizeof(int));
-	memcpy(&bucket->record_count, bucket_cache + sizeof(int), sizeof(int));
-	memcpy(&bucket->overflow_location, bucket_cache + 2 * sizeof(int), sizeof(ion_fpos_t));
+	linear_hash->stats.cache_misses++;
+	linear_hash->stats.num_reads++;
+	linear_hash->stats.bytes_read += bucket_size;
 
 	return err_ok;
 }
@@ -1207,22 +1774,7 @@ linear_hash_update_bucket(
 	linear_hash_bucket_t	*bucket,
 	linear_hash_table_t		*linear_hash
 ) {
-	/* check the file is open */
-	if (NULL == linear_hash->database) {
-		return err_file_open_error;
-	}
-
-	/* seek to end of file to append new bucket */
-	if (0 != fseek(linear_hash->database, bucket_loc, SEEK_SET)) {
-		return err_file_bad_seek;
-	}
-
-	/* write bucket data to file */
-	if (1 != fwrite(bucket, sizeof(linear_hash_bucket_t), 1, linear_hash->database)) {
-		return err_file_write_error;
-	}
-
-	return err_ok;
+	return linear_hash_cache_write(bucket_loc, bucket, sizeof(linear_hash_bucket_t), linear_hash);
 }
 
 /**
@@ -1251,39 +1803,19 @@ create_overflow_bucket(
 	bucket.record_count			= 0;
 	bucket.overflow_location	= array_list_get(bucket_idx, linear_hash->bucket_map);
 
-	/* seek to end of file to append new bucket */
-	if (0 != fseek(linear_hash->database, 0, SEEK_END)) {
-		return err_file_bad_seek;
-	}
-
 	/* get overflow location for new overflow bucket */
-	*overflow_loc	= ftell(linear_hash->database);
-
-	err				= array_list_insert(bucket.idx, *overflow_loc, linear_hash->bucket_map);
+	err							= linear_hash_allocate_bucket(&bucket, overflow_loc, linear_hash);
 
 	if (err != err_ok) {
 		return err;
 	}
 
-	/* write to file */
-	if (1 != fwrite(&bucket, sizeof(linear_hash_bucket_t), 1, linear_hash->database)) {
-		return err_file_write_error;
+	/* the first bucket a half of a split owns is the one linking it to the unsplit remainder */
+	if (linear_hash->split_in_progress && (bucket.overflow_location == linear_hash->split_remainder)) {
+		linear_hash->split_tail[bucket_idx == linear_hash->next_split ? 0 : 1] = *overflow_loc;
 	}
 
-	/* write bucket data to file */
-	ion_byte_t record_blank[linear_hash->super.record.key_size + linear_hash->super.record.value_size + sizeof(linear_hash_record_status_empty)];
-
-	memset(record_blank, 0, linear_hash->super.record.key_size + linear_hash->super.record.value_size);
-
-	int i;
-
-	for (i = 0; i < linear_hash->records_per_bucket; i++) {
-		if (1 != fwrite(record_blank, linear_hash->super.record.key_size + linear_hash->super.record.value_size + sizeof(linear_hash_record_status_empty), 1, linear_hash->database)) {
-			return err_file_write_error;
-		}
-	}
-
-	return err_ok;
+	return array_list_insert(bucket.idx, *overflow_loc, linear_hash->bucket_map);
 }
 
 /**
@@ -1304,7 +1836,8 @@ bucket_idx_to_ion_fpos_t(
 
 /**
 @brief		Transform a key to an integer.
-@details	Applies a polynomial hash to the byte-string representation of the key to transform the key to an integer.
+@details	Applies the full-key hash chosen for the dictionary if there is one, otherwise a polynomial hash
+			over the first bytes of the key.
 @param[in]	key
 				Pointer to the key to hash
 @param[in]	linear_hash
@@ -1319,8 +1852,18 @@ key_bytes_to_int(
 	int			i;
 	int			key_bytes_as_int	= 0;
 	static int	coefficients[]		= { 3, 5, 7, 11, 13, 17, 19 };
+	int			num_bytes			= linear_hash->super.record.key_size - 1;
+
+	if (NULL != linear_hash->super.hash) {
+		return (int) (linear_hash->super.hash(key, linear_hash->super.record.key_size) & 0x7FFFFFFF);
+	}
 
-	for (i = 0; i < linear_hash->super.record.key_size - 1; i++) {
+	/* the coefficients only cover the first bytes of longer keys */
+	if (num_bytes > (int) (sizeof(coefficients) / sizeof(coefficients[0])) - 1) {
+		num_bytes = (int) (sizeof(coefficients) / sizeof(coefficients[0])) - 1;
+	}
+
+	for (i = 0; i < num_bytes; i++) {
 		key_bytes_as_int += *(key + i) * coefficients[i + 1] - *(key + i) * coefficients[i];
 	}
 
@@ -1364,6 +1907,29 @@ insert_hash_to_bucket(
 	return key_bytes_as_int & (linear_hash->initial_size - 1);
 }
 
+/**
+@brief		Find the index of the bucket chain a key belongs to.
+@details	Chains before the split pointer have been split and are addressed with h1, as is the chain being split so that a key is looked up in the half it is moved to.
+@param[in]	key
+				Pointer to the key to hash
+@param[in]	linear_hash
+				Pointer to a linear hash instance.
+@return		The index of the bucket chain.
+*/
+int
+linear_hash_bucket_idx(
+	ion_byte_t			*key,
+	linear_hash_table_t *linear_hash
+) {
+	int bucket_idx = insert_hash_to_bucket(key, linear_hash);
+
+	if ((bucket_idx < linear_hash->next_split) || (linear_hash->split_in_progress && (bucket_idx == linear_hash->next_split))) {
+		bucket_idx = hash_to_bucket(key, linear_hash);
+	}
+
+	return bucket_idx;
+}
+
 /* ARRAY LIST METHODS */
 /**
 @brief		Initialize an array list
@@ -1466,8 +2032,20 @@ ion_err_t
 linear_hash_close(
 	linear_hash_table_t *linear_hash
 ) {
+	/* finish any split, then write back every dirty bucket and the state before the files are closed */
+	ion_err_t err = linear_hash_split_step(0, linear_hash);
+
+	if (err_ok == err) {
+		err = linear_hash_cache_flush(linear_hash);
+	}
+
+	if (err_ok == err) {
+		err = linear_hash_write_state(linear_hash);
+	}
+
+	linear_hash_cache_free(linear_hash);
+
 	if (0 != fclose(linear_hash->state)) {
-		linear_hash_write_state(linear_hash);
 		return err_file_close_error;
 	}
 
@@ -1487,14 +2065,14 @@ linear_hash_close(
 
 	if (linear_hash->cache != NULL) {
 		free(linear_hash->cache);
-		linear_hash->bucket_map = NULL;
+		linear_hash->cache = NULL;
 	}
 
 	linear_hash->database	= NULL;
 
 	linear_hash->state		= NULL;
 
-	return err_ok;
+	return err;
 }
 
 /**
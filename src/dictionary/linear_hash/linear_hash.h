@@ -33,6 +33,8 @@
 	POSSIBILITY OF SUCH DAMAGE.
 */
 /******************************************************************************/
+#if !defined(LINEAR_HASH_H_)
+#define LINEAR_HASH_H_
 
 #include <stdio.h>
 #include "linear_hash_types.h"
@@ -41,6 +43,23 @@
 #include "../../serial/serial_c_iface.h"
 #endif
 
+/* memory budget, in bytes, of a linear hash's bucket cache unless changed with linear_hash_set_cache_size */
+#if !defined(LINEAR_HASH_DEFAULT_CACHE_SIZE)
+#if defined(ARDUINO)
+#define LINEAR_HASH_DEFAULT_CACHE_SIZE	512
+#else
+#define LINEAR_HASH_DEFAULT_CACHE_SIZE	32768
+#endif
+#endif
+
+/* clock weight a chain head is given on use; any other bucket gains one per use up to this */
+#define LINEAR_HASH_CACHE_HEAD_WEIGHT	3
+
+/* buckets of a splitting chain redistributed per insert unless changed with linear_hash_set_split_work. 0 splits a whole chain at once */
+#if !defined(LINEAR_HASH_DEFAULT_SPLIT_WORK)
+#define LINEAR_HASH_DEFAULT_SPLIT_WORK	0
+#endif
+
 ion_err_t
 linear_hash_init(
 	ion_dictionary_id_t		id,
@@ -97,6 +116,24 @@ split(
 	linear_hash_table_t *linear_hash
 );
 
+ion_err_t
+linear_hash_split_step(
+	int					budget,
+	linear_hash_table_t *linear_hash
+);
+
+ion_err_t
+linear_hash_set_split_work(
+	int					split_work,
+	linear_hash_table_t *linear_hash
+);
+
+int
+linear_hash_bucket_idx(
+	ion_byte_t			*key,
+	linear_hash_table_t *linear_hash
+);
+
 ion_status_t
 linear_hash_insert(
 	ion_key_t			key,
@@ -165,6 +202,57 @@ linear_hash_get_bucket(
 	linear_hash_table_t		*linear_hash
 );
 
+ion_err_t
+linear_hash_cache_init(
+	int					cache_size,
+	linear_hash_table_t *linear_hash
+);
+
+int
+linear_hash_cache_lookup(
+	ion_fpos_t			bucket_loc,
+	linear_hash_table_t *linear_hash
+);
+
+ion_err_t
+linear_hash_cache_flush(
+	linear_hash_table_t *linear_hash
+);
+
+void
+linear_hash_cache_free(
+	linear_hash_table_t *linear_hash
+);
+
+ion_err_t
+linear_hash_set_cache_size(
+	int					cache_size,
+	linear_hash_table_t *linear_hash
+);
+
+ion_err_t
+linear_hash_cache_read(
+	ion_fpos_t			loc,
+	void				*data,
+	int					size,
+	linear_hash_table_t *linear_hash
+);
+
+ion_err_t
+linear_hash_cache_write(
+	ion_fpos_t			loc,
+	void				*data,
+	int					size,
+	linear_hash_table_t *linear_hash
+);
+
+ion_err_t
+linear_hash_read_bucket(
+	ion_fpos_t			bucket_loc,
+	ion_byte_t			*bucket_data,
+	linear_hash_table_t *linear_hash
+);
+
 ion_err_t
 linear_hash_update_bucket(
 	ion_fpos_t				bucket_loc,
@@ -172,6 +260,19 @@ linear_hash_update_bucket(
 	linear_hash_table_t		*linear_hash
 );
 
+ion_err_t
+linear_hash_allocate_bucket(
+	linear_hash_bucket_t	*bucket,
+	ion_fpos_t				*bucket_loc,
+	linear_hash_table_t		*linear_hash
+);
+
+ion_err_t
+linear_hash_free_bucket(
+	ion_fpos_t			bucket_loc,
+	linear_hash_table_t *linear_hash
+);
+
 ion_err_t
 create_overflow_bucket(
 	int					bucket_idx,
@@ -275,3 +376,5 @@ void
 print_linear_hash_distribution(
 	linear_hash_table_t *linear_hash
 );
+
+#endif /* LINEAR_HASH_H_ */
@@ -47,9 +47,10 @@ linear_hash_dict_init(
 	handler->delete_dictionary	= linear_hash_delete_dictionary;
 	handler->destroy_dictionary = linear_hash_destroy_dictionary;
 	handler->update				= linear_hash_dict_update;
-	/* handler->find				= linear_hash_dict_find; */
+	handler->find				= linear_hash_dict_find;
 	handler->close_dictionary	= linear_hash_close_dictionary;
 	handler->open_dictionary	= linear_hash_open_dictionary;
+	handler->get_stats			= linear_hash_dict_get_stats;
 }
 
 ion_status_t
@@ -58,7 +59,14 @@ linear_hash_dict_insert(
 	ion_key_t			key,
 	ion_value_t			value
 ) {
-	return linear_hash_insert(key, value, insert_hash_to_bucket(key, (linear_hash_table_t *) dictionary->instance), (linear_hash_table_t *) dictionary->instance);
+	linear_hash_table_t *linear_hash	= (linear_hash_table_t *) dictionary->instance;
+	ion_status_t		status			= linear_hash_insert(key, value, insert_hash_to_bucket(key, linear_hash), linear_hash);
+
+	if (err_ok == status.error) {
+		linear_hash->stats.num_inserts++;
+	}
+
+	return status;
 }
 
 ion_status_t
@@ -120,7 +128,12 @@ linear_hash_dict_delete(
 	ion_dictionary_t	*dictionary,
 	ion_key_t			key
 ) {
-	return linear_hash_delete(key, (linear_hash_table_t *) dictionary->instance);
+	linear_hash_table_t *linear_hash	= (linear_hash_table_t *) dictionary->instance;
+	ion_status_t		status			= linear_hash_delete(key, linear_hash);
+
+	linear_hash->stats.num_deletes += status.count;
+
+	return status;
 }
 
 ion_err_t
@@ -183,13 +196,246 @@ linear_hash_close_dictionary(
 	return err_ok;
 }
 
-ion_status_t
+ion_err_t
+linear_hash_dict_get_stats(
+	ion_dictionary_t		*dictionary,
+	ion_dictionary_stats_t	*stats
+) {
+	linear_hash_table_t *linear_hash = (linear_hash_table_t *) dictionary->instance;
+
+	*stats				= linear_hash->stats;
+	stats->num_records	= linear_hash->num_records;
+	return err_ok;
+}
+
+/**
+@brief		Moves a cursor onto the next record in bucket order that satisfies
+			its predicate, loading buckets one whole bucket per read.
+@param		lh_cursor
+				The cursor to move. Its held bucket must be loaded.
+@return		err_ok if a record was found, err_file_hit_eof if there are no
+			more, or the status of a failed read.
+*/
+static ion_err_t
+linear_hash_cursor_advance(
+	linear_hash_cursor_t *lh_cursor
+) {
+	linear_hash_table_t		*linear_hash	= (linear_hash_table_t *) lh_cursor->super.dictionary->instance;
+	linear_hash_bucket_t	bucket;
+	ion_byte_t				*record;
+	ion_err_t				err;
+
+	memcpy(&bucket, lh_cursor->bucket, sizeof(linear_hash_bucket_t));
+
+	while (boolean_true) {
+		lh_cursor->record_idx++;
+
+		if (lh_cursor->record_idx < bucket.record_count) {
+			record = lh_cursor->bucket + sizeof(linear_hash_bucket_t) + lh_cursor->record_idx * linear_hash->record_total_size;
+
+			if ((linear_hash_record_status_full == record[0]) && test_predicate(&lh_cursor->super, record + sizeof(ion_byte_t))) {
+				return err_ok;
+			}
+
+			continue;
+		}
+
+		/* an equality match can only be in its own chain; everything else walks the file */
+		if (predicate_equality == lh_cursor->super.predicate->type) {
+			if (linear_hash_end_of_list == bucket.overflow_location) {
+				return err_file_hit_eof;
+			}
+
+			lh_cursor->bucket_loc = bucket.overflow_location;
+		}
+		else {
+			lh_cursor->bucket_loc += LINEAR_HASH_BUCKET_SIZE(linear_hash);
+		}
+
+		err = linear_hash_read_bucket(lh_cursor->bucket_loc, lh_cursor->bucket, linear_hash);
+
+		if (err_ok != err) {
+			return err;
+		}
+
+		memcpy(&bucket, lh_cursor->bucket, sizeof(linear_hash_bucket_t));
+		lh_cursor->record_idx = -1;
+	}
+}
+
+ion_err_t
 linear_hash_dict_find(
-	ion_dictionary_t *dictionary
+	ion_dictionary_t	*dictionary,
+	ion_predicate_t		*predicate,
+	ion_dict_cursor_t	**cursor
 ) {
-	ion_status_t status = ION_STATUS_INITIALIZE;
+	linear_hash_table_t *linear_hash	= (linear_hash_table_t *) dictionary->instance;
+	ion_key_size_t		key_size		= dictionary->instance->record.key_size;
+	ion_err_t			err;
 
-	UNUSED(dictionary);
-	status.error = err_not_implemented;
-	return status;
+	*cursor = malloc(sizeof(linear_hash_cursor_t));
+
+	if (NULL == *cursor) {
+		return err_out_of_memory;
+	}
+
+	linear_hash_cursor_t *lh_cursor = (linear_hash_cursor_t *) (*cursor);
+
+	lh_cursor->bucket = malloc(LINEAR_HASH_BUCKET_SIZE(linear_hash));
+
+	if (NULL == lh_cursor->bucket) {
+		free(*cursor);
+		return err_out_of_memory;
+	}
+
+	(*cursor)->dictionary	= dictionary;
+	(*cursor)->status		= cs_cursor_uninitialized;
+
+	(*cursor)->destroy		= linear_hash_dict_destroy_cursor;
+	(*cursor)->next			= linear_hash_dict_next;
+
+	(*cursor)->predicate	= malloc(sizeof(ion_predicate_t));
+
+	if (NULL == (*cursor)->predicate) {
+		free(lh_cursor->bucket);
+		free(*cursor);
+		return err_out_of_memory;
+	}
+
+	(*cursor)->predicate->type		= predicate->type;
+	(*cursor)->predicate->destroy	= predicate->destroy;
+
+	switch (predicate->type) {
+		case predicate_equality: {
+			ion_key_t target_key = predicate->statement.equality.equality_value;
+
+			(*cursor)->predicate->statement.equality.equality_value = malloc(key_size);
+
+			if (NULL == (*cursor)->predicate->statement.equality.equality_value) {
+				free((*cursor)->predicate);
+				free(lh_cursor->bucket);
+				free(*cursor);
+				return err_out_of_memory;
+			}
+
+			memcpy((*cursor)->predicate->statement.equality.equality_value, target_key, key_size);
+
+			/* start at the head of the chain the key hashes to */
+			lh_cursor->bucket_loc = bucket_idx_to_ion_fpos_t(linear_hash_bucket_idx(target_key, linear_hash), linear_hash);
+			break;
+		}
+
+		case predicate_range: {
+			(*cursor)->predicate->statement.range.lower_bound = malloc(key_size);
+
+			if (NULL == (*cursor)->predicate->statement.range.lower_bound) {
+				free((*cursor)->predicate);
+				free(lh_cursor->bucket);
+				free(*cursor);
+				return err_out_of_memory;
+			}
+
+			memcpy((*cursor)->predicate->statement.range.lower_bound, predicate->statement.range.lower_bound, key_size);
+
+			(*cursor)->predicate->statement.range.upper_bound = malloc(key_size);
+
+			if (NULL == (*cursor)->predicate->statement.range.upper_bound) {
+				free((*cursor)->predicate->statement.range.lower_bound);
+				free((*cursor)->predicate);
+				free(lh_cursor->bucket);
+				free(*cursor);
+				return err_out_of_memory;
+			}
+
+			memcpy((*cursor)->predicate->statement.range.upper_bound, predicate->statement.range.upper_bound, key_size);
+
+			/* a hash has no key order, so a range is a filtered scan of every bucket */
+			lh_cursor->bucket_loc = 0;
+			break;
+		}
+
+		case predicate_all_records: {
+			lh_cursor->bucket_loc = 0;
+			break;
+		}
+
+		default: {
+			free((*cursor)->predicate);
+			free(lh_cursor->bucket);
+			free(*cursor);
+			*cursor = NULL;
+			return err_invalid_predicate;
+		}
+	}
+
+	lh_cursor->record_idx	= -1;
+	err						= linear_hash_read_bucket(lh_cursor->bucket_loc, lh_cursor->bucket, linear_hash);
+
+	if (err_ok == err) {
+		err = linear_hash_cursor_advance(lh_cursor);
+	}
+
+	if (err_ok == err) {
+		(*cursor)->status = cs_cursor_initialized;
+	}
+	else if (err_file_hit_eof == err) {
+		(*cursor)->status = cs_end_of_results;
+	}
+	else {
+		/* frees the predicate copies, the bucket and the cursor */
+		linear_hash_dict_destroy_cursor(cursor);
+		return err;
+	}
+
+	return err_ok;
+}
+
+ion_cursor_status_t
+linear_hash_dict_next(
+	ion_dict_cursor_t	*cursor,
+	ion_record_t		*record
+) {
+	linear_hash_cursor_t	*lh_cursor		= (linear_hash_cursor_t *) cursor;
+	linear_hash_table_t		*linear_hash	= (linear_hash_table_t *) cursor->dictionary->instance;
+
+	if ((cursor->status == cs_cursor_uninitialized) || (cursor->status == cs_end_of_results)) {
+		return cursor->status;
+	}
+	else if ((cursor->status == cs_cursor_initialized) || (cursor->status == cs_cursor_active)) {
+		if (cursor->status == cs_cursor_active) {
+			ion_err_t err = linear_hash_cursor_advance(lh_cursor);
+
+			if (err_file_hit_eof == err) {
+				cursor->status = cs_end_of_results;
+				return cursor->status;
+			}
+			else if (err_ok != err) {
+				cursor->status = cs_possible_data_inconsistency;
+				return cursor->status;
+			}
+		}
+		else {
+			/* The status is cs_cursor_initialized */
+			cursor->status = cs_cursor_active;
+		}
+
+		ion_byte_t *found = lh_cursor->bucket + sizeof(linear_hash_bucket_t) + lh_cursor->record_idx * linear_hash->record_total_size + sizeof(ion_byte_t);
+
+		memcpy(record->key, found, linear_hash->super.record.key_size);
+		memcpy(record->value, found + linear_hash->super.record.key_size, linear_hash->super.record.value_size);
+
+		return cursor->status;
+	}
+
+	return cs_invalid_cursor;
+}
+
+void
+linear_hash_dict_destroy_cursor(
+	ion_dict_cursor_t **cursor
+) {
+	(*cursor)->predicate->destroy(&(*cursor)->predicate);
+	free(((linear_hash_cursor_t *) (*cursor))->bucket);
+	free(*cursor);
+	*cursor = NULL;
 }
@@ -193,9 +193,69 @@ linear_hash_dict_update(
 	ion_value_t			value
 );
 
-ion_status_t
+/**
+@brief	  Reports the performance counters of a linear hash instance.
+
+@param	  dictionary
+				The instance of the dictionary to report on.
+@param	  stats
+				The statistics to fill in.
+@return	 Status of the retrieval.
+*/
+ion_err_t
+linear_hash_dict_get_stats(
+	ion_dictionary_t		*dictionary,
+	ion_dictionary_stats_t	*stats
+);
+
+/**
+@brief	  Opens a cursor over the records of a linear hash that satisfy
+			@p predicate.
+
+@details	Records come back in bucket order, not key order. An equality
+			cursor only reads the bucket chain its key hashes to; range and
+			all-records cursors stream the whole data file front to back.
+			Each bucket is read from the file in a single read.
+
+@param	  dictionary
+				The instance of the dictionary to search.
+@param	  predicate
+				The predicate records must satisfy. It is copied.
+@param	  cursor
+				Pointer the new cursor is written back to.
+@return	 Status of the search.
+*/
+ion_err_t
 linear_hash_dict_find(
-	ion_dictionary_t *dictionary
+	ion_dictionary_t	*dictionary,
+	ion_predicate_t		*predicate,
+	ion_dict_cursor_t	**cursor
+);
+
+/**
+@brief	  Moves @p cursor to its next record and copies that record out.
+
+@param	  cursor
+				The cursor to advance.
+@param	  record
+				The key and value buffers the record is written back to.
+@return	 Status of the cursor.
+*/
+ion_cursor_status_t
+linear_hash_dict_next(
+	ion_dict_cursor_t	*cursor,
+	ion_record_t		*record
+);
+
+/**
+@brief	  Frees a cursor and its predicate, and nulls the pointer.
+
+@param	  cursor
+				Pointer to the cursor to destroy.
+*/
+void
+linear_hash_dict_destroy_cursor(
+	ion_dict_cursor_t **cursor
 );
 
 #if defined(__cplusplus)
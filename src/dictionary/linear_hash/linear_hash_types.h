@@ -33,6 +33,8 @@
 	POSSIBILITY OF SUCH DAMAGE.
 */
 /******************************************************************************/
+#if !defined(LINEAR_HASH_TYPES_H_)
+#define LINEAR_HASH_TYPES_H_
 
 #include <stdio.h>
 #include "../../key_value/kv_system.h"
@@ -64,6 +66,29 @@ typedef struct {
 	ion_fpos_t	overflow_location;
 } linear_hash_bucket_t;
 
+/* a bucket page held in the bucket cache */
+typedef struct {
+	/* location of the bucket in the .lhd file, or linear_hash_end_of_list if the frame is free */
+	ion_fpos_t	bucket_loc;
+	/* next frame in the same hash slot, or -1 */
+	int			next;
+	/* set while the page holds changes not yet written to the file */
+	ion_byte_t	dirty;
+	/* clock weight, raised on every use; the frame is evicted once the clock hand wears it to zero */
+	ion_byte_t	weight;
+} linear_hash_frame_t;
+
+/* write-back cache of whole bucket pages */
+typedef struct {
+	int					num_frames;
+	int					clock_hand;
+	linear_hash_frame_t *frames;
+	/* first frame of each hash slot, or -1 */
+	int					*slots;
+	/* num_frames bucket pages, one per frame */
+	ion_byte_t			*pages;
+} linear_hash_bucket_cache_t;
+
 /* function pointer syntax: return_type (*function_name) (arg_type) */
 /* linear hash structure definition, with a type and pointer instance declared for later use */
 typedef struct {
@@ -87,11 +112,42 @@ typedef struct {
 	ion_byte_t				*cache;
 	int						last_cache_idx;
 
+	/* bucket pages kept in memory, and the end of the .lhd file including pages not yet written */
+	linear_hash_bucket_cache_t	bucket_cache;
+	ion_fpos_t					database_size;
+
+	/* head of the list of buckets a split has emptied, linked through overflow_location, reused before the file grows */
+	ion_fpos_t				free_list;
+
+	/* buckets of the chain being split that are redistributed per insert, or 0 to split a whole chain at once */
+	int						split_work;
+	ion_boolean_t			split_in_progress;
+	/* the part of the chain at next_split not yet redistributed. Until it is consumed both halves of the split end in it */
+	ion_fpos_t				split_remainder;
+	/* oldest bucket each half of the split owns, whose overflow_location points at split_remainder */
+	ion_fpos_t				split_tail[2];
+
+	/* performance counters */
+	ion_dictionary_stats_t	stats;
+
 	/* pointer location of the next record to swap-on-delete*/
 	ion_fpos_t				swap_bucket_loc;
 } linear_hash_table_t;
 
-/* typedef struct { */
-/*	ion_fpos_t	next; */
-/*	ion_fpos_t	current_bucket_loc; */
-/* } linear_hash_record_iterator_t; */
+/* space a bucket takes in the .lhd file. Records are packed record_total_size apart, but each slot was
+ * allocated with an int-sized status, so buckets are laid out this far apart */
+#define LINEAR_HASH_BUCKET_SIZE(linear_hash) (sizeof(linear_hash_bucket_t) + (linear_hash)->records_per_bucket * ((linear_hash)->super.record.key_size + (linear_hash)->super.record.value_size + sizeof(linear_hash_record_status_empty)))
+
+/* cursor over a linear hash, holding one whole bucket in memory at a time */
+typedef struct {
+	/**> Supertype of the dictionary cursor. */
+	ion_dict_cursor_t	super;
+	/**> Location in the .lhd file of the bucket held in bucket. */
+	ion_fpos_t			bucket_loc;
+	/**> Slot within the held bucket of the current record. */
+	int					record_idx;
+	/**> Image of the held bucket, header first. */
+	ion_byte_t			*bucket;
+} linear_hash_cursor_t;
+
+#endif /* LINEAR_HASH_TYPES_H_ */
@@ -40,17 +40,510 @@
 */
 /******************************************************************************/
 
+/* fileno, mmap and posix_madvise under -std=c99 */
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include "open_address_file_hash.h"
 
+#if OAFH_HAS_MMAP
+#include <sys/mman.h>
+#endif
+
 #define ION_TEST_FILE "file.bin"
 
+/**
+@brief		Hashes a key to a slot of the map.
+@details	Uses the full-key hash chosen for the dictionary if there is one,
+			otherwise the map's own @c compute_hash.
+@param		hash_map
+				The map the key is placed in.
+@param		key
+				The key to hash.
+@return		The slot, in [0, map_size).
+*/
+static ion_hash_t
+oafh_compute_hash(
+	ion_file_hashmap_t	*hash_map,
+	ion_key_t			key
+) {
+	if (NULL != hash_map->super.hash) {
+		return (ion_hash_t) (hash_map->super.hash(key, hash_map->super.record.key_size) % (uint64_t) hash_map->map_size);
+	}
+
+	return hash_map->compute_hash(hash_map, key, hash_map->super.record.key_size);
+}
+
+/**
+@brief		Returns the item at @p loc of the map, reading the block it is in
+			from the file unless that block is held already.
+@details	The item stays valid until another block is read.
+@return		The item, or NULL if the block could not be read.
+*/
+static ion_hash_bucket_t *
+oafh_slot(
+	ion_file_hashmap_t	*hash_map,
+	int					loc
+) {
+	int					record_size = hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
+	int					block		= loc / hash_map->block_slots;
+	int					first		= block * hash_map->block_slots;
+	int					num_slots	= hash_map->block_slots;
+	int					victim		= 0;
+	int					i;
+	ion_oafh_frame_t	*frame;
+
+	if (NULL != hash_map->mapping) {
+		hash_map->stats.cache_hits++;
+		return (ion_hash_bucket_t *) (hash_map->mapping + loc * record_size);
+	}
+
+	for (i = 0; i < hash_map->num_frames; i++) {
+		frame = &hash_map->frames[i];
+
+		if (frame->block == block) {
+			hash_map->stats.cache_hits++;
+			frame->last_use = ++hash_map->use_clock;
+			return (ion_hash_bucket_t *) (hash_map->blocks + (i * hash_map->block_slots + loc - first) * record_size);
+		}
+
+		if ((-1 != hash_map->frames[victim].block) && ((-1 == frame->block) || (frame->last_use < hash_map->frames[victim].last_use))) {
+			victim = i;
+		}
+	}
+
+	/* the last block stops at the end of the file */
+	if (first + num_slots > hash_map->map_size) {
+		num_slots = hash_map->map_size - first;
+	}
+
+	frame			= &hash_map->frames[victim];
+	frame->block	= -1;
+	hash_map->stats.cache_misses++;
+	hash_map->stats.num_reads++;
+
+	if ((0 != fseek(hash_map->file, first * record_size, SEEK_SET)) || (1 != fread(hash_map->blocks + victim * hash_map->block_slots * record_size, num_slots * record_size, 1, hash_map->file))) {
+		return NULL;
+	}
+
+	hash_map->stats.bytes_read	+= num_slots * record_size;
+	frame->block				= block;
+	frame->last_use				= ++hash_map->use_clock;
+	return (ion_hash_bucket_t *) (hash_map->blocks + (victim * hash_map->block_slots + loc - first) * record_size);
+}
+
+/**
+@brief		Writes @p size bytes from @p offset of @p item, the map's copy of
+			the item at @p loc, to the file.
+*/
+static ion_err_t
+oafh_write_back(
+	ion_file_hashmap_t	*hash_map,
+	int					loc,
+	ion_hash_bucket_t	*item,
+	int					offset,
+	int					size
+) {
+	int record_size = hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
+
+	/* a mapped item was changed in place */
+	if (NULL != hash_map->mapping) {
+		return err_ok;
+	}
+
+	hash_map->stats.num_writes++;
+
+	if ((0 != fseek(hash_map->file, loc * record_size + offset, SEEK_SET)) || (1 != fwrite((ion_byte_t *) item + offset, size, 1, hash_map->file))) {
+		return err_file_write_error;
+	}
+
+	hash_map->stats.bytes_written += size;
+	return err_ok;
+}
+
+/**
+@brief		Copies the item at @p loc of the map into @p item.
+*/
+static ion_err_t
+oafh_read_slot(
+	ion_file_hashmap_t	*hash_map,
+	int					loc,
+	ion_hash_bucket_t	*item
+) {
+	ion_hash_bucket_t *slot = oafh_slot(hash_map, loc);
+
+	if (NULL == slot) {
+		return err_file_read_error;
+	}
+
+	memcpy(item, slot, hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS));
+	return err_ok;
+}
+
+/**
+@brief		Writes @p item over the item at @p loc of the map.
+*/
+static ion_err_t
+oafh_write_slot(
+	ion_file_hashmap_t	*hash_map,
+	int					loc,
+	ion_hash_bucket_t	*item
+) {
+	int					record_size = hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
+	ion_hash_bucket_t	*slot		= oafh_slot(hash_map, loc);
+
+	if (NULL == slot) {
+		return err_file_read_error;
+	}
+
+	memcpy(slot, item, record_size);
+	return oafh_write_back(hash_map, loc, slot, 0, record_size);
+}
+
+/**
+@brief		Returns how far the record @p item, read from @p loc, sits from
+			its home slot.
+*/
+static int
+oafh_displacement(
+	ion_file_hashmap_t	*hash_map,
+	ion_hash_bucket_t	*item,
+	int					loc
+) {
+	int home = oafh_get_location(oafh_compute_hash(hash_map, item->data), hash_map->map_size);
+
+	return (loc - home + hash_map->map_size) % hash_map->map_size;
+}
+
+/**
+@brief		Inserts a record into a robin hood map.
+@details	The record takes the slot of the first record nearer its own home
+			slot than the one being placed, which then moves on in its place.
+			The key has already been looked for. Records only move towards
+			the first free slot after the home slot, so that slot is found
+			before anything is moved and a full map is left as it was.
+*/
+static ion_status_t
+oafh_robin_hood_insert(
+	ion_file_hashmap_t	*hash_map,
+	ion_key_t			key,
+	ion_value_t			value
+) {
+	int					key_size	= hash_map->super.record.key_size;
+	int					record_size = key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
+	int					loc			= oafh_get_location(oafh_compute_hash(hash_map, key), hash_map->map_size);
+	int					distance	= 0;
+	int					count		= 0;
+	int					resident;
+	ion_err_t			err			= err_max_capacity;
+	/* the record being placed, then room to read each slot into */
+	ion_hash_bucket_t	*carry		= (ion_hash_bucket_t *) hash_map->scratch;
+	ion_hash_bucket_t	*item		= (ion_hash_bucket_t *) (hash_map->scratch + record_size);
+
+	for (; count != hash_map->map_size; count++) {
+		if (err_ok != oafh_read_slot(hash_map, (loc + count) % hash_map->map_size, item)) {
+			return ION_STATUS_ERROR(err_file_read_error);
+		}
+
+		if (item->status != ION_IN_USE) {
+			break;
+		}
+	}
+
+	if (count == hash_map->map_size) {
+		return ION_STATUS_ERROR(err_max_capacity);
+	}
+
+	carry->status	= ION_IN_USE;
+	memcpy(carry->data, key, key_size);
+	memcpy(carry->data + key_size, value, hash_map->super.record.value_size);
+
+	for (count = 0; count != hash_map->map_size; count++) {
+		if (err_ok != oafh_read_slot(hash_map, loc, item)) {
+			err = err_file_read_error;
+			break;
+		}
+
+		if (item->status != ION_IN_USE) {
+			err = oafh_write_slot(hash_map, loc, carry);
+
+			if ((err_ok == err) && (distance > (int) hash_map->stats.max_displacement)) {
+				hash_map->stats.max_displacement = distance;
+			}
+
+			break;
+		}
+
+		resident = oafh_displacement(hash_map, item, loc);
+
+		if (resident < distance) {
+			if (err_ok != oafh_write_slot(hash_map, loc, carry)) {
+				err = err_file_write_error;
+				break;
+			}
+
+			if (distance > (int) hash_map->stats.max_displacement) {
+				hash_map->stats.max_displacement = distance;
+			}
+
+			memcpy(carry, item, record_size);
+			distance = resident;
+		}
+
+		distance++;
+		loc = (loc + 1) % hash_map->map_size;
+	}
+
+	if (err_ok != err) {
+		return ION_STATUS_ERROR(err);
+	}
+
+	hash_map->stats.num_inserts++;
+	return ION_STATUS_OK(1);
+}
+
+ion_err_t
+oafh_set_robin_hood(
+	ion_file_hashmap_t	*hash_map,
+	ion_boolean_t		robin_hood
+) {
+	int					key_size	= hash_map->super.record.key_size;
+	int					record_size = key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
+	ion_hash_bucket_t	*item		= (ion_hash_bucket_t *) hash_map->scratch;
+	ion_byte_t			*records;
+	ion_byte_t			*record;
+	ion_status_t		status;
+	int					num_records = 0;
+	int					i;
+
+	if (!robin_hood || hash_map->robin_hood) {
+		hash_map->robin_hood = robin_hood;
+		return err_ok;
+	}
+
+	for (i = 0; i < hash_map->map_size; i++) {
+		if (err_ok != oafh_read_slot(hash_map, i, item)) {
+			return err_file_read_error;
+		}
+
+		if (ION_IN_USE == item->status) {
+			num_records++;
+		}
+	}
+
+	records = NULL;
+
+	if ((num_records > 0) && (NULL == (records = malloc((size_t) num_records * (record_size - SIZEOF(STATUS)))))) {
+		return err_out_of_memory;
+	}
+
+	/* records placed by linear probing are taken out of the file and placed again in robin hood order */
+	record = records;
+
+	for (i = 0; i < hash_map->map_size; i++) {
+		if (err_ok != oafh_read_slot(hash_map, i, item)) {
+			free(records);
+			return err_file_read_error;
+		}
+
+		if (ION_EMPTY == item->status) {
+			continue;
+		}
+
+		if (ION_IN_USE == item->status) {
+			memcpy(record, item->data, record_size - SIZEOF(STATUS));
+			record += record_size - SIZEOF(STATUS);
+		}
+
+		item->status = ION_EMPTY;
+
+		if (err_ok != oafh_write_slot(hash_map, i, item)) {
+			free(records);
+			return err_file_write_error;
+		}
+	}
+
+	hash_map->robin_hood				= boolean_true;
+	hash_map->stats.max_displacement	= 0;
+
+	for (i = 0, record = records; i < num_records; i++, record += record_size - SIZEOF(STATUS)) {
+		status = oafh_robin_hood_insert(hash_map, record, record + key_size);
+
+		if (err_ok != status.error) {
+			free(records);
+			return status.error;
+		}
+	}
+
+	/* placing the records again is not counted as inserting them */
+	hash_map->stats.num_inserts -= num_records;
+	free(records);
+	return err_ok;
+}
+
+/**
+@brief		Frees the blocks the map holds in memory.
+*/
+static void
+oafh_free_block_cache(
+	ion_file_hashmap_t *hash_map
+) {
+	free(hash_map->frames);
+	free(hash_map->blocks);
+	free(hash_map->scratch);
+	hash_map->frames	= NULL;
+	hash_map->blocks	= NULL;
+	hash_map->scratch	= NULL;
+	hash_map->num_frames = 0;
+}
+
+ion_err_t
+oafh_set_block_cache(
+	ion_file_hashmap_t	*hash_map,
+	int					block_size,
+	int					num_blocks
+) {
+	int					record_size = hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
+	int					block_slots = block_size / record_size;
+	int					i;
+	ion_oafh_frame_t	*frames;
+	ion_byte_t			*blocks;
+	ion_byte_t			*scratch;
+
+	if ((block_size <= 0) || (num_blocks <= 0)) {
+		return err_out_of_bounds;
+	}
+
+	if (block_slots < 1) {
+		block_slots = 1;
+	}
+
+	/* a block never needs to be longer than the file */
+	if ((hash_map->map_size > 0) && (block_slots > hash_map->map_size)) {
+		block_slots = hash_map->map_size;
+	}
+
+	frames	= malloc(num_blocks * sizeof(ion_oafh_frame_t));
+	blocks	= malloc(num_blocks * block_slots * record_size);
+	scratch = malloc(2 * record_size);
+
+	if ((NULL == frames) || (NULL == blocks) || (NULL == scratch)) {
+		free(frames);
+		free(blocks);
+		free(scratch);
+		return err_out_of_memory;
+	}
+
+	for (i = 0; i < num_blocks; i++) {
+		frames[i].block		= -1;
+		frames[i].last_use	= 0;
+	}
+
+	oafh_free_block_cache(hash_map);
+	hash_map->block_slots	= block_slots;
+	hash_map->num_frames	= num_blocks;
+	hash_map->frames		= frames;
+	hash_map->blocks		= blocks;
+	hash_map->scratch		= scratch;
+	hash_map->use_clock		= 0;
+	return err_ok;
+}
+
+/**
+@brief		Writes a mapped map's pages back to its file and unmaps it.
+*/
+static ion_err_t
+oafh_unmap(
+	ion_file_hashmap_t *hash_map
+) {
+	ion_err_t err = err_ok;
+
+#if OAFH_HAS_MMAP
+	size_t length = (size_t) hash_map->map_size * (hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS));
+
+	if (NULL == hash_map->mapping) {
+		return err_ok;
+	}
+
+	if (0 != msync(hash_map->mapping, length, MS_SYNC)) {
+		err = err_file_write_error;
+	}
+
+	munmap(hash_map->mapping, length);
+	hash_map->mapping = NULL;
+#else
+	UNUSED(hash_map);
+#endif
+	return err;
+}
+
+ion_err_t
+oafh_set_mmap(
+	ion_file_hashmap_t	*hash_map,
+	ion_boolean_t		use_mmap
+) {
+	int i;
+
+	if (use_mmap == (NULL != hash_map->mapping)) {
+		return err_ok;
+	}
+
+	/* blocks held from before the switch may be stale after it */
+	for (i = 0; i < hash_map->num_frames; i++) {
+		hash_map->frames[i].block = -1;
+	}
+
+	if (!use_mmap) {
+		return oafh_unmap(hash_map);
+	}
+
+#if OAFH_HAS_MMAP
+	size_t	length = (size_t) hash_map->map_size * (hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS));
+	void	*mapping;
+
+	if ((0 == length) || (0 != fflush(hash_map->file))) {
+		return err_file_open_error;
+	}
+
+	mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fileno(hash_map->file), 0);
+
+	if (MAP_FAILED == mapping) {
+		return err_file_open_error;
+	}
+
+	/* probes land anywhere in the file, so read-ahead only wastes pages */
+	posix_madvise(mapping, length, POSIX_MADV_RANDOM);
+	hash_map->mapping = mapping;
+	return err_ok;
+#else
+	return err_not_implemented;
+#endif
+}
+
+ion_err_t
+oafh_flush(
+	ion_file_hashmap_t *hash_map
+) {
+#if OAFH_HAS_MMAP
+
+	if (NULL != hash_map->mapping) {
+		return 0 == msync(hash_map->mapping, (size_t) hash_map->map_size * (hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS)), MS_SYNC) ? err_ok : err_file_write_error;
+	}
+
+#endif
+	return 0 == fflush(hash_map->file) ? err_ok : err_file_write_error;
+}
+
 ion_err_t
 oafh_close(
 	ion_file_hashmap_t *hash_map
 ) {
 	if (NULL != hash_map->file) {
 		/* check to ensure that you are not freeing something already free */
+		oafh_unmap(hash_map);
 		fclose(hash_map->file);
+		oafh_free_block_cache(hash_map);
 		free(hash_map);
 		return err_ok;
 	}
@@ -73,10 +566,24 @@ oafh_initialize(
 	hashmap->super.record.key_size		= key_size;
 	hashmap->super.record.value_size	= value_size;
 	hashmap->super.key_type				= key_type;
+	hashmap->super.hash_type			= dictionary_hash_type_builtin;
+	hashmap->super.hash					= NULL;
+	hashmap->robin_hood					= boolean_false;
+	memset(&hashmap->stats, 0, sizeof(hashmap->stats));
 
 	/* The hash map is allocated as a single contiguous file*/
 	hashmap->map_size					= size;
 
+	hashmap->num_frames					= 0;
+	hashmap->frames						= NULL;
+	hashmap->blocks						= NULL;
+	hashmap->scratch					= NULL;
+	hashmap->mapping					= NULL;
+
+	if (err_ok != oafh_set_block_cache(hashmap, OAFH_DEFAULT_BLOCK_SIZE, OAFH_DEFAULT_CACHE_BLOCKS)) {
+		return err_out_of_memory;
+	}
+
 	hashmap->compute_hash				= (*hashing_function);	/* Allows for binding of different hash functions
 																depending on requirements */
 
@@ -86,6 +593,7 @@ oafh_initialize(
 	int actual_filename_length = dictionary_get_filename(id, "oaf", addr_filename);
 
 	if (actual_filename_length >= ION_MAX_FILENAME_LENGTH) {
+		oafh_free_block_cache(hashmap);
 		return err_uninitialized;
 	}
 
@@ -156,9 +664,11 @@ oafh_destroy(
 
 	if (hash_map->file != NULL) {
 		/* check to ensure that you are not freeing something already free */
+		oafh_unmap(hash_map);
 		fclose(hash_map->file);
 		fremove(addr_filename);
 		hash_map->file = NULL;
+		oafh_free_block_cache(hash_map);
 		return err_ok;
 	}
 	else {
@@ -188,27 +698,56 @@ oafh_insert(
 	ion_key_t			key,
 	ion_value_t			value
 ) {
-	ion_hash_t hash = hash_map->compute_hash(hash_map, key, hash_map->super.record.key_size);	/* compute hash value for given key */
+	ion_hash_bucket_t *item;
+
+	if (hash_map->robin_hood) {
+		int loc;
+
+		if (err_ok != oafh_find_item_loc(hash_map, key, &loc)) {
+			return oafh_robin_hood_insert(hash_map, key, value);
+		}
+		else if (hash_map->write_concern == wc_insert_unique) {
+			return ION_STATUS_ERROR(err_duplicate_key);
+		}
+		else if (hash_map->write_concern != wc_update) {
+			return ION_STATUS_ERROR(err_file_write_error);	/* there is a configuration issue with write concern */
+		}
+
+		item = oafh_slot(hash_map, loc);
+
+		if (NULL == item) {
+			return ION_STATUS_ERROR(err_file_read_error);
+		}
+
+		/* write back the value only */
+		memcpy(item->data + hash_map->super.record.key_size, value, hash_map->super.record.value_size);
+
+		ion_err_t err = oafh_write_back(hash_map, loc, item, SIZEOF(STATUS) + hash_map->super.record.key_size, hash_map->super.record.value_size);
+
+		return err_ok == err ? ION_STATUS_OK(1) : ION_STATUS_ERROR(err);
+	}
+
+	ion_hash_t hash = oafh_compute_hash(hash_map, key);	/* compute hash value for given key */
 
 	int loc			= oafh_get_location(hash, hash_map->map_size);
 
 	/* Scan until find an empty location - oah_insert if found */
 	int count		= 0;
 
-	ion_hash_bucket_t *item;
-
 	int record_size = hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
 
-	item = malloc(record_size);
+	ion_err_t err;
 
-	/* set file position */
-	fseek(hash_map->file, loc * record_size, SEEK_SET);
+	hash_map->stats.num_lookups++;
 
 	while (count != hash_map->map_size) {
-		fread(item, record_size, 1, hash_map->file);
-#if ION_DEBUG
-		DUMP((int) ftell(hash_map->file), "%i");
-#endif
+		item = oafh_slot(hash_map, loc);
+
+		if (NULL == item) {
+			return ION_STATUS_ERROR(err_file_read_error);
+		}
+
+		hash_map->stats.num_probes++;
 
 		if (item->status == ION_IN_USE) {
 			/* if a cell is in use, need to key to */
@@ -216,40 +755,39 @@ oafh_insert(
 			if (hash_map->super.compare(item->data, key, hash_map->super.record.key_size) == ION_IS_EQUAL) {
 				if (hash_map->write_concern == wc_insert_unique) {
 					/* allow unique entries only */
-					free(item);
 					return ION_STATUS_ERROR(err_duplicate_key);
 				}
 				else if (hash_map->write_concern == wc_update) {
-					/* allows for values to be updated											// */
-					/* backup and write */
-					fseek(hash_map->file, SIZEOF(STATUS) + hash_map->super.record.key_size - record_size, SEEK_CUR);
-#if ION_DEBUG
-					DUMP((int) ftell(hash_map->file), "%i");
-					DUMP(value, "%s");
-#endif
-					fwrite(value, hash_map->super.record.value_size, 1, hash_map->file);
-					free(item);
-					return ION_STATUS_OK(1);
+					/* allows for values to be updated */
+					/* write back the value only */
+					memcpy(item->data + hash_map->super.record.key_size, value, hash_map->super.record.value_size);
+					err = oafh_write_back(hash_map, loc, item, SIZEOF(STATUS) + hash_map->super.record.key_size, hash_map->super.record.value_size);
+					return err_ok == err ? ION_STATUS_OK(1) : ION_STATUS_ERROR(err);
 				}
 				else {
-					free(item);
 					return ION_STATUS_ERROR(err_file_write_error);	/* there is a configuration issue with write concern */
 				}
 			}
 		}
 		else if ((item->status == ION_EMPTY) || (item->status == ION_DELETED)) {
 			/* problem is here with base types as it is just an array of data.  Need better way */
-			/* printf("empty\n"); */
-			fseek(hash_map->file, -record_size, SEEK_CUR);
 #if ION_DEBUG
-			DUMP((int) ftell(hash_map->file), "%i");
+			DUMP(loc, "%i");
 #endif
 			item->status = ION_IN_USE;
 			memcpy(item->data, key, (hash_map->super.record.key_size));
 			memcpy(item->data + hash_map->super.record.key_size, value, (hash_map->super.record.value_size));
-			fwrite(item, record_size, 1, hash_map->file);
-			free(item);
+			err = oafh_write_back(hash_map, loc, item, 0, record_size);
+
+			if (err_ok != err) {
+				return ION_STATUS_ERROR(err);
+			}
 
+			if (count > (int) hash_map->stats.max_displacement) {
+				hash_map->stats.max_displacement = count;
+			}
+
+			hash_map->stats.num_inserts++;
 			return ION_STATUS_OK(1);
 		}
 
@@ -258,8 +796,6 @@ oafh_insert(
 		if (loc >= hash_map->map_size) {
 			/* Perform wrapping */
 			loc = 0;
-			/* rewind the file */
-			frewind(hash_map->file);
 		}
 
 #if ION_DEBUG
@@ -271,7 +807,6 @@ oafh_insert(
 #if ION_DEBUG
 	printf("Hash table full.  Insert not done");
 #endif
-	free(item);
 	return ION_STATUS_ERROR(err_max_capacity);
 }
 
@@ -281,7 +816,7 @@ oafh_find_item_loc(
 	ion_key_t			key,
 	int					*location
 ) {
-	ion_hash_t hash = hash_map->compute_hash(hash_map, key, hash_map->super.record.key_size);
+	ion_hash_t hash = oafh_compute_hash(hash_map, key);
 	/* compute hash value for given key */
 
 	int loc			= oafh_get_location(hash, hash_map->map_size);
@@ -291,20 +826,19 @@ oafh_find_item_loc(
 
 	ion_hash_bucket_t *item;
 
-	int record_size = hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
-
-	item = malloc(record_size);
-
-	/* set file position */
-	fseek(hash_map->file, loc * record_size, SEEK_SET);
+	hash_map->stats.num_lookups++;
 
 	/* needs to traverse file again */
 	while (count != hash_map->map_size) {
-		fread(&item->status, SIZEOF(STATUS), 1, hash_map->file);
-		fread(item->data, record_size - SIZEOF(STATUS), 1, hash_map->file);
+		item = oafh_slot(hash_map, loc);
+
+		if (NULL == item) {
+			return err_file_read_error;
+		}
+
+		hash_map->stats.num_probes++;
 
 		if (item->status == ION_EMPTY) {
-			free(item);
 			return err_item_not_found;	/* if you hit an empty cell, exit */
 		}
 		else {
@@ -315,9 +849,13 @@ oafh_find_item_loc(
 
 				if (ION_IS_EQUAL == key_is_equal) {
 					(*location) = loc;
-					free(item);
 					return err_ok;
 				}
+
+				/* a robin hood map would have placed the key before any record nearer its home */
+				if (hash_map->robin_hood && (oafh_displacement(hash_map, item, loc) < count)) {
+					break;
+				}
 			}
 
 			loc++;
@@ -326,15 +864,65 @@ oafh_find_item_loc(
 			if (loc >= hash_map->map_size) {
 				/* Perform wrapping */
 				loc = 0;
-				frewind(hash_map->file);
 			}
 		}
 	}
 
-	free(item);
 	return err_item_not_found;	/* key have not been found */
 }
 
+/**
+@brief		Deletes the record at @p loc of a robin hood map.
+@details	Every following record not already in its home slot moves back
+			one slot, so no tombstone is left.
+@param		hash_map
+				The map deleted from.
+@param		loc
+				The slot of the record.
+@return		The status of the delete.
+*/
+static ion_err_t
+oafh_shift_back(
+	ion_file_hashmap_t	*hash_map,
+	int					loc
+) {
+	ion_hash_bucket_t	*item = (ion_hash_bucket_t *) hash_map->scratch;
+	ion_err_t			err;
+	int					next;
+	int					count;
+
+	for (count = 1; count < hash_map->map_size; count++) {
+		next	= (loc + 1) % hash_map->map_size;
+		err		= oafh_read_slot(hash_map, next, item);
+
+		if (err_ok != err) {
+			return err;
+		}
+
+		if ((item->status != ION_IN_USE) || (0 == oafh_displacement(hash_map, item, next))) {
+			break;
+		}
+
+		err = oafh_write_slot(hash_map, loc, item);
+
+		if (err_ok != err) {
+			return err;
+		}
+
+		loc = next;
+	}
+
+	/* the last record moved, or the deleted one, leaves an empty slot */
+	item = oafh_slot(hash_map, loc);
+
+	if (NULL == item) {
+		return err_file_read_error;
+	}
+
+	item->status = ION_EMPTY;
+	return oafh_write_back(hash_map, loc, item, 0, SIZEOF(STATUS));
+}
+
 ion_status_t
 oafh_delete(
 	ion_file_hashmap_t	*hash_map,
@@ -342,7 +930,7 @@ oafh_delete(
 ) {
 	int loc;
 
-	if (oafh_find_item_loc(hash_map, key, &loc) == err_item_not_found) {
+	if (oafh_find_item_loc(hash_map, key, &loc) != err_ok) {
 #if ION_DEBUG
 		printf("Item not found when trying to oah_delete.\n");
 #endif
@@ -350,30 +938,29 @@ oafh_delete(
 	}
 	else {
 		/* locate item */
-		ion_hash_bucket_t *item;
+		ion_hash_bucket_t	*item;
+		ion_err_t			err;
 
-		int record_size = hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
+		hash_map->stats.num_deletes++;
 
-		item = malloc(record_size);
-
-		/* set file position */
-		fseek(hash_map->file, loc * record_size, SEEK_SET);
+		if (hash_map->robin_hood) {
+			err = oafh_shift_back(hash_map, loc);
+			return err_ok == err ? ION_STATUS_OK(1) : ION_STATUS_ERROR(err);
+		}
 
-		fread(&item->status, SIZEOF(STATUS), 1, hash_map->file);
-		fread(item->data, record_size - SIZEOF(STATUS), 1, hash_map->file);
+		item = oafh_slot(hash_map, loc);
 
-		item->status = ION_DELETED;	/* delete item */
+		if (NULL == item) {
+			return ION_STATUS_ERROR(err_file_read_error);
+		}
 
-		/* backup */
-		fseek(hash_map->file, -record_size, SEEK_CUR);
-		fwrite(&item->status, SIZEOF(STATUS), 1, hash_map->file);
-		fwrite(item->data, record_size - SIZEOF(STATUS), 1, hash_map->file);
+		item->status	= ION_DELETED;	/* delete item */
+		err				= oafh_write_back(hash_map, loc, item, 0, SIZEOF(STATUS));
 
-		free(item);
 #if ION_DEBUG
 		printf("Item deleted at location %d\n", loc);
 #endif
-		return ION_STATUS_OK(1);
+		return err_ok == err ? ION_STATUS_OK(1) : ION_STATUS_ERROR(err);
 	}
 }
 
@@ -390,14 +977,14 @@ oafh_get(
 		printf("Item found at location %d\n", loc);
 #endif
 
-		int record_size = hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS);
+		/* the block probed last holds the record */
+		ion_hash_bucket_t *item = oafh_slot(hash_map, loc);
 
-		/* set file position */
-		fseek(hash_map->file, (loc * record_size) + SIZEOF(STATUS) + hash_map->super.record.key_size, SEEK_SET);
-#if ION_DEBUG
-		printf("seeking %i\n", (loc * record_size) + SIZEOF(STATUS) + hash_map->super.record.key_size);
-#endif
-		fread(value, hash_map->super.record.value_size, 1, hash_map->file);
+		if (NULL == item) {
+			return ION_STATUS_ERROR(err_file_read_error);
+		}
+
+		memcpy(value, item->data + hash_map->super.record.key_size, hash_map->super.record.value_size);
 
 		return ION_STATUS_OK(1);
 	}
@@ -58,6 +58,47 @@ extern "C" {
 #define ION_IN_USE	-3
 #define SIZEOF(STATUS) 1
 
+/* bytes of the file a map reads at once while probing, unless changed with oafh_set_block_cache */
+#if !defined(OAFH_DEFAULT_BLOCK_SIZE)
+#if defined(ARDUINO)
+#define OAFH_DEFAULT_BLOCK_SIZE		128
+#else
+#define OAFH_DEFAULT_BLOCK_SIZE		4096
+#endif
+#endif
+
+/* blocks a map keeps in memory, unless changed with oafh_set_block_cache */
+#if !defined(OAFH_DEFAULT_CACHE_BLOCKS)
+#if defined(ARDUINO)
+#define OAFH_DEFAULT_CACHE_BLOCKS	1
+#else
+#define OAFH_DEFAULT_CACHE_BLOCKS	4
+#endif
+#endif
+
+/* whether a map can map its file into memory with mmap */
+#if !defined(OAFH_HAS_MMAP)
+#if defined(__linux__) && !defined(ARDUINO)
+#define OAFH_HAS_MMAP				1
+#else
+#define OAFH_HAS_MMAP				0
+#endif
+#endif
+
+/* set to 1 for maps created or opened through the handler to be mapped into memory where that is supported */
+#if !defined(OAFH_DEFAULT_MMAP)
+#define OAFH_DEFAULT_MMAP			0
+#endif
+
+/**
+@brief		A block of the file held in memory by a file hashmap.
+*/
+typedef struct {
+	int				block;		/**< Index of the block held, or -1 */
+	unsigned long	last_use;	/**< The map's @c use_clock when the block
+									 was last probed */
+} ion_oafh_frame_t;
+
 /**
 @brief		Prototype declaration for hashmap
 */
@@ -80,7 +121,24 @@ struct file_hashmap {
 
 	/**< The hashing function to be used for
 		 the instance*/
-	FILE *file;	/**< file pointer */
+	FILE					*file;	/**< file pointer */
+	ion_boolean_t			robin_hood;	/**< Records are placed robin hood
+										 style and deletes shift records
+										 back */
+	int						block_slots;	/**< Slots read from the file at
+											 once */
+	int						num_frames;	/**< Blocks kept in memory */
+	ion_oafh_frame_t		*frames;	/**< The blocks held */
+	ion_byte_t				*blocks;	/**< @p num_frames images of
+										 @p block_slots items each */
+	unsigned long			use_clock;	/**< Counts block uses, to find the
+										 least recently used */
+	ion_byte_t				*scratch;	/**< Room for two items while
+										 records are moved */
+	ion_byte_t				*mapping;	/**< The whole file mapped into
+										 memory, or NULL when it is read a
+										 block at a time */
+	ion_dictionary_stats_t	stats;	/**< Performance counters */
 };
 
 /**
@@ -141,6 +199,102 @@ oafh_initialize(
 	ion_dictionary_id_t id
 );
 
+/**
+@brief		Sets how much of the file the map reads at once, and how much of
+			it is kept in memory.
+
+@details	A probe reads the whole aligned block of slots it lands in and
+			carries on inside it, so a probe sequence costs one read per
+			block rather than one per slot. The @p num_blocks blocks read
+			last are kept, and the least recently used gives way when
+			another is needed. Writes go to the file at once, covering only
+			the bytes changed, and to the copy in memory if there is one.
+
+			A map starts with @c OAFH_DEFAULT_BLOCK_SIZE and
+			@c OAFH_DEFAULT_CACHE_BLOCKS. The blocks held are dropped, so
+			calling this again makes the map see writes made to its file
+			other than through the map.
+
+@param		hash_map
+				The map to configure.
+@param		block_size
+				Bytes per block. It is rounded down to a whole number of
+				slots, but never below one.
+@param		num_blocks
+				Blocks kept in memory, at least one.
+@return		err_ok, err_out_of_bounds, or err_out_of_memory.
+*/
+ion_err_t
+oafh_set_block_cache(
+	ion_file_hashmap_t	*hash_map,
+	int					block_size,
+	int					num_blocks
+);
+
+/**
+@brief		Switches the map between reading its file a block at a time and
+			mapping the whole file into memory.
+
+@details	A mapped map reads and writes its slots in place, so lookups make
+			no system calls, and processes mapping the same file share its
+			pages. The mapping is advised for random access. Writes reach
+			the file when the map is flushed or closed, or whenever the
+			kernel writes the pages back.
+
+			The choice is not stored in the file. It is only available
+			where @c OAFH_HAS_MMAP is set.
+
+@param		hash_map
+				The map to configure.
+@param		use_mmap
+				Whether the file is mapped into memory.
+@return		err_ok, err_not_implemented where mmap is not available, or
+			err_file_open_error if the file could not be mapped.
+*/
+ion_err_t
+oafh_set_mmap(
+	ion_file_hashmap_t	*hash_map,
+	ion_boolean_t		use_mmap
+);
+
+/**
+@brief		Writes everything the map has changed through to storage.
+
+@param		hash_map
+				The map to flush.
+@return		The status of the flush.
+*/
+ion_err_t
+oafh_flush(
+	ion_file_hashmap_t *hash_map
+);
+
+/**
+@brief		Switches the map between linear probing and robin hood placement.
+
+@details	A robin hood insert takes the slot of the first record it meets
+			that sits nearer its own home slot, and carries that record on
+			instead. Deletes shift the records after the deleted one back
+			rather than leave a tombstone, and a lookup gives up at the first
+			record nearer its home than the key would be.
+
+			The choice is not stored in the file, so it is made again each
+			time the map is opened. Turning it on for a map that holds
+			records places every record again, which reads and writes the
+			whole file and holds the records in memory while it runs.
+
+@param		hash_map
+				The map to configure.
+@param		robin_hood
+				Whether records are placed robin hood style.
+@return		The status of placing the records again.
+*/
+ion_err_t
+oafh_set_robin_hood(
+	ion_file_hashmap_t	*hash_map,
+	ion_boolean_t		robin_hood
+);
+
 /**
 @brief		Destroys the map in memory
 
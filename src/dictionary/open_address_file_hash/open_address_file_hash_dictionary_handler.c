@@ -390,6 +390,25 @@ oafdict_close_dictionary(
 	return err_ok;
 }
 
+/**
+@brief			Reports the performance counters of an open address file hash instance.
+
+@param			dictionary
+					A pointer to the specific dictionary instance to report on.
+@param			stats
+					The statistics to fill in.
+
+@return			The status of retrieving the statistics.
+ */
+ion_err_t
+oafdict_get_stats(
+	ion_dictionary_t		*dictionary,
+	ion_dictionary_stats_t	*stats
+) {
+	*stats = ((ion_file_hashmap_t *) dictionary->instance)->stats;
+	return err_ok;
+}
+
 void
 oafdict_init(
 	ion_dictionary_handler_t *handler
@@ -404,6 +423,7 @@ oafdict_init(
 	handler->destroy_dictionary = oafdict_destroy_dictionary;
 	handler->open_dictionary	= oafdict_open_dictionary;
 	handler->close_dictionary	= oafdict_close_dictionary;
+	handler->get_stats			= oafdict_get_stats;
 }
 
 ion_status_t
@@ -435,6 +455,7 @@ oafdict_create_dictionary(
 
 	/* this registers the dictionary the dictionary */
 	oafh_initialize((ion_file_hashmap_t *) dictionary->instance, oafh_compute_simple_hash, key_type, key_size, value_size, dictionary_size, id);/* just pick an arbitary size for testing atm */
+	oafh_set_mmap((ion_file_hashmap_t *) dictionary->instance, OAFH_DEFAULT_MMAP);
 
 	/*TODO The correct comparison operator needs to be bound at run time
 	 * based on the type of key defined
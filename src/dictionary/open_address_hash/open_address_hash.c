@@ -42,6 +42,701 @@
 
 #include "open_address_hash.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* first bytes of a snapshot written by oah_save. The header is written field by field, without padding */
+#define OAH_SNAPSHOT_MAGIC	0x4F414832
+
+/**
+@brief		Header of a map snapshot, followed by its records.
+*/
+typedef struct {
+	uint32_t	magic;
+	uint32_t	key_size;
+	uint32_t	value_size;
+	uint32_t	map_size;
+	uint32_t	num_records;
+	uint8_t		layout;
+	uint8_t		robin_hood;
+} ion_oah_snapshot_t;
+
+/* control bytes of the free slots of a grouped map. A full slot's is its tag, which is below 0x80 */
+#define OAH_CTRL_EMPTY		0x80
+#define OAH_CTRL_DELETED	0xFE
+
+/**
+@brief		Hashes a key to a slot of an array of the map.
+@details	Uses the full-key hash chosen for the dictionary if there is one,
+			otherwise the map's own @c compute_hash.
+@param		hash_map
+				The map the key is placed in.
+@param		key
+				The key to hash.
+@param		map_size
+				The size of the array probed, which differs from the map's
+				while it is being rehashed.
+@return		The slot, in [0, map_size).
+*/
+static ion_hash_t
+oah_compute_hash(
+	ion_hashmap_t	*hash_map,
+	ion_key_t		key,
+	int				map_size
+) {
+	ion_hash_t	hash;
+	int			current_size = hash_map->map_size;
+
+	if (NULL != hash_map->super.hash) {
+		return (ion_hash_t) (hash_map->super.hash(key, hash_map->super.record.key_size) % (uint64_t) map_size);
+	}
+
+	/* compute_hash hashes modulo the map's size, so it is shown the size of the array probed */
+	hash_map->map_size	= map_size;
+	hash				= hash_map->compute_hash(hash_map, key, hash_map->super.record.key_size);
+	hash_map->map_size	= current_size;
+
+	return hash;
+}
+
+/**
+@brief		Returns the item at @p loc of an array of the map.
+*/
+static ion_hash_bucket_t *
+oah_slot(
+	ion_hashmap_t	*hash_map,
+	char			*entry,
+	int				loc
+) {
+	return (ion_hash_bucket_t *) (entry + (hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS)) * loc);
+}
+
+/**
+@brief		Returns the size of array the map uses to hold at least @p size
+			items, which for a grouped map is a whole number of groups.
+*/
+static int
+oah_round_size(
+	ion_hashmap_t	*hash_map,
+	int				size
+) {
+	if (oah_layout_groups != hash_map->layout) {
+		return size;
+	}
+
+	return size > 0 ? (size + OAH_GROUP_WIDTH - 1) / OAH_GROUP_WIDTH * OAH_GROUP_WIDTH : OAH_GROUP_WIDTH;
+}
+
+/**
+@brief		Allocates an array of @p map_size empty items in the map's layout.
+@return		The array, or NULL if out of memory.
+*/
+static char *
+oah_allocate(
+	ion_hashmap_t	*hash_map,
+	int				map_size
+) {
+	char	*entry = malloc((hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS)) * map_size);
+	int		i;
+
+	if (NULL == entry) {
+		return NULL;
+	}
+
+	if (oah_layout_groups == hash_map->layout) {
+		memset(entry, OAH_CTRL_EMPTY, map_size);
+		return entry;
+	}
+
+	for (i = 0; i < map_size; i++) {
+		oah_slot(hash_map, entry, i)->status = ION_EMPTY;
+	}
+
+	return entry;
+}
+
+/**
+@brief		Returns whether slot @p loc of an array of @p map_size items holds
+			a record.
+*/
+static ion_boolean_t
+oah_in_use(
+	ion_hashmap_t	*hash_map,
+	char			*entry,
+	int				map_size,
+	int				loc
+) {
+	ion_byte_t ctrl;
+
+	if (oah_layout_groups != hash_map->layout) {
+		return ION_IN_USE == oah_slot(hash_map, entry, loc)->status;
+	}
+
+	UNUSED(map_size);
+	ctrl = ((ion_byte_t *) entry)[loc];
+	return OAH_CTRL_EMPTY != ctrl && OAH_CTRL_DELETED != ctrl;
+}
+
+/**
+@brief		Returns the key of slot @p loc of an array of @p map_size items.
+*/
+static ion_byte_t *
+oah_key_at(
+	ion_hashmap_t	*hash_map,
+	char			*entry,
+	int				map_size,
+	int				loc
+) {
+	if (oah_layout_groups != hash_map->layout) {
+		return oah_slot(hash_map, entry, loc)->data;
+	}
+
+	return (ion_byte_t *) entry + map_size + hash_map->super.record.key_size * loc;
+}
+
+/**
+@brief		Returns the value of slot @p loc of an array of @p map_size items.
+*/
+static ion_byte_t *
+oah_value_at(
+	ion_hashmap_t	*hash_map,
+	char			*entry,
+	int				map_size,
+	int				loc
+) {
+	if (oah_layout_groups != hash_map->layout) {
+		return oah_slot(hash_map, entry, loc)->data + hash_map->super.record.key_size;
+	}
+
+	return (ion_byte_t *) entry + map_size * (1 + hash_map->super.record.key_size) + hash_map->super.record.value_size * loc;
+}
+
+/**
+@brief		Leaves a tombstone in slot @p loc of the map's old array.
+*/
+static void
+oah_mark_deleted(
+	ion_hashmap_t	*hash_map,
+	char			*entry,
+	int				loc
+) {
+	if (oah_layout_groups != hash_map->layout) {
+		oah_slot(hash_map, entry, loc)->status = ION_DELETED;
+	}
+	else {
+		((ion_byte_t *) entry)[loc] = OAH_CTRL_DELETED;
+	}
+}
+
+/**
+@brief		Hashes a key for a grouped map, with the full-key hash chosen for
+			the dictionary or else mix64.
+*/
+static uint64_t
+oah_full_hash(
+	ion_hashmap_t	*hash_map,
+	ion_key_t		key
+) {
+	if (NULL != hash_map->super.hash) {
+		return hash_map->super.hash(key, hash_map->super.record.key_size);
+	}
+
+	if (key_type_null_terminated_string == hash_map->super.key_type) {
+		return dictionary_hash_mix64_string(key, hash_map->super.record.key_size);
+	}
+
+	return dictionary_hash_mix64(key, hash_map->super.record.key_size);
+}
+
+/**
+@brief		Returns a mask with bit @c i set where control byte @c i of the
+			group at @p ctrl is @p byte.
+*/
+static unsigned int
+oah_group_match(
+	ion_byte_t	*ctrl,
+	ion_byte_t	byte
+) {
+#if defined(__SSE2__)
+	__m128i group = _mm_loadu_si128((__m128i *) ctrl);
+
+	return (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) byte)));
+#else
+	unsigned int	mask = 0;
+	int				i;
+
+	for (i = 0; i < OAH_GROUP_WIDTH; i++) {
+		if (ctrl[i] == byte) {
+			mask |= 1U << i;
+		}
+	}
+
+	return mask;
+#endif
+}
+
+/**
+@brief		Returns a mask with bit @c i set where slot @c i of the group at
+			@p ctrl is empty or deleted.
+*/
+static unsigned int
+oah_group_free(
+	ion_byte_t *ctrl
+) {
+#if defined(__SSE2__)
+	/* only the free control bytes have their top bit set */
+	return (unsigned int) _mm_movemask_epi8(_mm_loadu_si128((__m128i *) ctrl));
+#else
+	unsigned int	mask = 0;
+	int				i;
+
+	for (i = 0; i < OAH_GROUP_WIDTH; i++) {
+		if (ctrl[i] & 0x80) {
+			mask |= 1U << i;
+		}
+	}
+
+	return mask;
+#endif
+}
+
+/**
+@brief		Returns the index of the lowest bit set in a non-zero @p mask.
+*/
+static int
+oah_lowest_bit(
+	unsigned int mask
+) {
+#if defined(__GNUC__)
+	return __builtin_ctz(mask);
+#else
+	int i = 0;
+
+	for (; !(mask & 1); mask >>= 1) {
+		i++;
+	}
+
+	return i;
+#endif
+}
+
+/**
+@brief		Locates the item holding @p key in an array of a grouped map.
+@details	The probe starts at the key's home group and moves a group at a
+			time. Keys are only compared in slots whose tag matches, and the
+			search ends at the first group with an empty slot.
+@see		oah_probe
+*/
+static ion_err_t
+oah_group_probe(
+	ion_hashmap_t	*hash_map,
+	char			*entry,
+	int				map_size,
+	ion_key_t		key,
+	int				*location
+) {
+	uint64_t		hash		= oah_full_hash(hash_map, key);
+	ion_byte_t		tag			= (ion_byte_t) (hash >> 57);
+	int				num_groups	= map_size / OAH_GROUP_WIDTH;
+	int				group		= (int) (hash % (uint64_t) num_groups);
+	int				count;
+	int				loc;
+	unsigned int	match;
+	ion_byte_t		*ctrl;
+
+	hash_map->stats.num_lookups++;
+
+	for (count = 0; count < num_groups; count++) {
+		ctrl = (ion_byte_t *) entry + group * OAH_GROUP_WIDTH;
+		hash_map->stats.num_probes++;
+
+		for (match = oah_group_match(ctrl, tag); 0 != match; match &= match - 1) {
+			loc = group * OAH_GROUP_WIDTH + oah_lowest_bit(match);
+
+			if (ION_IS_EQUAL == hash_map->super.compare(oah_key_at(hash_map, entry, map_size, loc), key, hash_map->super.record.key_size)) {
+				(*location) = loc;
+				return err_ok;
+			}
+		}
+
+		if (0 != oah_group_match(ctrl, OAH_CTRL_EMPTY)) {
+			break;
+		}
+
+		group++;
+
+		if (group >= num_groups) {
+			/* Perform wrapping */
+			group = 0;
+		}
+	}
+
+	return err_item_not_found;
+}
+
+/**
+@brief		Places a record in the first free slot of the first group along
+			its probe sequence that has one.
+@see		oah_place
+*/
+static ion_err_t
+oah_group_place(
+	ion_hashmap_t	*hash_map,
+	ion_key_t		key,
+	ion_value_t		value
+) {
+	uint64_t		hash		= oah_full_hash(hash_map, key);
+	int				num_groups	= hash_map->map_size / OAH_GROUP_WIDTH;
+	int				group		= (int) (hash % (uint64_t) num_groups);
+	int				count;
+	int				loc;
+	unsigned int	free_slots;
+	ion_byte_t		*ctrl;
+
+	for (count = 0; count < num_groups; count++) {
+		ctrl		= (ion_byte_t *) hash_map->entry + group * OAH_GROUP_WIDTH;
+		free_slots	= oah_group_free(ctrl);
+
+		if (0 != free_slots) {
+			loc = oah_lowest_bit(free_slots);
+
+			if (OAH_CTRL_DELETED == ctrl[loc]) {
+				hash_map->num_deleted--;
+			}
+
+			ctrl[loc]	= (ion_byte_t) (hash >> 57);
+			loc			+= group * OAH_GROUP_WIDTH;
+			memcpy(oah_key_at(hash_map, hash_map->entry, hash_map->map_size, loc), key, hash_map->super.record.key_size);
+			memcpy(oah_value_at(hash_map, hash_map->entry, hash_map->map_size, loc), value, hash_map->super.record.value_size);
+
+			if (count > (int) hash_map->stats.max_displacement) {
+				hash_map->stats.max_displacement = count;
+			}
+
+			return err_ok;
+		}
+
+		group++;
+
+		if (group >= num_groups) {
+			/* Perform wrapping */
+			group = 0;
+		}
+	}
+
+	return err_max_capacity;
+}
+
+/**
+@brief		Empties the slot at @p loc of a grouped map's array.
+@details	A probe never passes a group that has an empty slot, so the slot
+			can be emptied outright when its group already has one. Otherwise
+			it becomes a tombstone.
+*/
+static void
+oah_group_remove(
+	ion_hashmap_t	*hash_map,
+	int				loc
+) {
+	ion_byte_t *ctrl = (ion_byte_t *) hash_map->entry + loc / OAH_GROUP_WIDTH * OAH_GROUP_WIDTH;
+
+	if (0 != oah_group_match(ctrl, OAH_CTRL_EMPTY)) {
+		((ion_byte_t *) hash_map->entry)[loc] = OAH_CTRL_EMPTY;
+	}
+	else {
+		((ion_byte_t *) hash_map->entry)[loc] = OAH_CTRL_DELETED;
+		hash_map->num_deleted++;
+	}
+}
+
+/**
+@brief		Returns how far the record at @p loc of an array of @p map_size
+			items sits from its home slot.
+*/
+static int
+oah_displacement(
+	ion_hashmap_t		*hash_map,
+	ion_hash_bucket_t	*item,
+	int					loc,
+	int					map_size
+) {
+	int home = oah_get_location(oah_compute_hash(hash_map, item->data, map_size), map_size);
+
+	return (loc - home + map_size) % map_size;
+}
+
+/**
+@brief		Locates the item holding @p key in an array of the map.
+@details	In a robin hood map the search stops at the first record nearer
+			its home slot than @p key would be, or past the largest
+			displacement in the map, instead of at an empty slot.
+@param		hash_map
+				The map searched.
+@param		entry
+				The array searched.
+@param		map_size
+				The size of @p entry in items.
+@param		key
+				The key searched for.
+@param		location
+				Written back with the slot of the item.
+@return		err_ok, or err_item_not_found.
+*/
+static ion_err_t
+oah_probe(
+	ion_hashmap_t	*hash_map,
+	char			*entry,
+	int				map_size,
+	ion_key_t		key,
+	int				*location
+) {
+	if (oah_layout_groups == hash_map->layout) {
+		return oah_group_probe(hash_map, entry, map_size, key, location);
+	}
+
+	/* compute hash value for given key */
+	ion_hash_t hash = oah_compute_hash(hash_map, key, map_size);
+
+	int loc			= oah_get_location(hash, map_size);
+	/* determine bucket based on hash */
+
+	int count		= 0;
+
+	/* an array being rehashed from was filled by linear probing, whatever the map is now */
+	ion_boolean_t ordered = hash_map->robin_hood && entry == hash_map->entry;
+
+	hash_map->stats.num_lookups++;
+
+	while (count != map_size) {
+		if (ordered && (count > (int) hash_map->stats.max_displacement)) {
+			break;
+		}
+
+		/* check to see if current item is a match based on key */
+		/* locate first item */
+		ion_hash_bucket_t *item = oah_slot(hash_map, entry, loc);
+
+		hash_map->stats.num_probes++;
+
+		if (item->status == ION_EMPTY) {
+			return err_item_not_found;	/* if you hit an empty cell, exit */
+		}
+		else {
+			/* calculate if there is a match */
+
+			if (item->status != ION_DELETED) {
+				int key_is_equal = hash_map->super.compare(item->data, key, hash_map->super.record.key_size);
+
+				if (ION_IS_EQUAL == key_is_equal) {
+					(*location) = loc;
+					return err_ok;
+				}
+
+				if (ordered && (oah_displacement(hash_map, item, loc, map_size) < count)) {
+					break;
+				}
+			}
+
+			count++;
+			loc++;
+
+			if (loc >= map_size) {
+				/* Perform wrapping */
+				loc = 0;
+			}
+		}
+	}
+
+	return err_item_not_found;	/* key have not been found */
+}
+
+/**
+@brief		Places a record in the map's array without looking for its key.
+@details	With linear probing the record takes the first free slot from its
+			home. In a robin hood map it takes the slot of the first record
+			nearer its own home than the one being placed, which then moves on
+			in its place.
+@param		hash_map
+				The map the record is placed in.
+@param		key
+				The key of the record.
+@param		value
+				The value of the record.
+@return		err_ok, or err_max_capacity if the array is full.
+*/
+static ion_err_t
+oah_place(
+	ion_hashmap_t	*hash_map,
+	ion_key_t		key,
+	ion_value_t		value
+) {
+	int					key_size	= hash_map->super.record.key_size;
+	int					record_size = key_size + hash_map->super.record.value_size;
+	int					loc			= oah_get_location(oah_compute_hash(hash_map, key, hash_map->map_size), hash_map->map_size);
+	int					distance	= 0;
+	int					count		= 0;
+	int					resident;
+	/* the record being placed once it has displaced another, followed by room for a swap */
+	ion_byte_t			*carry		= NULL;
+	ion_hash_bucket_t	*item;
+
+	if (oah_layout_groups == hash_map->layout) {
+		return oah_group_place(hash_map, key, value);
+	}
+
+	for (; count != hash_map->map_size; count++) {
+		item = oah_slot(hash_map, hash_map->entry, loc);
+
+		if (item->status != ION_IN_USE) {
+			if (item->status == ION_DELETED) {
+				hash_map->num_deleted--;
+			}
+
+			item->status = ION_IN_USE;
+
+			if (NULL == carry) {
+				memcpy(item->data, key, key_size);
+				memcpy(item->data + key_size, value, record_size - key_size);
+			}
+			else {
+				memcpy(item->data, carry, record_size);
+				free(carry);
+			}
+
+			if (distance > (int) hash_map->stats.max_displacement) {
+				hash_map->stats.max_displacement = distance;
+			}
+
+			return err_ok;
+		}
+
+		if (hash_map->robin_hood && ((resident = oah_displacement(hash_map, item, loc, hash_map->map_size)) < distance)) {
+			if (NULL == carry) {
+				carry = malloc(2 * record_size);
+
+				if (NULL == carry) {
+					return err_out_of_memory;
+				}
+
+				memcpy(carry, key, key_size);
+				memcpy(carry + key_size, value, record_size - key_size);
+			}
+
+			memcpy(carry + record_size, item->data, record_size);
+			memcpy(item->data, carry, record_size);
+			memcpy(carry, carry + record_size, record_size);
+
+			if (distance > (int) hash_map->stats.max_displacement) {
+				hash_map->stats.max_displacement = distance;
+			}
+
+			distance = resident;
+		}
+
+		distance++;
+		loc++;
+
+		if (loc >= hash_map->map_size) {
+			/* Perform wrapping */
+			loc = 0;
+		}
+	}
+
+	free(carry);
+	return err_max_capacity;
+}
+
+/**
+@brief		Empties the slot at @p loc of the map's array.
+@details	Linear probing leaves a tombstone. A robin hood map instead shifts
+			back every following record not already in its home slot, so its
+			probe sequences never run through deleted slots.
+*/
+static void
+oah_remove(
+	ion_hashmap_t	*hash_map,
+	int				loc
+) {
+	ion_hash_bucket_t	*item	= oah_slot(hash_map, hash_map->entry, loc);
+	ion_hash_bucket_t	*next;
+	int					count;
+
+	if (oah_layout_groups == hash_map->layout) {
+		oah_group_remove(hash_map, loc);
+		return;
+	}
+
+	if (!hash_map->robin_hood) {
+		item->status = ION_DELETED;
+		hash_map->num_deleted++;
+		return;
+	}
+
+	for (count = 1; count < hash_map->map_size; count++) {
+		loc		= (loc + 1) % hash_map->map_size;
+		next	= oah_slot(hash_map, hash_map->entry, loc);
+
+		if ((next->status != ION_IN_USE) || (0 == oah_displacement(hash_map, next, loc, hash_map->map_size))) {
+			break;
+		}
+
+		memcpy(item->data, next->data, hash_map->super.record.key_size + hash_map->super.record.value_size);
+		item = next;
+	}
+
+	item->status = ION_EMPTY;
+}
+
+/**
+@brief		Moves the slots of a rehash in progress that one operation pays for.
+*/
+static void
+oah_migrate_step(
+	ion_hashmap_t *hash_map
+) {
+	if (NULL != hash_map->old_entry) {
+		oah_migrate(hash_map, hash_map->migrate_work > 0 ? hash_map->migrate_work : hash_map->old_map_size);
+	}
+}
+
+/**
+@brief		Rehashes the map before a new record is added if that would take
+			it past its @c grow_load.
+@details	The map doubles unless most of the load is tombstones, in which
+			case it is rehashed at the same size. If the rehash fails the
+			record still goes in while there is room.
+*/
+static void
+oah_grow(
+	ion_hashmap_t *hash_map
+) {
+	if ((0 == hash_map->grow_load) || ((hash_map->num_records + hash_map->num_deleted + 1) * 100 <= hash_map->grow_load * hash_map->map_size)) {
+		return;
+	}
+
+	if ((hash_map->num_records + 1) * 200 > hash_map->grow_load * hash_map->map_size) {
+		oah_resize(hash_map, hash_map->map_size > 0 ? hash_map->map_size * 2 : 1);
+	}
+	else {
+		oah_resize(hash_map, hash_map->map_size);
+	}
+}
+
+/**
+@brief		Halves the map after a delete if it is below its @c shrink_load.
+*/
+static void
+oah_shrink(
+	ion_hashmap_t *hash_map
+) {
+	if ((0 == hash_map->shrink_load) || (NULL != hash_map->old_entry) || (hash_map->map_size / 2 < hash_map->min_size) || (hash_map->num_records * 100 >= hash_map->shrink_load * hash_map->map_size)) {
+		return;
+	}
+
+	oah_resize(hash_map, hash_map->map_size / 2);
+}
+
 ion_err_t
 oah_initialize(
 	ion_hashmap_t *hashmap,
@@ -57,9 +752,25 @@ oah_initialize(
 	hashmap->super.record.key_size		= key_size;
 	hashmap->super.record.value_size	= value_size;
 	hashmap->super.key_type				= key_type;
+	hashmap->super.hash_type			= dictionary_hash_type_builtin;
+	hashmap->super.hash					= NULL;
 
 /*	hashmap->compare = compare;*/
 
+	/* The map keeps its size until oah_set_resize is called */
+	hashmap->num_records	= 0;
+	hashmap->num_deleted	= 0;
+	hashmap->grow_load		= 0;
+	hashmap->shrink_load	= 0;
+	hashmap->min_size		= size;
+	hashmap->migrate_work	= 0;
+	hashmap->old_entry		= NULL;
+	hashmap->old_map_size	= 0;
+	hashmap->migrate_next	= 0;
+	hashmap->robin_hood		= boolean_false;
+	hashmap->layout			= oah_layout_rows;
+	memset(&hashmap->stats, 0, sizeof(hashmap->stats));
+
 	/* The hash map is allocated as a single contiguous array*/
 	hashmap->map_size		= size;
 	hashmap->entry			= malloc((hashmap->super.record.key_size + hashmap->super.record.value_size + 1) * hashmap->map_size);
@@ -82,6 +793,221 @@ oah_initialize(
 	return 0;
 }
 
+ion_err_t
+oah_set_resize(
+	ion_hashmap_t	*hash_map,
+	int				grow_load,
+	int				shrink_load,
+	int				migrate_work
+) {
+	if ((grow_load < 0) || (grow_load > 100) || (shrink_load < 0) || (migrate_work < 0) || ((0 != shrink_load) && (shrink_load * 2 >= grow_load))) {
+		return err_out_of_bounds;
+	}
+
+	hash_map->grow_load		= grow_load;
+	hash_map->shrink_load	= shrink_load;
+	hash_map->migrate_work	= migrate_work;
+	return err_ok;
+}
+
+ion_err_t
+oah_set_robin_hood(
+	ion_hashmap_t	*hash_map,
+	ion_boolean_t	robin_hood
+) {
+	ion_err_t err;
+
+	if (!robin_hood || hash_map->robin_hood) {
+		hash_map->robin_hood = robin_hood;
+		return err_ok;
+	}
+
+	if (oah_layout_groups == hash_map->layout) {
+		return err_not_implemented;
+	}
+
+	/* a rehash in progress fills the array it moves records to by linear probing */
+	if (NULL != hash_map->old_entry) {
+		oah_migrate(hash_map, hash_map->old_map_size);
+	}
+
+	hash_map->robin_hood = boolean_true;
+
+	if (hash_map->num_records + hash_map->num_deleted == 0) {
+		hash_map->stats.max_displacement = 0;
+		return err_ok;
+	}
+
+	/* records placed by linear probing are placed again in robin hood order */
+	err = oah_resize(hash_map, hash_map->map_size);
+
+	if (err_ok != err) {
+		hash_map->robin_hood = boolean_false;
+	}
+
+	return err;
+}
+
+ion_err_t
+oah_set_layout(
+	ion_hashmap_t		*hash_map,
+	ion_oah_layout_t	layout
+) {
+	char				*entry;
+	int					map_size;
+	int					loc;
+	ion_byte_t			*key;
+	ion_byte_t			*value;
+	ion_oah_layout_t	old_layout = hash_map->layout;
+
+	if (layout == old_layout) {
+		return err_ok;
+	}
+
+	/* both arrays of a rehash share one layout */
+	if (NULL != hash_map->old_entry) {
+		oah_migrate(hash_map, hash_map->old_map_size);
+	}
+
+	hash_map->layout	= layout;
+	map_size			= oah_round_size(hash_map, hash_map->map_size);
+	entry				= oah_allocate(hash_map, map_size);
+
+	if (NULL == entry) {
+		hash_map->layout = old_layout;
+		return err_out_of_memory;
+	}
+
+	if (oah_layout_groups == layout) {
+		hash_map->robin_hood = boolean_false;
+	}
+
+	/* the old array is read in its own layout while records are placed in the new one */
+	hash_map->old_entry		= hash_map->entry;
+	hash_map->old_map_size	= hash_map->map_size;
+	hash_map->entry			= entry;
+	hash_map->map_size		= map_size;
+	hash_map->num_deleted	= 0;
+
+	hash_map->stats.max_displacement = 0;
+
+	/* the new array is at least as large and a grouped map never carries records robin hood style, so every placement succeeds */
+	for (loc = 0; loc < hash_map->old_map_size; loc++) {
+		hash_map->layout = old_layout;
+
+		if (!oah_in_use(hash_map, hash_map->old_entry, hash_map->old_map_size, loc)) {
+			continue;
+		}
+
+		key					= oah_key_at(hash_map, hash_map->old_entry, hash_map->old_map_size, loc);
+		value				= oah_value_at(hash_map, hash_map->old_entry, hash_map->old_map_size, loc);
+		hash_map->layout	= layout;
+		oah_place(hash_map, key, value);
+	}
+
+	hash_map->layout = layout;
+	free(hash_map->old_entry);
+	hash_map->old_entry		= NULL;
+	hash_map->old_map_size	= 0;
+
+	return err_ok;
+}
+
+ion_key_t
+oah_slot_key(
+	ion_hashmap_t	*hash_map,
+	int				loc
+) {
+	if (!oah_in_use(hash_map, hash_map->entry, hash_map->map_size, loc)) {
+		return NULL;
+	}
+
+	return oah_key_at(hash_map, hash_map->entry, hash_map->map_size, loc);
+}
+
+ion_value_t
+oah_slot_value(
+	ion_hashmap_t	*hash_map,
+	int				loc
+) {
+	if (!oah_in_use(hash_map, hash_map->entry, hash_map->map_size, loc)) {
+		return NULL;
+	}
+
+	return oah_value_at(hash_map, hash_map->entry, hash_map->map_size, loc);
+}
+
+ion_err_t
+oah_resize(
+	ion_hashmap_t	*hash_map,
+	int				new_size
+) {
+	char *entry;
+
+	if (new_size <= hash_map->num_records) {
+		return err_invalid_initial_size;
+	}
+
+	/* only one rehash runs at a time */
+	if (NULL != hash_map->old_entry) {
+		oah_migrate(hash_map, hash_map->old_map_size);
+	}
+
+	new_size	= oah_round_size(hash_map, new_size);
+	entry		= oah_allocate(hash_map, new_size);
+
+	if (NULL == entry) {
+		return err_out_of_memory;
+	}
+
+	hash_map->old_entry		= hash_map->entry;
+	hash_map->old_map_size	= hash_map->map_size;
+	hash_map->migrate_next	= 0;
+	hash_map->entry			= entry;
+	hash_map->map_size		= new_size;
+	hash_map->num_deleted	= 0;
+
+	hash_map->stats.max_displacement = 0;
+
+	return oah_migrate(hash_map, hash_map->migrate_work > 0 ? hash_map->migrate_work : hash_map->old_map_size);
+}
+
+ion_err_t
+oah_migrate(
+	ion_hashmap_t	*hash_map,
+	int				num_slots
+) {
+	char		*old_entry;
+	int			loc;
+	ion_err_t	err;
+
+	for (; NULL != hash_map->old_entry && num_slots > 0; num_slots--) {
+		old_entry	= hash_map->old_entry;
+		loc			= hash_map->migrate_next;
+
+		if (oah_in_use(hash_map, old_entry, hash_map->old_map_size, loc)) {
+			err = oah_place(hash_map, oah_key_at(hash_map, old_entry, hash_map->old_map_size, loc), oah_value_at(hash_map, old_entry, hash_map->old_map_size, loc));
+
+			if (err_ok != err) {
+				return err;
+			}
+
+			/* moved, so a retry after an error does not place it twice */
+			oah_mark_deleted(hash_map, old_entry, loc);
+		}
+
+		hash_map->migrate_next++;
+
+		if (hash_map->migrate_next == hash_map->old_map_size) {
+			free(hash_map->old_entry);
+			hash_map->old_entry		= NULL;
+			hash_map->old_map_size	= 0;
+		}
+	}
+
+	return err_ok;
+}
+
 int
 oah_get_location(
 	ion_hash_t	num,
@@ -99,6 +1025,9 @@ oah_destroy(
 	hash_map->super.record.key_size		= 0;
 	hash_map->super.record.value_size	= 0;
 
+	free(hash_map->old_entry);
+	hash_map->old_entry = NULL;
+
 	if (hash_map->entry != NULL) {
 		/* check to ensure that you are not freeing something already free */
 		free(hash_map->entry);
@@ -110,6 +1039,122 @@ oah_destroy(
 	}
 }
 
+/**
+@brief		Writes a snapshot header one field at a time, so that no padding reaches the file.
+*/
+static ion_err_t
+oah_write_snapshot_header(
+	ion_oah_snapshot_t	*header,
+	FILE				*file
+) {
+	if ((1 != fwrite(&header->magic, sizeof(header->magic), 1, file)) || (1 != fwrite(&header->key_size, sizeof(header->key_size), 1, file)) || (1 != fwrite(&header->value_size, sizeof(header->value_size), 1, file)) || (1 != fwrite(&header->map_size, sizeof(header->map_size), 1, file)) || (1 != fwrite(&header->num_records, sizeof(header->num_records), 1, file)) || (1 != fwrite(&header->layout, sizeof(header->layout), 1, file)) || (1 != fwrite(&header->robin_hood, sizeof(header->robin_hood), 1, file))) {
+		return err_file_write_error;
+	}
+
+	return err_ok;
+}
+
+/**
+@brief		Reads a snapshot header written by @ref oah_write_snapshot_header.
+*/
+static ion_err_t
+oah_read_snapshot_header(
+	ion_oah_snapshot_t	*header,
+	FILE				*file
+) {
+	if ((1 != fread(&header->magic, sizeof(header->magic), 1, file)) || (1 != fread(&header->key_size, sizeof(header->key_size), 1, file)) || (1 != fread(&header->value_size, sizeof(header->value_size), 1, file)) || (1 != fread(&header->map_size, sizeof(header->map_size), 1, file)) || (1 != fread(&header->num_records, sizeof(header->num_records), 1, file)) || (1 != fread(&header->layout, sizeof(header->layout), 1, file)) || (1 != fread(&header->robin_hood, sizeof(header->robin_hood), 1, file))) {
+		return err_file_read_error;
+	}
+
+	return err_ok;
+}
+
+ion_err_t
+oah_save(
+	ion_hashmap_t	*hash_map,
+	FILE			*file
+) {
+	ion_key_size_t		key_size	= hash_map->super.record.key_size;
+	ion_value_size_t	value_size	= hash_map->super.record.value_size;
+	ion_oah_snapshot_t	header		= { OAH_SNAPSHOT_MAGIC, key_size, value_size, hash_map->map_size, hash_map->num_records, hash_map->layout, hash_map->robin_hood };
+	char				*entry;
+	int					size;
+	int					loc;
+	int					pass;
+
+	if (err_ok != oah_write_snapshot_header(&header, file)) {
+		return err_file_write_error;
+	}
+
+	/* records not yet moved by a rehash are still in the old array, and those moved are no longer in use there */
+	for (pass = 0; pass < 2; pass++) {
+		entry	= 0 == pass ? hash_map->entry : hash_map->old_entry;
+		size	= 0 == pass ? hash_map->map_size : hash_map->old_map_size;
+
+		for (loc = 0; NULL != entry && loc < size; loc++) {
+			if (!oah_in_use(hash_map, entry, size, loc)) {
+				continue;
+			}
+
+			if ((1 != fwrite(oah_key_at(hash_map, entry, size, loc), key_size, 1, file)) || (1 != fwrite(oah_value_at(hash_map, entry, size, loc), value_size, 1, file))) {
+				return err_file_write_error;
+			}
+		}
+	}
+
+	return err_ok;
+}
+
+ion_err_t
+oah_load(
+	ion_hashmap_t	*hash_map,
+	FILE			*file
+) {
+	ion_key_size_t		key_size	= hash_map->super.record.key_size;
+	ion_value_size_t	value_size	= hash_map->super.record.value_size;
+	ion_oah_snapshot_t	header;
+	ion_byte_t			*record;
+	ion_err_t			err			= err_ok;
+	uint32_t			i;
+
+	if ((err_ok != oah_read_snapshot_header(&header, file)) || (OAH_SNAPSHOT_MAGIC != header.magic) || ((uint32_t) key_size != header.key_size) || ((uint32_t) value_size != header.value_size)) {
+		return err_file_read_error;
+	}
+
+	/* the layout first, since a grouped map rounds its size */
+	err = oah_set_layout(hash_map, (ion_oah_layout_t) header.layout);
+
+	if ((err_ok == err) && (oah_layout_rows == hash_map->layout)) {
+		err = oah_set_robin_hood(hash_map, (ion_boolean_t) header.robin_hood);
+	}
+
+	if ((err_ok == err) && ((int) header.map_size > hash_map->map_size)) {
+		err = oah_resize(hash_map, (int) header.map_size);
+	}
+
+	if (err_ok != err) {
+		return err;
+	}
+
+	record = malloc(key_size + value_size);
+
+	if (NULL == record) {
+		return err_out_of_memory;
+	}
+
+	for (i = 0; i < header.num_records && err_ok == err; i++) {
+		if (1 != fread(record, key_size + value_size, 1, file)) {
+			err = err_file_read_error;
+		}
+		else {
+			err = oah_insert(hash_map, record, record + key_size).error;
+		}
+	}
+
+	free(record);
+	return err;
+}
+
 ion_status_t
 oah_update(
 	ion_hashmap_t	*hash_map,
@@ -132,62 +1177,54 @@ oah_insert(
 	ion_key_t		key,
 	ion_value_t		value
 ) {
-	ion_hash_t hash = hash_map->compute_hash(hash_map, key, hash_map->super.record.key_size);	/* compute hash value for given key */
-
-	int loc			= oah_get_location(hash, hash_map->map_size);
-
-	/* Scan until find an empty location - oah_insert if found */
-	int count		= 0;
-
-	ion_hash_bucket_t *item;
+	ion_byte_t	*found = NULL;
+	ion_err_t	err;
+	int			loc;
 
-	while (count != hash_map->map_size) {
-		item = ((ion_hash_bucket_t *) ((hash_map->entry + (hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS)) * loc)));
+	oah_migrate_step(hash_map);
 
-		if (item->status == ION_IN_USE) {
-			/* if a cell is in use, need to key to */
+	/* a key not yet moved by a rehash is still in the old array */
+	if (err_ok == oah_find_item_loc(hash_map, key, &loc)) {
+		found = oah_value_at(hash_map, hash_map->entry, hash_map->map_size, loc);
+	}
+	else if ((NULL != hash_map->old_entry) && (err_ok == oah_probe(hash_map, hash_map->old_entry, hash_map->old_map_size, key, &loc))) {
+		found = oah_value_at(hash_map, hash_map->old_entry, hash_map->old_map_size, loc);
+	}
 
-			if (hash_map->super.compare(item->data, key, hash_map->super.record.key_size) == ION_IS_EQUAL) {
-				if (hash_map->write_concern == wc_insert_unique) {
-					/* allow unique entries only */
-					return ION_STATUS_ERROR(err_duplicate_key);
-				}
-				else if (hash_map->write_concern == wc_update) {
-					/* allows for values to be updated */
-					memcpy(item->data + hash_map->super.record.key_size, value, (hash_map->super.record.value_size));
-					return ION_STATUS_OK(1);
-				}
-				else {
-					return ION_STATUS_ERROR(err_file_write_error);	/* there is a configuration issue with write concern */
-				}
-			}
+	if (NULL != found) {
+		if (hash_map->write_concern == wc_insert_unique) {
+			/* allow unique entries only */
+			return ION_STATUS_ERROR(err_duplicate_key);
 		}
-		else if ((item->status == ION_EMPTY) || (item->status == ION_DELETED)) {
-			/* problem is here with base types as it is just an array of data.  Need better way */
-			item->status = ION_IN_USE;
-			memcpy(item->data, key, (hash_map->super.record.key_size));
-			memcpy(item->data + hash_map->super.record.key_size, value, (hash_map->super.record.value_size));
+		else if (hash_map->write_concern == wc_update) {
+			/* allows for values to be updated */
+			memcpy(found, value, (hash_map->super.record.value_size));
 			return ION_STATUS_OK(1);
 		}
-
-		loc++;
-
-		if (loc >= hash_map->map_size) {
-			/* Perform wrapping */
-			loc = 0;
+		else {
+			return ION_STATUS_ERROR(err_file_write_error);	/* there is a configuration issue with write concern */
 		}
+	}
+
+	oah_grow(hash_map);
 
+	/* records waiting in the old array are placed in the new one too */
+	if (hash_map->num_records >= hash_map->map_size) {
 #if ION_DEBUG
-		printf("checking location %i\n", loc);
+		printf("Hash table full.  Insert not done");
 #endif
-		count++;
+		return ION_STATUS_ERROR(err_max_capacity);
 	}
 
-#if ION_DEBUG
-	printf("Hash table full.  Insert not done");
-#endif
+	err = oah_place(hash_map, key, value);
+
+	if (err_ok != err) {
+		return ION_STATUS_ERROR(err);
+	}
 
-	return ION_STATUS_ERROR(err_max_capacity);
+	hash_map->num_records++;
+	hash_map->stats.num_inserts++;
+	return ION_STATUS_OK(1);
 }
 
 ion_err_t
@@ -196,45 +1233,7 @@ oah_find_item_loc(
 	ion_key_t		key,
 	int				*location
 ) {
-	/* compute hash value for given key */
-	ion_hash_t hash = hash_map->compute_hash(hash_map, key, hash_map->super.record.key_size);
-
-	int loc			= oah_get_location(hash, hash_map->map_size);
-	/* determine bucket based on hash */
-
-	int count		= 0;
-
-	while (count != hash_map->map_size) {
-		/* check to see if current item is a match based on key */
-		/* locate first item */
-		ion_hash_bucket_t *item = (((ion_hash_bucket_t *) ((hash_map->entry + (hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS)) * loc))));
-
-		if (item->status == ION_EMPTY) {
-			return err_item_not_found;	/* if you hit an empty cell, exit */
-		}
-		else {
-			/* calculate if there is a match */
-
-			if (item->status != ION_DELETED) {
-				int key_is_equal = hash_map->super.compare(item->data, key, hash_map->super.record.key_size);
-
-				if (ION_IS_EQUAL == key_is_equal) {
-					(*location) = loc;
-					return err_ok;
-				}
-			}
-
-			count++;
-			loc++;
-
-			if (loc >= hash_map->map_size) {
-				/* Perform wrapping */
-				loc = 0;
-			}
-		}
-	}
-
-	return err_item_not_found;	/* key have not been found */
+	return oah_probe(hash_map, hash_map->entry, hash_map->map_size, key, location);
 }
 
 ion_status_t
@@ -244,23 +1243,28 @@ oah_delete(
 ) {
 	int loc = -1;
 
-	if (oah_find_item_loc(hash_map, key, &loc) == err_item_not_found) {
+	oah_migrate_step(hash_map);
+
+	if (oah_find_item_loc(hash_map, key, &loc) == err_ok) {
+		oah_remove(hash_map, loc);
+	}
+	else if ((NULL != hash_map->old_entry) && (err_ok == oah_probe(hash_map, hash_map->old_entry, hash_map->old_map_size, key, &loc))) {
+		oah_mark_deleted(hash_map, hash_map->old_entry, loc);
+	}
+	else {
 #if ION_DEBUG
 		printf("Item not found when trying to oah_delete.\n");
 #endif
 		return ION_STATUS_ERROR(err_item_not_found);
 	}
-	else {
-		/* locate item */
-		ion_hash_bucket_t *item = (((ion_hash_bucket_t *) ((hash_map->entry + (hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS)) * loc))));
-
-		item->status = ION_DELETED;	/* delete item */
 
 #if ION_DEBUG
-		printf("Item deleted at location %d\n", loc);
+	printf("Item deleted at location %d\n", loc);
 #endif
-		return ION_STATUS_OK(1);
-	}
+	hash_map->num_records--;
+	hash_map->stats.num_deletes++;
+	oah_shrink(hash_map);
+	return ION_STATUS_OK(1);
 }
 
 ion_status_t
@@ -269,19 +1273,16 @@ oah_get(
 	ion_key_t		key,
 	ion_value_t		value
 ) {
-	int loc;
-
-	if (oah_find_item_loc(hash_map, key, &loc) == err_ok) {
-#if ION_DEBUG
-		printf("Item found at location %d\n", loc);
-#endif
+	ion_byte_t	*found;
+	int			loc;
 
-		int					data_length = hash_map->super.record.key_size + hash_map->super.record.value_size;
-		ion_hash_bucket_t	*item		= (((ion_hash_bucket_t *) ((hash_map->entry + (data_length + SIZEOF(STATUS)) * loc))));
+	oah_migrate_step(hash_map);
 
-		/* *value				   = malloc(sizeof(char) * (hash_map->super.record.value_size)); */
-		memcpy(value, (item->data + hash_map->super.record.key_size), hash_map->super.record.value_size);
-		return ION_STATUS_OK(1);
+	if (oah_find_item_loc(hash_map, key, &loc) == err_ok) {
+		found = oah_value_at(hash_map, hash_map->entry, hash_map->map_size, loc);
+	}
+	else if ((NULL != hash_map->old_entry) && (err_ok == oah_probe(hash_map, hash_map->old_entry, hash_map->old_map_size, key, &loc))) {
+		found = oah_value_at(hash_map, hash_map->old_entry, hash_map->old_map_size, loc);
 	}
 	else {
 #if ION_DEBUG
@@ -289,6 +1290,13 @@ oah_get(
 #endif
 		return ION_STATUS_ERROR(err_item_not_found);
 	}
+
+#if ION_DEBUG
+	printf("Item found at location %d\n", loc);
+#endif
+
+	memcpy(value, found, hash_map->super.record.value_size);
+	return ION_STATUS_OK(1);
 }
 
 /**
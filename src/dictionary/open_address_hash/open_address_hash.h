@@ -59,6 +59,46 @@ extern "C" {
 #define ION_IN_USE	-3
 #define SIZEOF(STATUS) 1
 
+/* percent of slots, records and tombstones together, past which a map created through the handler is rehashed; 0 keeps the map at its initial size */
+#if !defined(OAH_DEFAULT_GROW_LOAD)
+#define OAH_DEFAULT_GROW_LOAD		75
+#endif
+
+/* percent of slots in use below which a map created through the handler halves; 0 never shrinks */
+#if !defined(OAH_DEFAULT_SHRINK_LOAD)
+#define OAH_DEFAULT_SHRINK_LOAD		0
+#endif
+
+/* set to 1 for maps created through the handler to place records robin hood style */
+#if !defined(OAH_DEFAULT_ROBIN_HOOD)
+#define OAH_DEFAULT_ROBIN_HOOD		0
+#endif
+
+/* slots of the old array moved per operation while a map is rehashed; 0 rehashes all at once */
+#if !defined(OAH_DEFAULT_MIGRATE_WORK)
+#define OAH_DEFAULT_MIGRATE_WORK	0
+#endif
+
+/* layout of maps created through the handler, oah_layout_rows or oah_layout_groups */
+#if !defined(OAH_DEFAULT_LAYOUT)
+#define OAH_DEFAULT_LAYOUT			oah_layout_rows
+#endif
+
+/* slots whose control bytes a map with the grouped layout checks at once */
+#define OAH_GROUP_WIDTH				16
+
+/**
+@brief		How the slots of an in memory hashmap are laid out in its array.
+*/
+typedef enum {
+	/**> Each slot is a status byte followed by its key and value. */
+	oah_layout_rows,
+	/**> A control byte per slot, holding its status or a 7-bit tag of its
+		 key's hash, then every key, then every value. Slots are probed
+		 @c OAH_GROUP_WIDTH at a time. */
+	oah_layout_groups
+} ion_oah_layout_t;
+
 /**
 @brief		Prototype declaration for hashmap
 */
@@ -81,7 +121,33 @@ struct hashmap {
 
 	/**< The hashing function to be used for
 		 the instance*/
-	char *entry;/**< Pointer to the entries in the hashmap*/
+	char					*entry;	/**< Pointer to the entries in the hashmap*/
+	int						num_records;	/**< Records in use, in both arrays
+											 while the map is being rehashed */
+	int						num_deleted;	/**< Tombstones in @p entry */
+	int						grow_load;	/**< Percent of @p map_size past which
+										 the map is rehashed, or 0 to never
+										 grow */
+	int						shrink_load;	/**< Percent of @p map_size below
+											 which the map halves, or 0 to
+											 never shrink */
+	int						min_size;	/**< The map never shrinks below this
+										 size */
+	int						migrate_work;	/**< Slots of @p old_entry moved per
+											 operation, or 0 to rehash all at
+											 once */
+	char					*old_entry;	/**< The array being rehashed from, or
+										 NULL */
+	int						old_map_size;	/**< The size of @p old_entry in
+											 items */
+	int						migrate_next;	/**< The next slot of @p old_entry
+											 to move */
+	ion_boolean_t			robin_hood;	/**< Records are placed robin hood
+										 style and deletes shift records
+										 back */
+	ion_oah_layout_t		layout;	/**< How @p entry and @p old_entry are
+									 laid out */
+	ion_dictionary_stats_t	stats;	/**< Performance counters */
 };
 
 /**
@@ -112,6 +178,165 @@ oah_initialize(
 	int size
 );
 
+/**
+@brief		Sets when the map grows and shrinks, and how quickly it is rehashed.
+
+@details	A map starts at a fixed size. With a @p grow_load, an insert that
+			would take the map past that load rehashes it into an array twice
+			the size, or into one of the same size if it is mostly tombstones.
+			With a @p shrink_load, a delete that leaves the map below that load
+			rehashes it into an array half the size, though never below the
+			size it was initialized with.
+
+			With a @p migrate_work, the old array is kept alongside the new one
+			and every operation moves that many of its slots, so no single
+			operation pays for the whole rehash. Lookups check both arrays
+			until the move is done.
+
+@param		hash_map
+				The map to configure.
+@param		grow_load
+				Percent of slots, records and tombstones together, or 0 to
+				keep the size fixed.
+@param		shrink_load
+				Percent of slots in use, or 0 to never shrink. It has to be
+				under half of @p grow_load.
+@param		migrate_work
+				Slots moved per operation, or 0 to rehash all at once.
+@return		err_ok, or err_out_of_bounds if the loads are out of range.
+*/
+ion_err_t
+oah_set_resize(
+	ion_hashmap_t	*hash_map,
+	int				grow_load,
+	int				shrink_load,
+	int				migrate_work
+);
+
+/**
+@brief		Switches the map between linear probing and robin hood placement.
+
+@details	A robin hood insert takes the slot of the first record it meets
+			that sits nearer its own home slot, and carries that record on
+			instead. Deletes shift the records after the deleted one back
+			rather than leave a tombstone. A lookup can then give up at the
+			first record nearer its home than the key would be, so misses are
+			bounded by the largest displacement in the map instead of by how
+			many tombstones it has collected.
+
+			Turning robin hood placement on rehashes any records already in
+			the map. Turning it off keeps the records where they are. A map
+			with the grouped layout cannot place records robin hood style.
+
+@param		hash_map
+				The map to configure.
+@param		robin_hood
+				Whether records are placed robin hood style.
+@return		The status of the change, err_not_implemented for a grouped map.
+*/
+ion_err_t
+oah_set_robin_hood(
+	ion_hashmap_t	*hash_map,
+	ion_boolean_t	robin_hood
+);
+
+/**
+@brief		Switches the map between the row and the grouped layout.
+
+@details	The grouped layout keeps a control byte per slot apart from the
+			keys and values. A full slot's control byte is a 7-bit tag taken
+			from the key's full-key hash, so a probe compares the tags of
+			@c OAH_GROUP_WIDTH slots at once, with SSE2 where the target has
+			it, and only calls the key comparison for slots whose tag matches.
+			The key is hashed with the dictionary's full-key hash, or mix64 if
+			none was chosen, rather than with @c compute_hash. The map's size
+			is rounded up to a whole number of groups, and its probe counters
+			count groups rather than slots.
+
+			A grouped map does not place records robin hood style, so
+			switching to it turns robin hood placement off. Records already in
+			the map are moved into the new layout all at once.
+
+@param		hash_map
+				The map to configure.
+@param		layout
+				The layout of the map's array.
+@return		The status of the change.
+*/
+ion_err_t
+oah_set_layout(
+	ion_hashmap_t		*hash_map,
+	ion_oah_layout_t	layout
+);
+
+/**
+@brief		Returns the key held in slot @p loc of the map's array.
+
+@param		hash_map
+				The map read.
+@param		loc
+				The slot, in [0, @c map_size).
+@return		The key, or NULL if the slot holds no record.
+*/
+ion_key_t
+oah_slot_key(
+	ion_hashmap_t	*hash_map,
+	int				loc
+);
+
+/**
+@brief		Returns the value held in slot @p loc of the map's array.
+
+@param		hash_map
+				The map read.
+@param		loc
+				The slot, in [0, @c map_size).
+@return		The value, or NULL if the slot holds no record.
+*/
+ion_value_t
+oah_slot_value(
+	ion_hashmap_t	*hash_map,
+	int				loc
+);
+
+/**
+@brief		Rehashes the map into a new array of @p new_size items.
+
+@details	A rehash already in progress is finished first. The records then
+			move all at once, or a few per operation if the map has a
+			@c migrate_work.
+
+@param		hash_map
+				The map to rehash.
+@param		new_size
+				The size of the new array in items. It has to hold every
+				record and one more. A grouped map rounds it up to a whole
+				number of groups.
+@return		The status of the rehash.
+*/
+ion_err_t
+oah_resize(
+	ion_hashmap_t	*hash_map,
+	int				new_size
+);
+
+/**
+@brief		Moves up to @p num_slots slots of a rehash in progress into the
+			new array.
+
+@param		hash_map
+				The map being rehashed.
+@param		num_slots
+				Slots of the old array to move. Passing the map's
+				@c old_map_size finishes the rehash.
+@return		The status of the move.
+*/
+ion_err_t
+oah_migrate(
+	ion_hashmap_t	*hash_map,
+	int				num_slots
+);
+
 /**
 @brief		Destroys the map in memory
 
@@ -126,6 +351,48 @@ oah_destroy(
 	ion_hashmap_t *hash_map
 );
 
+/**
+@brief		Writes every record of the map to @p file.
+
+@details	The snapshot is a short header, which includes the map's size
+			and layout, followed by the records packed key then value, written in one
+			sequential pass over the map's arrays. The map is left unchanged,
+			including any rehash in progress.
+
+@param		hash_map
+				The map to write.
+@param		file
+				A file open for writing, positioned where the snapshot starts.
+@return		The status of the write.
+*/
+ion_err_t
+oah_save(
+	ion_hashmap_t	*hash_map,
+	FILE			*file
+);
+
+/**
+@brief		Inserts the records of a snapshot written by @ref oah_save.
+
+@details	The map first takes the layout and placement of the saved map,
+			and is rehashed to the size it had if that is larger, so the
+			records go in without it growing part way. The map is expected
+			to be empty. A grouped map has to hash keys with the same
+			full-key hash as the saved one.
+
+@param		hash_map
+				An initialized map with the snapshot's key and value sizes.
+@param		file
+				A file open for reading, positioned at the snapshot.
+@return		The status of the load. err_file_read_error if the file is not
+			a snapshot of records this size, or ends early.
+*/
+ion_err_t
+oah_load(
+	ion_hashmap_t	*hash_map,
+	FILE			*file
+);
+
 /**
 @brief		Returns the theoretical location of item in hashmap
 
@@ -154,6 +421,7 @@ oah_get_location(
 			been successfully inserted, the status will reflect success.  If
 			the record can not be successfully inserted the error code will
 			reflect failure.  Will only allow for insertion of unique records.
+			A map with a @c grow_load is rehashed before it gets too full.
 
 @param	  hash_map
 				The map into which the data is going to be inserted.
@@ -194,7 +462,8 @@ oah_update(
 /**
 @brief	  Locates item in map.
 
-@details	Based on a key, function locates the record in the map.
+@details	Based on a key, function locates the record in the map. While the
+			map is being rehashed only the new array is searched.
 
 @param		hash_map
 				The map into which the data is going to be inserted.
@@ -98,16 +98,16 @@ oadict_scan(
 	while (loc != cursor->first) {
 		/* check to see if current item is a match based on key */
 		/* locate first item */
-		ion_hash_bucket_t *item = (((ion_hash_bucket_t *) ((hash_map->entry + (hash_map->super.record.key_size + hash_map->super.record.value_size + SIZEOF(STATUS)) * loc))));
+		ion_key_t key = oah_slot_key(hash_map, loc);
 
-		if ((item->status == ION_EMPTY) || (item->status == ION_DELETED)) {
+		if (NULL == key) {
 			/* if empty, just skip to next cell */
 			loc++;
 		}
 		else {
 			/* check to see if the current key value satisfies the predicate */
 
-			ion_boolean_t key_satisfies_predicate = test_predicate(&(cursor->super), item->data);	/* assumes that the key is first */
+			ion_boolean_t key_satisfies_predicate = test_predicate(&(cursor->super), key);
 
 			if (key_satisfies_predicate == boolean_true) {
 				cursor->current = loc;	/* this is the next index for value */
@@ -151,6 +151,9 @@ oadict_find(
 	ion_predicate_t		*predicate,
 	ion_dict_cursor_t	**cursor
 ) {
+	/* cursors walk a single array, so finish any rehash in progress */
+	oah_migrate((ion_hashmap_t *) dictionary->instance, ((ion_hashmap_t *) dictionary->instance)->old_map_size);
+
 	/* allocate memory for cursor */
 	if ((*cursor = malloc(sizeof(ion_oadict_cursor_t))) == NULL) {
 		return err_out_of_memory;
@@ -278,6 +281,10 @@ oadict_find(
 /**
 @brief			Opens a specific open address hash instance of a dictionary.
 
+@details		The map is rebuilt from the snapshot its last close wrote.
+				Without one, err_not_implemented has the dictionary opened
+				from a flat file instead.
+
 @param			handler
 					A pointer to the handler for the specific dictionary being opened.
 @param			dictionary
@@ -297,16 +304,52 @@ oadict_open_dictionary(
 	ion_dictionary_config_info_t	*config,
 	ion_dictionary_compare_t		compare
 ) {
-	UNUSED(handler);
-	UNUSED(dictionary);
-	UNUSED(config);
-	UNUSED(compare);
-	return err_not_implemented;
+	char		filename[ION_MAX_FILENAME_LENGTH];
+	FILE		*file;
+	ion_err_t	error;
+
+	if (dictionary_get_filename(config->id, "oas", filename) >= ION_MAX_FILENAME_LENGTH) {
+		return err_file_open_error;
+	}
+
+	file = fopen(filename, "rb");
+
+	/* without a snapshot the dictionary may have been closed to a flat file */
+	if (NULL == file) {
+		return err_not_implemented;
+	}
+
+	error = oadict_create_dictionary(config->id, config->type, config->key_size, config->value_size, config->dictionary_size, compare, handler, dictionary);
+
+	if (err_ok == error) {
+		/* a grouped map places records by the full-key hash, so it has to be bound before they go in */
+		dictionary->instance->hash_type = config->hash_type;
+		dictionary->instance->hash		= dictionary_switch_hash(config->hash_type, config->type);
+
+		error							= oah_load((ion_hashmap_t *) dictionary->instance, file);
+
+		if (err_ok != error) {
+			oadict_delete_dictionary(dictionary);
+		}
+	}
+
+	fclose(file);
+
+	/* the records live in memory until the next close writes them out again */
+	if (err_ok == error) {
+		fremove(filename);
+	}
+
+	return error;
 }
 
 /**
 @brief			Closes an open address hash instance of a dictionary.
 
+@details		The records are written to a snapshot file, from which
+				@ref oadict_open_dictionary rebuilds the map, and the map is
+				freed.
+
 @param			dictionary
 					A pointer to the specific dictionary instance to be closed.
 
@@ -316,8 +359,55 @@ ion_err_t
 oadict_close_dictionary(
 	ion_dictionary_t *dictionary
 ) {
-	UNUSED(dictionary);
-	return err_not_implemented;
+	char		filename[ION_MAX_FILENAME_LENGTH];
+	FILE		*file;
+	ion_err_t	error;
+
+	if (dictionary_get_filename(dictionary->instance->id, "oas", filename) >= ION_MAX_FILENAME_LENGTH) {
+		return err_dictionary_destruction_error;
+	}
+
+	file = fopen(filename, "wb");
+
+	if (NULL == file) {
+		return err_file_open_error;
+	}
+
+	error = oah_save((ion_hashmap_t *) dictionary->instance, file);
+
+	if ((0 != fclose(file)) && (err_ok == error)) {
+		error = err_file_close_error;
+	}
+
+	/* a partial snapshot would be loaded as if it were whole */
+	if (err_ok != error) {
+		fremove(filename);
+		return error;
+	}
+
+	return oadict_delete_dictionary(dictionary);
+}
+
+/**
+@brief			Reports the performance counters of an open address hash instance.
+
+@param			dictionary
+					A pointer to the specific dictionary instance to report on.
+@param			stats
+					The statistics to fill in.
+
+@return			The status of retrieving the statistics.
+ */
+ion_err_t
+oadict_get_stats(
+	ion_dictionary_t		*dictionary,
+	ion_dictionary_stats_t	*stats
+) {
+	ion_hashmap_t *hash_map = (ion_hashmap_t *) dictionary->instance;
+
+	*stats				= hash_map->stats;
+	stats->num_records	= hash_map->num_records;
+	return err_ok;
 }
 
 void
@@ -334,6 +424,7 @@ oadict_init(
 	handler->destroy_dictionary = oadict_destroy_dictionary;
 	handler->close_dictionary	= oadict_close_dictionary;
 	handler->open_dictionary	= oadict_open_dictionary;
+	handler->get_stats			= oadict_get_stats;
 }
 
 ion_status_t
@@ -365,6 +456,9 @@ oadict_create_dictionary(
 
 	/* this registers the dictionary the dictionary */
 	oah_initialize((ion_hashmap_t *) dictionary->instance, oah_compute_simple_hash, key_type, key_size, value_size, dictionary_size);	/* just pick an arbitary size for testing atm */
+	oah_set_resize((ion_hashmap_t *) dictionary->instance, OAH_DEFAULT_GROW_LOAD, OAH_DEFAULT_SHRINK_LOAD, OAH_DEFAULT_MIGRATE_WORK);
+	oah_set_robin_hood((ion_hashmap_t *) dictionary->instance, OAH_DEFAULT_ROBIN_HOOD);
+	oah_set_layout((ion_hashmap_t *) dictionary->instance, OAH_DEFAULT_LAYOUT);
 
 	/*TODO The correct comparison operator needs to be bound at run time
 	 * based on the type of key defined
@@ -403,8 +497,18 @@ ion_err_t
 oadict_destroy_dictionary(
 	ion_dictionary_id_t id
 ) {
-	UNUSED(id);
-	return err_not_implemented;
+	char filename[ION_MAX_FILENAME_LENGTH];
+
+	if (dictionary_get_filename(id, "oas", filename) >= ION_MAX_FILENAME_LENGTH) {
+		return err_dictionary_destruction_error;
+	}
+
+	/* No snapshot: the dictionary may still be a flat file copy, which the caller removes */
+	if (0 != fremove(filename)) {
+		return err_not_implemented;
+	}
+
+	return err_ok;
 }
 
 ion_status_t
@@ -436,9 +540,6 @@ oadict_next(
 		ion_hashmap_t *hash_map = ((ion_hashmap_t *) cursor->dictionary->instance);
 
 		/* assume that the value has been pre-allocated */
-		/* compute length of data record stored in map */
-		int data_length = hash_map->super.record.key_size + hash_map->super.record.value_size;
-
 		if (cursor->status == cs_cursor_active) {
 			/* find the next valid entry */
 
@@ -455,11 +556,9 @@ oadict_next(
 		}
 
 		/* the results are now ready //reference item at given position */
-		ion_hash_bucket_t *item = (((ion_hash_bucket_t *) ((hash_map->entry + (data_length + SIZEOF(STATUS)) * oadict_cursor->current /*idx*/))));
-
-		memcpy(record->key, (item->data), hash_map->super.record.key_size);
+		memcpy(record->key, oah_slot_key(hash_map, oadict_cursor->current), hash_map->super.record.key_size);
 
-		memcpy(record->value, (item->data + hash_map->super.record.key_size), hash_map->super.record.value_size);
+		memcpy(record->value, oah_slot_value(hash_map, oadict_cursor->current), hash_map->super.record.value_size);
 
 		/* and update current cursor position */
 		return cursor->status;
@@ -179,7 +179,9 @@ oadict_delete_dictionary(
 			for an already closed dictionary.
 @param	id
 				The identifier identifying the dictionary to delete.
-@return		The resulting status of the operation.
+@return		The resulting status of the operation. @ref err_not_implemented when
+				no snapshot existed, so that dictionary_destroy_dictionary
+				removes a flat file copy instead.
 */
 ion_err_t
 oadict_destroy_dictionary(
@@ -37,6 +37,235 @@
 #include "skip_list.h"
 /* #include "serial_c_iface.h" */
 
+/* nodes carved from a slab are aligned for their tower and for whatever their key holds */
+#define SL_NODE_ALIGN		(sizeof(double) > sizeof(void *) ? sizeof(double) : sizeof(void *))
+#define SL_ALIGN(size)		(((size) + SL_NODE_ALIGN - 1) / SL_NODE_ALIGN * SL_NODE_ALIGN)
+#define SL_SLAB_HEADER_SIZE SL_ALIGN(sizeof(ion_sl_slab_t))
+
+/* first bytes of a snapshot written by sl_save */
+#define SL_SNAPSHOT_MAGIC	0x534C5331
+
+/**
+@brief	  Header of a skiplist snapshot, followed by its records.
+*/
+typedef struct {
+	uint32_t	magic;
+	uint32_t	key_size;
+	uint32_t	value_size;
+	uint32_t	num_records;
+} ion_sl_snapshot_t;
+
+/**
+@brief	  Writes a snapshot header one field at a time, so that the file does
+			not depend on how the compiler lays out the struct.
+*/
+static ion_err_t
+sl_write_snapshot_header(
+	ion_sl_snapshot_t	*header,
+	FILE				*file
+) {
+	if ((1 != fwrite(&header->magic, sizeof(header->magic), 1, file)) || (1 != fwrite(&header->key_size, sizeof(header->key_size), 1, file)) || (1 != fwrite(&header->value_size, sizeof(header->value_size), 1, file)) || (1 != fwrite(&header->num_records, sizeof(header->num_records), 1, file))) {
+		return err_file_write_error;
+	}
+
+	return err_ok;
+}
+
+/**
+@brief	  Reads a snapshot header written by @ref sl_write_snapshot_header.
+*/
+static ion_err_t
+sl_read_snapshot_header(
+	ion_sl_snapshot_t	*header,
+	FILE				*file
+) {
+	if ((1 != fread(&header->magic, sizeof(header->magic), 1, file)) || (1 != fread(&header->key_size, sizeof(header->key_size), 1, file)) || (1 != fread(&header->value_size, sizeof(header->value_size), 1, file)) || (1 != fread(&header->num_records, sizeof(header->num_records), 1, file))) {
+		return err_file_read_error;
+	}
+
+	return err_ok;
+}
+
+/**
+@brief	  Returns the bytes a node of @p height takes in a slab.
+*/
+static int
+sl_node_size(
+	ion_skiplist_t	*skiplist,
+	ion_sl_level_t	height
+) {
+	return SL_ALIGN(sizeof(ion_sl_node_t) + (height + 1) * sizeof(ion_sl_node_t *) + skiplist->super.record.key_size + skiplist->super.record.value_size);
+}
+
+/**
+@brief	  Allocates a node of @p height, with room for its key, value and
+			tower.
+@details	A skiplist with slabs reuses a deleted node of the same height if
+			it has one, and otherwise carves the node from its newest slab.
+@return	 The node, or NULL if out of memory.
+*/
+static ion_sl_node_t *
+sl_alloc_node(
+	ion_skiplist_t	*skiplist,
+	ion_sl_level_t	height
+) {
+	ion_sl_node_t	*node;
+	ion_sl_slab_t	*slab;
+	int				size;
+
+	if (0 == skiplist->slab_size) {
+		node = malloc(sizeof(ion_sl_node_t));
+
+		if (NULL == node) {
+			return NULL;
+		}
+
+		node->key	= malloc((size_t) skiplist->super.record.key_size);
+		node->value = malloc((size_t) skiplist->super.record.value_size);
+		node->next	= malloc(sizeof(ion_sl_node_t *) * (height + 1));
+
+		if ((NULL == node->key) || (NULL == node->value) || (NULL == node->next)) {
+			free(node->key);
+			free(node->value);
+			free(node->next);
+			free(node);
+			return NULL;
+		}
+
+		node->height = height;
+		return node;
+	}
+
+	node = skiplist->free_nodes[height];
+
+	if (NULL != node) {
+		skiplist->free_nodes[height] = node->next[0];
+		return node;
+	}
+
+	size = sl_node_size(skiplist, height);
+
+	if ((NULL == skiplist->slabs) || (skiplist->slab_used + size > skiplist->slabs->size)) {
+		slab = malloc(SL_SLAB_HEADER_SIZE + (size > skiplist->slab_size ? size : skiplist->slab_size));
+
+		if (NULL == slab) {
+			return NULL;
+		}
+
+		slab->next			= skiplist->slabs;
+		slab->size			= size > skiplist->slab_size ? size : skiplist->slab_size;
+		skiplist->slabs		= slab;
+		skiplist->slab_used = 0;
+	}
+
+	node					= (ion_sl_node_t *) ((char *) skiplist->slabs + SL_SLAB_HEADER_SIZE + skiplist->slab_used);
+	skiplist->slab_used		+= size;
+	node->height			= height;
+	node->next				= (ion_sl_node_t **) (node + 1);
+	node->key				= (ion_byte_t *) (node->next + height + 1);
+	node->value				= (ion_byte_t *) node->key + skiplist->super.record.key_size;
+	return node;
+}
+
+/**
+@brief	  Frees a node, or keeps it for reuse in a skiplist with slabs.
+*/
+static void
+sl_free_node(
+	ion_skiplist_t	*skiplist,
+	ion_sl_node_t	*node
+) {
+	if (0 == skiplist->slab_size) {
+		free(node->key);
+		free(node->value);
+		free(node->next);
+		free(node);
+		return;
+	}
+
+	node->next[0]						= skiplist->free_nodes[node->height];
+	skiplist->free_nodes[node->height]	= node;
+}
+
+/**
+@brief	  Frees every slab of the skiplist, and with them every node.
+*/
+static void
+sl_free_slabs(
+	ion_skiplist_t *skiplist
+) {
+	ion_sl_slab_t *slab;
+
+	while (NULL != skiplist->slabs) {
+		slab			= skiplist->slabs;
+		skiplist->slabs = slab->next;
+		free(slab);
+	}
+
+	free(skiplist->free_nodes);
+	skiplist->free_nodes	= NULL;
+	skiplist->slab_used		= 0;
+}
+
+/**
+@brief	  Tells whether a node holding @p node_key comes before where @p key
+			is searched for: before any equal keys, or after them if
+			@p past_equal.
+*/
+static ion_boolean_t
+sl_before(
+	ion_skiplist_t	*skiplist,
+	ion_key_t		node_key,
+	ion_key_t		key,
+	ion_boolean_t	past_equal
+) {
+	int cmp = skiplist->super.compare(node_key, key, skiplist->super.record.key_size);
+
+	skiplist->stats.num_probes++;
+	return past_equal ? cmp <= 0 : cmp < 0;
+}
+
+/**
+@brief	  Leaves the finger of the skiplist at the last node of each level
+			that comes before @p key.
+
+@details	When the previous search ended before @p key, the search climbs
+			from the bottom of its finger only until a level's next node is
+			past @p key, and descends from there. Otherwise it starts over
+			from the head.
+*/
+static void
+sl_search(
+	ion_skiplist_t	*skiplist,
+	ion_key_t		key,
+	ion_boolean_t	past_equal
+) {
+	ion_sl_node_t	**finger	= skiplist->finger;
+	ion_sl_node_t	*cursor		= skiplist->head;
+	ion_sl_level_t	h			= skiplist->head->height;
+
+	skiplist->stats.num_lookups++;
+
+	if ((finger[0] == skiplist->head) || sl_before(skiplist, finger[0]->key, key, past_equal)) {
+		/* the finger above a level is never past it, so only the climb needs checking */
+		for (h = 0; h < skiplist->head->height; h++) {
+			if ((NULL == finger[h]->next[h]) || !sl_before(skiplist, finger[h]->next[h]->key, key, past_equal)) {
+				break;
+			}
+		}
+
+		cursor = finger[h];
+	}
+
+	for (; h >= 0; h--) {
+		while (NULL != cursor->next[h] && sl_before(skiplist, cursor->next[h]->key, key, past_equal)) {
+			cursor = cursor->next[h];
+		}
+
+		finger[h] = cursor;
+	}
+}
+
 ion_err_t
 sl_initialize(
 	ion_skiplist_t	*skiplist,
@@ -57,6 +286,12 @@ sl_initialize(
 	skiplist->pden						= pden;
 	skiplist->pnum						= pnum;
 
+	skiplist->slab_size					= 0;
+	skiplist->slabs						= NULL;
+	skiplist->slab_used					= 0;
+	skiplist->free_nodes				= NULL;
+	memset(&skiplist->stats, 0, sizeof(skiplist->stats));
+
 #if ION_DEBUG
 	DUMP(skip_list->super.record.key_size, "%d");
 	DUMP(skip_list->super.record.value_size, "%d");
@@ -80,23 +315,70 @@ sl_initialize(
 		return err_out_of_memory;
 	}
 
+	skiplist->finger = malloc(sizeof(ion_sl_node_t *) * skiplist->maxheight);
+
+	if (NULL == skiplist->finger) {
+		free(skiplist->head->next);
+		free(skiplist->head);
+		skiplist->head = NULL;
+		return err_out_of_memory;
+	}
+
 	skiplist->head->height	= maxheight - 1;
 	skiplist->head->key		= NULL;
 	skiplist->head->value	= NULL;
 
 	while (--maxheight >= 0) {
 		skiplist->head->next[maxheight] = NULL;
+		skiplist->finger[maxheight]		= skiplist->head;
 	}
 
 	return err_ok;
 }
 
+ion_err_t
+sl_set_slab_size(
+	ion_skiplist_t	*skiplist,
+	int				slab_size
+) {
+	if (slab_size < 0) {
+		return err_out_of_bounds;
+	}
+
+	if (NULL != skiplist->head->next[0]) {
+		return err_not_implemented;
+	}
+
+	/* an empty skiplist may still hold the slabs of deleted nodes */
+	sl_free_slabs(skiplist);
+
+	if (slab_size > 0) {
+		skiplist->free_nodes = calloc(skiplist->maxheight, sizeof(ion_sl_node_t *));
+
+		if (NULL == skiplist->free_nodes) {
+			skiplist->slab_size = 0;
+			return err_out_of_memory;
+		}
+	}
+
+	skiplist->slab_size = slab_size;
+	return err_ok;
+}
+
 ion_err_t
 sl_destroy(
 	ion_skiplist_t *skiplist
 ) {
 	ion_sl_node_t *cursor = skiplist->head, *tofree;
 
+	/* only the head is allocated apart from the slabs */
+	if ((0 != skiplist->slab_size) && (NULL != cursor)) {
+		free(cursor->next);
+		free(cursor);
+		cursor = NULL;
+		sl_free_slabs(skiplist);
+	}
+
 	while (cursor != NULL) {
 		tofree	= cursor;
 		cursor	= cursor->next[0];
@@ -107,6 +389,8 @@ sl_destroy(
 	}
 
 	skiplist->head = NULL;
+	free(skiplist->finger);
+	skiplist->finger = NULL;
 
 	return err_ok;
 }
@@ -119,87 +403,148 @@ sl_insert(
 ) {
 	ion_key_size_t		key_size	= skiplist->super.record.key_size;
 	ion_value_size_t	value_size	= skiplist->super.record.value_size;
+	ion_sl_node_t		**finger	= skiplist->finger;
+	ion_sl_node_t		*newnode;
+	ion_boolean_t		is_duplicate;
+	ion_sl_level_t		h;
 
-	ion_sl_node_t *newnode			= malloc(sizeof(ion_sl_node_t));
+	/* The search stops after any nodes with the same key, so a duplicate
+	   goes to the end of its block. */
+	sl_search(skiplist, key, boolean_true);
+	is_duplicate	= (finger[0] != skiplist->head) && (skiplist->super.compare(finger[0]->key, key, key_size) == 0);
+
+
+	/* Child duplicate nodes have no height (which is effectively 1). */
+	newnode			= sl_alloc_node(skiplist, is_duplicate ? 0 : sl_gen_level(skiplist));
 
 	if (NULL == newnode) {
 		return ION_STATUS_ERROR(err_out_of_memory);
 	}
 
-	newnode->key = malloc((size_t) key_size);
+	memcpy(newnode->key, key, key_size);
+	memcpy(newnode->value, value, value_size);
 
-	if (NULL == newnode->key) {
-		free(newnode);
-		return ION_STATUS_ERROR(err_out_of_memory);
+	/* The new node is now the last one before the next key of a sorted run */
+	for (h = 0; h <= newnode->height; h++) {
+		newnode->next[h]	= finger[h]->next[h];
+		finger[h]->next[h]	= newnode;
+		finger[h]			= newnode;
 	}
 
-	newnode->value = malloc((size_t) value_size);
-
-	if (NULL == newnode->value) {
-		free(newnode->key);
-		free(newnode);
-		return ION_STATUS_ERROR(err_out_of_memory);
+	if ((unsigned int) newnode->height + 1 > skiplist->stats.height) {
+		skiplist->stats.height = newnode->height + 1;
 	}
 
-	memcpy(newnode->key, key, key_size);
-	memcpy(newnode->value, value, value_size);
+	skiplist->stats.num_inserts++;
+	skiplist->stats.num_records++;
+	return ION_STATUS_OK(1);
+}
 
-	/* First we check if there's already a duplicate node. If there is, we're
-	   going to do a modified insert instead. */
-	ion_sl_node_t *duplicate = sl_find_node(skiplist, key);
+ion_status_t
+sl_insert_batch(
+	ion_skiplist_t	*skiplist,
+	ion_key_t		keys,
+	ion_value_t		values,
+	int				count
+) {
+	ion_key_size_t		key_size	= skiplist->super.record.key_size;
+	ion_value_size_t	value_size	= skiplist->super.record.value_size;
+	ion_byte_t			*key		= keys;
+	ion_byte_t			*value		= values;
+	ion_status_t		status		= ION_STATUS_OK(0);
+	ion_err_t			error;
+
+	for (; status.count < count; status.count++) {
+		if ((status.count > 0) && (skiplist->super.compare(key, key - key_size, key_size) < 0)) {
+			status.error = err_sorted_order_violation;
+			break;
+		}
 
-	if ((NULL != duplicate->key) && (skiplist->super.compare(duplicate->key, key, key_size) == 0)) {
-		/* Child duplicate nodes have no height (which is effectively 1). */
-		newnode->height = 0;
-		newnode->next	= malloc(sizeof(ion_sl_node_t *) * (newnode->height + 1));
+		/* each insert starts from the finger the one before left just behind it */
+		error = sl_insert(skiplist, key, value).error;
 
-		if (NULL == newnode->next) {
-			free(newnode->value);
-			free(newnode->key);
-			free(newnode);
-			return ION_STATUS_ERROR(err_out_of_memory);
+		if (err_ok != error) {
+			status.error = error;
+			break;
 		}
 
-		/* We want duplicate to be the last node in the block of duplicate
-		 * nodes, so we traverse along the bottom until we get there.
-		*/
-		while (NULL != duplicate->next[0] && skiplist->super.compare(duplicate->next[0]->key, key, key_size) == 0) {
-			duplicate = duplicate->next[0];
-		}
+		key		+= key_size;
+		value	+= value_size;
+	}
 
-		/* Only one height to worry about */
-		newnode->next[0]	= duplicate->next[0];
-		duplicate->next[0]	= newnode;
+	return status;
+}
+
+ion_err_t
+sl_save(
+	ion_skiplist_t	*skiplist,
+	FILE			*file
+) {
+	ion_key_size_t		key_size	= skiplist->super.record.key_size;
+	ion_value_size_t	value_size	= skiplist->super.record.value_size;
+	ion_sl_snapshot_t	header		= { SL_SNAPSHOT_MAGIC, key_size, value_size, 0 };
+	ion_sl_node_t		*cursor;
+	long				start		= ftell(file);
+
+	if ((start < 0) || (err_ok != sl_write_snapshot_header(&header, file))) {
+		return err_file_write_error;
 	}
-	else {
-		/* If there's no duplicate node, we do a vanilla insert instead */
-		newnode->height = sl_gen_level(skiplist);
-		newnode->next	= malloc(sizeof(ion_sl_node_t *) * (newnode->height + 1));
 
-		if (NULL == newnode->next) {
-			free(newnode->value);
-			free(newnode->key);
-			free(newnode);
-			return ION_STATUS_ERROR(err_out_of_memory);
+	for (cursor = skiplist->head->next[0]; NULL != cursor; cursor = cursor->next[0]) {
+		if ((1 != fwrite(cursor->key, key_size, 1, file)) || (1 != fwrite(cursor->value, value_size, 1, file))) {
+			return err_file_write_error;
 		}
 
-		ion_sl_node_t	*cursor = skiplist->head;
-		ion_sl_level_t	h;
+		header.num_records++;
+	}
 
-		for (h = skiplist->head->height; h >= 0; --h) {
-			/* The memcmp will return -1 if key is smaller, 0 if equal, 1 if greater. */
-			while (NULL != cursor->next[h] && skiplist->super.compare(key, cursor->next[h]->key, key_size) >= 0) {
-				cursor = cursor->next[h];
-			}
+	/* the count is only known once the records are out */
+	if ((0 != fseek(file, start, SEEK_SET)) || (err_ok != sl_write_snapshot_header(&header, file)) || (0 != fseek(file, 0, SEEK_END))) {
+		return err_file_write_error;
+	}
 
-			if (h <= newnode->height) {
-				newnode->next[h]	= cursor->next[h];
-				cursor->next[h]		= newnode;
-			}
+	return err_ok;
+}
+
+ion_err_t
+sl_load(
+	ion_skiplist_t	*skiplist,
+	FILE			*file
+) {
+	ion_key_size_t		key_size	= skiplist->super.record.key_size;
+	ion_value_size_t	value_size	= skiplist->super.record.value_size;
+	ion_sl_snapshot_t	header;
+	ion_byte_t			*record;
+	ion_err_t			error		= err_ok;
+	uint32_t			i;
+
+	if ((err_ok != sl_read_snapshot_header(&header, file)) || (SL_SNAPSHOT_MAGIC != header.magic) || ((uint32_t) key_size != header.key_size) || ((uint32_t) value_size != header.value_size)) {
+		return err_file_read_error;
+	}
+
+	record = malloc(key_size + value_size);
+
+	if (NULL == record) {
+		return err_out_of_memory;
+	}
+
+	/* in key order every insert starts from the node the one before it added */
+	for (i = 0; i < header.num_records && err_ok == error; i++) {
+		if (1 != fread(record, key_size + value_size, 1, file)) {
+			error = err_file_read_error;
+		}
+		else {
+			error = sl_insert(skiplist, record, record + key_size).error;
 		}
 	}
 
-	return ION_STATUS_OK(1);
+	free(record);
+
+	/* restoring the records is not counted as work done on them */
+	skiplist->stats.num_inserts = 0;
+	skiplist->stats.num_lookups = 0;
+	skiplist->stats.num_probes	= 0;
+	return error;
 }
 
 ion_status_t
@@ -270,44 +615,26 @@ sl_delete(
 	/* If we fall through, then we didn't find what we were looking for. */
 	status.error	= err_item_not_found;
 
-	ion_sl_node_t	*cursor = skiplist->head;
+	ion_sl_node_t	**finger = skiplist->finger;
+	ion_sl_node_t	*tofree;
 	ion_sl_level_t	h;
 
-	for (h = skiplist->head->height; h >= 0; --h) {
-		while (NULL != cursor->next[h] && skiplist->super.compare(cursor->next[h]->key, key, key_size) < 0) {
-			cursor = cursor->next[h];
-		}
-
-		if ((NULL != cursor->next[h]) && (skiplist->super.compare(cursor->next[h]->key, key, key_size) == 0)) {
-			ion_sl_node_t *oldcursor = cursor;
-
-			while (NULL != cursor->next[h] && skiplist->super.compare(cursor->next[h]->key, key, key_size) == 0) {
-				ion_sl_node_t	*tofree = cursor->next[h];
-				ion_sl_node_t	*relink = cursor->next[h];
-				ion_sl_level_t	link_h	= relink->height;
-
-				while (link_h >= 0) {
-					while (cursor->next[link_h] != relink) {
-						cursor = cursor->next[link_h];
-					}
+	/* The finger is left before the first node with the key, so it stays
+	   valid as each of them is unlinked. */
+	sl_search(skiplist, key, boolean_false);
 
-					ion_sl_node_t *jump = relink->next[link_h];
+	while (NULL != finger[0]->next[0] && skiplist->super.compare(finger[0]->next[0]->key, key, key_size) == 0) {
+		tofree = finger[0]->next[0];
 
-					cursor->next[link_h] = jump;
-					link_h--;
-				}
-
-				free(tofree->key);
-				free(tofree->value);
-				free(tofree->next);
-				free(tofree);
-
-				cursor = oldcursor;
-				status.count++;
-			}
-
-			status.error = err_ok;
+		for (h = 0; h <= tofree->height; h++) {
+			finger[h]->next[h] = tofree->next[h];
 		}
+
+		sl_free_node(skiplist, tofree);
+		status.count++;
+		status.error = err_ok;
+		skiplist->stats.num_deletes++;
+		skiplist->stats.num_records--;
 	}
 
 	return status;
@@ -318,18 +645,14 @@ sl_find_node(
 	ion_skiplist_t	*skiplist,
 	ion_key_t		key
 ) {
-	int				key_size	= skiplist->super.record.key_size;
-	ion_sl_node_t	*cursor		= skiplist->head;
-	ion_sl_level_t	h;
+	int				key_size = skiplist->super.record.key_size;
+	ion_sl_node_t	*cursor;
 
-	for (h = skiplist->head->height; h >= 0; h--) {
-		while (NULL != cursor->next[h] && skiplist->super.compare(cursor->next[h]->key, key, key_size) <= 0) {
-			if ((NULL != cursor->next[h]) && (skiplist->super.compare(cursor->next[h]->key, key, key_size) == 0)) {
-				return cursor->next[h];
-			}
+	sl_search(skiplist, key, boolean_false);
+	cursor = skiplist->finger[0];
 
-			cursor = cursor->next[h];
-		}
+	if ((NULL != cursor->next[0]) && (skiplist->super.compare(cursor->next[0]->key, key, key_size) == 0)) {
+		return cursor->next[0];
 	}
 
 	/* Key was not found, so return closest thing to that key */
@@ -44,6 +44,11 @@ extern "C" {
 #include "skip_list_types.h"
 /* #include <time.h> / * For random seed * / */
 
+/* bytes per slab of a skiplist created through the handler, unless changed with sl_set_slab_size. 0 allocates each node's parts apart */
+#if !defined(SL_DEFAULT_SLAB_SIZE)
+#define SL_DEFAULT_SLAB_SIZE	0
+#endif
+
 /**
 @brief	  Initializes an in-memory skiplist.
 
@@ -74,6 +79,32 @@ sl_initialize(
 	int				pden
 );
 
+/**
+@brief	  Sets how the skiplist allocates its nodes.
+
+@details	With a @p slab_size each node is one block, its tower, key and
+			value following the node itself, carved from slabs of that many
+			bytes. A deleted node is kept for the next node of the same
+			height, and destroying the skiplist frees its slabs rather than
+			each node. Without one, the node, key, value and tower are
+			allocated apart.
+
+			The allocation can only change while the skiplist is empty.
+
+@param	  skiplist
+				The skiplist to configure.
+@param	  slab_size
+				Bytes per slab, or 0. A node too large for a slab gets a
+				slab of its own.
+@return	 err_ok, err_out_of_bounds for a negative size, or
+			err_not_implemented if the skiplist holds records.
+*/
+ion_err_t
+sl_set_slab_size(
+	ion_skiplist_t	*skiplist,
+	int				slab_size
+);
+
 /**
 @brief	  Destroys the skiplist in memory.
 
@@ -110,6 +141,75 @@ sl_insert(
 	ion_value_t		value
 );
 
+/**
+@brief	  Inserts @p count records, in ascending key order, into the skiplist.
+
+@details	Each search starts from the path of the one before it rather than
+			from the top of the head, so a batch that follows on from the
+			keys already stored, such as timestamps, is spliced in at close
+			to constant cost per record. Records with equal keys keep their
+			order in the batch.
+
+@param	  skiplist
+				The skiplist in which to insert.
+@param	  keys
+				@p count keys, packed key_size bytes apart.
+@param	  values
+				@p count values, packed value_size bytes apart.
+@param	  count
+				Number of records to insert.
+@return	 Status of insertion, with the number of records inserted.
+			err_sorted_order_violation if a key is smaller than the one
+			before it, in which case the records before it are kept.
+*/
+ion_status_t
+sl_insert_batch(
+	ion_skiplist_t	*skiplist,
+	ion_key_t		keys,
+	ion_value_t		values,
+	int				count
+);
+
+/**
+@brief	  Writes every record of the skiplist to @p file, in key order.
+
+@details	The snapshot is a short header followed by the records packed
+			key then value, written in one sequential pass along the bottom
+			level. The skiplist is left unchanged.
+
+@param	  skiplist
+				The skiplist to write.
+@param	  file
+				A file open for writing, positioned where the snapshot starts.
+@return	 Status of the write.
+*/
+ion_err_t
+sl_save(
+	ion_skiplist_t	*skiplist,
+	FILE			*file
+);
+
+/**
+@brief	  Inserts the records of a snapshot written by @ref sl_save.
+
+@details	The records arrive in key order, so each is appended behind the
+			one before it and the skiplist is rebuilt from the bottom up in
+			one pass. The skiplist is expected to be empty.
+
+@param	  skiplist
+				An initialized skiplist with the snapshot's key and value
+				sizes.
+@param	  file
+				A file open for reading, positioned at the snapshot.
+@return	 Status of the load. err_file_read_error if the file is not a
+			snapshot of records this size, or ends early.
+*/
+ion_err_t
+sl_load(
+	ion_skiplist_t	*skiplist,
+	FILE			*file
+);
+
 /**
 @brief	  Requests the @p value stored at the given @p key.
 
@@ -182,6 +282,10 @@ sl_delete(
 			sl_query to perform key lookups. Returns the first node containing
 			the target key (if it exists), or the closest node less than the
 			target key if it does not exist.
+
+			Every search of the skiplist starts from the path of the search
+			before it when that search was for a smaller key, so runs of
+			ascending keys only walk the part of the list between them.
 */
 ion_sl_node_t *
 sl_find_node(
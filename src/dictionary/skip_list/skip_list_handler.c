@@ -116,6 +116,10 @@ sldict_next(
 /**
 @brief			Closes a skiplist instance of a dictionary.
 
+@details		The records are written to a snapshot file, from which
+				@ref sldict_open_dictionary rebuilds the skiplist, and the
+				skiplist is freed.
+
 @param			dictionary
 					A pointer to the specific dictionary instance to be closed.
 
@@ -125,8 +129,33 @@ ion_err_t
 sldict_close_dictionary(
 	ion_dictionary_t *dictionary
 ) {
-	UNUSED(dictionary);
-	return err_not_implemented;
+	char		filename[ION_MAX_FILENAME_LENGTH];
+	FILE		*file;
+	ion_err_t	error;
+
+	if (dictionary_get_filename(dictionary->instance->id, "sls", filename) >= ION_MAX_FILENAME_LENGTH) {
+		return err_dictionary_destruction_error;
+	}
+
+	file = fopen(filename, "wb");
+
+	if (NULL == file) {
+		return err_file_open_error;
+	}
+
+	error = sl_save((ion_skiplist_t *) dictionary->instance, file);
+
+	if ((0 != fclose(file)) && (err_ok == error)) {
+		error = err_file_close_error;
+	}
+
+	/* a partial snapshot would be loaded as if it were whole */
+	if (err_ok != error) {
+		fremove(filename);
+		return error;
+	}
+
+	return sldict_delete_dictionary(dictionary);
 }
 
 /**
@@ -321,6 +350,10 @@ sldict_find(
 /**
 @brief			Opens a specific skiplist instance of a dictionary.
 
+@details		The skiplist is rebuilt from the snapshot its last close
+				wrote. Without one, err_not_implemented has the dictionary
+				opened from a flat file instead.
+
 @param			handler
 					A pointer to the handler for the specific dictionary being opened.
 @param			dictionary
@@ -340,11 +373,58 @@ sldict_open_dictionary(
 	ion_dictionary_config_info_t	*config,
 	ion_dictionary_compare_t		compare
 ) {
-	UNUSED(handler);
-	UNUSED(dictionary);
-	UNUSED(config);
-	UNUSED(compare);
-	return err_not_implemented;
+	char		filename[ION_MAX_FILENAME_LENGTH];
+	FILE		*file;
+	ion_err_t	error;
+
+	if (dictionary_get_filename(config->id, "sls", filename) >= ION_MAX_FILENAME_LENGTH) {
+		return err_file_open_error;
+	}
+
+	file = fopen(filename, "rb");
+
+	/* without a snapshot the dictionary may have been closed to a flat file */
+	if (NULL == file) {
+		return err_not_implemented;
+	}
+
+	error = sldict_create_dictionary(config->id, config->type, config->key_size, config->value_size, config->dictionary_size, compare, handler, dictionary);
+
+	if (err_ok == error) {
+		error = sl_load((ion_skiplist_t *) dictionary->instance, file);
+
+		if (err_ok != error) {
+			sldict_delete_dictionary(dictionary);
+		}
+	}
+
+	fclose(file);
+
+	/* the records live in memory until the next close writes them out again */
+	if (err_ok == error) {
+		fremove(filename);
+	}
+
+	return error;
+}
+
+/**
+@brief			Reports the performance counters of a skip list instance.
+
+@param			dictionary
+					A pointer to the specific dictionary instance to report on.
+@param			stats
+					The statistics to fill in.
+
+@return			The status of retrieving the statistics.
+ */
+ion_err_t
+sldict_get_stats(
+	ion_dictionary_t		*dictionary,
+	ion_dictionary_stats_t	*stats
+) {
+	*stats = ((ion_skiplist_t *) dictionary->instance)->stats;
+	return err_ok;
 }
 
 void
@@ -361,6 +441,7 @@ sldict_init(
 	handler->find				= sldict_find;
 	handler->close_dictionary	= sldict_close_dictionary;
 	handler->open_dictionary	= sldict_open_dictionary;
+	handler->get_stats			= sldict_get_stats;
 }
 
 ion_status_t
@@ -372,6 +453,16 @@ sldict_insert(
 	return sl_insert((ion_skiplist_t *) dictionary->instance, key, value);
 }
 
+ion_status_t
+sldict_insert_batch(
+	ion_dictionary_t	*dictionary,
+	ion_key_t			keys,
+	ion_value_t			values,
+	int					count
+) {
+	return sl_insert_batch((ion_skiplist_t *) dictionary->instance, keys, values, count);
+}
+
 ion_err_t
 sldict_create_dictionary(
 	ion_dictionary_id_t			id,
@@ -401,6 +492,10 @@ sldict_create_dictionary(
 
 	ion_err_t result = sl_initialize((ion_skiplist_t *) dictionary->instance, key_type, key_size, value_size, dictionary_size, pnum, pden);
 
+	if (err_ok == result) {
+		result = sl_set_slab_size((ion_skiplist_t *) dictionary->instance, SL_DEFAULT_SLAB_SIZE);
+	}
+
 	if ((err_ok == result) && (NULL != handler)) {
 		dictionary->handler = handler;
 	}
@@ -431,8 +526,18 @@ ion_err_t
 sldict_destroy_dictionary(
 	ion_dictionary_id_t id
 ) {
-	UNUSED(id);
-	return err_not_implemented;
+	char filename[ION_MAX_FILENAME_LENGTH];
+
+	if (dictionary_get_filename(id, "sls", filename) >= ION_MAX_FILENAME_LENGTH) {
+		return err_dictionary_destruction_error;
+	}
+
+	/* No snapshot: the dictionary may still be a flat file copy, which the caller removes */
+	if (0 != fremove(filename)) {
+		return err_not_implemented;
+	}
+
+	return err_ok;
 }
 
 ion_status_t
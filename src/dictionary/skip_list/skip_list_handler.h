@@ -77,6 +77,32 @@ sldict_insert(
 	ion_value_t			value
 );
 
+/**
+@brief	  Inserts @p count records, in ascending key order, into the
+			dictionary in one pass.
+
+@details	See @ref sl_insert_batch. Suited to keys that arrive in order,
+			such as timestamps, which are appended at close to constant cost
+			per record.
+
+@param	  dictionary
+				The dictionary instance to insert the records into.
+@param	  keys
+				@p count keys, packed key_size bytes apart.
+@param	  values
+				@p count values, packed value_size bytes apart.
+@param	  count
+				Number of records to insert.
+@return	 Status of insertion, with the number of records inserted.
+*/
+ion_status_t
+sldict_insert_batch(
+	ion_dictionary_t	*dictionary,
+	ion_key_t			keys,
+	ion_value_t			values,
+	int					count
+);
+
 /**
 @brief	  Creates an instance of a dictionary.
 
@@ -147,7 +173,9 @@ sldict_delete_dictionary(
 @brief	  Deletes an instance of a closed dictionary.
 @param	  id
 				The identifier identifying the dictionary to destroy.
-@return	 Status of dictionary deletion.
+@return	 Status of dictionary deletion. @ref err_not_implemented when
+				no snapshot existed, so that dictionary_destroy_dictionary
+				removes a flat file copy instead.
 */
 ion_err_t
 sldict_destroy_dictionary(
@@ -60,6 +60,15 @@ typedef struct sl_node {
 									 column in the skiplist */
 } ion_sl_node_t;
 
+/**
+@brief  Header of a slab that skiplist nodes are carved from. The nodes
+		follow it.
+*/
+typedef struct sl_slab {
+	struct sl_slab	*next;		/**< The slab allocated before this one */
+	int				size;		/**< Bytes of nodes the slab holds */
+} ion_sl_slab_t;
+
 /**
 @brief  Struct of the Skiplist, holds metadata and the entry point
 		into the skiplist.
@@ -73,6 +82,16 @@ typedef struct skiplist {
 										the number of nodes */
 	int						pnum;	/**< Probability NUMerator, used in height gen */
 	int						pden;	/**< Probability DENominator, used in height gen */
+	int						slab_size;	/**< Bytes of nodes per slab, or 0 to
+										allocate the parts of each node apart */
+	ion_sl_slab_t			*slabs;	/**< Slabs in use, newest first */
+	int						slab_used;	/**< Bytes of the newest slab handed
+										out */
+	ion_sl_node_t			**free_nodes;	/**< Deleted nodes of each height,
+											linked through next[0] */
+	ion_sl_node_t			**finger;	/**< Path of the last search: the
+										node each level was left at */
+	ion_dictionary_stats_t	stats;	/**< Performance counters */
 } ion_skiplist_t;
 
 typedef struct
@@ -34,8 +34,33 @@
 */
 /******************************************************************************/
 
+/* pread and pwrite under -std=c99, and preadv and pwritev */
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
 #include "ion_file.h"
 
+#if !defined(ARDUINO) && ION_FILE_POSIX
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#include <sys/uio.h>
+#define ION_FILE_HAS_PREADV 1
+#endif
+#endif
+
+#if !defined(ION_FILE_HAS_PREADV)
+#define ION_FILE_HAS_PREADV 0
+#endif
+
 ion_boolean_t
 ion_fexists(
 	char *name
@@ -62,6 +87,32 @@ ion_fopen(
 	}
 
 	return toret;
+#elif ION_FILE_POSIX
+
+	ion_file_handle_t	file;
+	struct stat			info;
+
+	file = malloc(sizeof(ion_posix_file_t));
+
+	if (NULL == file) {
+		return ION_NOFILE;
+	}
+
+	file->fd = open(name, O_RDWR | O_CREAT, 0644);
+
+	if ((-1 == file->fd) || (0 != fstat(file->fd, &info))) {
+		if (-1 != file->fd) {
+			close(file->fd);
+		}
+
+		free(file);
+		return ION_NOFILE;
+	}
+
+	file->position	= 0;
+	file->size		= (ion_file_offset_t) info.st_size;
+
+	return file;
 #else
 
 	ion_file_handle_t file;
@@ -83,6 +134,12 @@ ion_fclose(
 #if defined(ARDUINO)
 	fclose(file.file);
 	return err_ok;
+#elif ION_FILE_POSIX
+
+	int status = close(file->fd);
+
+	free(file);
+	return (0 == status) ? err_ok : err_file_close_error;
 #else
 	fclose(file);
 	return err_ok;
@@ -117,6 +174,22 @@ ion_fseek(
 		return err_file_bad_seek;
 	}
 
+	return err_ok;
+#elif ION_FILE_POSIX
+
+	/* nothing to ask the system, the next read or write says where */
+	if (SEEK_END == origin) {
+		seek_to += file->size;
+	}
+	else if (SEEK_CUR == origin) {
+		seek_to += file->position;
+	}
+
+	if (seek_to < 0) {
+		return err_file_bad_seek;
+	}
+
+	file->position = seek_to;
 	return err_ok;
 #else
 
@@ -134,6 +207,8 @@ ion_ftell(
 ) {
 #if defined(ARDUINO)
 	return ftell(file.file);
+#elif ION_FILE_POSIX
+	return file->position;
 #else
 	return ftell(file);
 #endif
@@ -143,6 +218,10 @@ ion_file_offset_t
 ion_fend(
 	ion_file_handle_t file
 ) {
+#if !defined(ARDUINO) && ION_FILE_POSIX
+	return file->size;
+#else
+
 	ion_file_offset_t	previous;
 	ion_file_offset_t	to_return;
 
@@ -152,6 +231,7 @@ ion_fend(
 	ion_fseek(file, previous, ION_FILE_START);
 
 	return to_return;
+#endif
 }
 
 ion_err_t
@@ -167,6 +247,15 @@ ion_fwrite(
 	}
 
 	return err_ok;
+#elif ION_FILE_POSIX
+
+	ion_err_t error = ion_fwrite_at(file, file->position, num_bytes, to_write);
+
+	if (err_ok == error) {
+		file->position += num_bytes;
+	}
+
+	return error;
 #else
 	fwrite(to_write, num_bytes, 1, file);
 	return err_ok;
@@ -180,6 +269,37 @@ ion_fwrite_at(
 	unsigned int		num_bytes,
 	ion_byte_t			*to_write
 ) {
+#if !defined(ARDUINO) && ION_FILE_POSIX
+
+	ssize_t written;
+
+	if (offset < 0) {
+		return err_file_bad_seek;
+	}
+
+	while (num_bytes > 0) {
+		written = pwrite(file->fd, to_write, num_bytes, offset);
+
+		if (written < 0) {
+			if (EINTR == errno) {
+				continue;
+			}
+
+			return err_file_write_error;
+		}
+
+		to_write	+= written;
+		offset		+= written;
+		num_bytes	-= (unsigned int) written;
+	}
+
+	if (offset > file->size) {
+		file->size = offset;
+	}
+
+	return err_ok;
+#else
+
 	ion_err_t error;
 
 	error = ion_fseek(file, offset, ION_FILE_START);
@@ -190,6 +310,7 @@ ion_fwrite_at(
 
 	error = ion_fwrite(file, num_bytes, to_write);
 	return error;
+#endif
 }
 
 ion_err_t
@@ -223,6 +344,15 @@ ion_fread(
 	}
 
 	return err_ok;
+#elif ION_FILE_POSIX
+
+	ion_err_t error = ion_fread_at(file, file->position, num_bytes, write_to);
+
+	if (err_ok == error) {
+		file->position += num_bytes;
+	}
+
+	return error;
 #else
 
 	if (1 != fread(write_to, num_bytes, 1, file)) {
@@ -240,6 +370,38 @@ ion_fread_at(
 	unsigned int		num_bytes,
 	ion_byte_t			*write_to
 ) {
+#if !defined(ARDUINO) && ION_FILE_POSIX
+
+	ssize_t got;
+
+	if (offset < 0) {
+		return err_file_bad_seek;
+	}
+
+	/* a read past the end fails whole, as fread of one item would */
+	while (num_bytes > 0) {
+		got = pread(file->fd, write_to, num_bytes, offset);
+
+		if (got < 0) {
+			if (EINTR == errno) {
+				continue;
+			}
+
+			return err_file_read_error;
+		}
+
+		if (0 == got) {
+			return err_file_read_error;
+		}
+
+		write_to	+= got;
+		offset		+= got;
+		num_bytes	-= (unsigned int) got;
+	}
+
+	return err_ok;
+#else
+
 	ion_err_t error;
 
 	error = ion_fseek(file, offset, ION_FILE_START);
@@ -250,4 +412,132 @@ ion_fread_at(
 
 	error = ion_fread(file, num_bytes, write_to);
 	return error;
+#endif
+}
+
+#if ION_FILE_HAS_PREADV
+
+/**
+@brief		Reads or writes a run of adjacent pieces with one call.
+@details	If the system moves fewer bytes than asked, the rest of the run
+			is moved a piece at a time.
+@return		The status of the transfer.
+*/
+static ion_err_t
+ion_fvector_run(
+	ion_file_handle_t	file,
+	ion_file_io_t		*ios,
+	int					count,
+	ion_boolean_t		write
+) {
+	struct iovec	iov[ION_FILE_MAX_IOV];
+	ssize_t			total	= 0;
+	ssize_t			done;
+	ion_err_t		error;
+	int				i;
+
+	for (i = 0; i < count; i++) {
+		iov[i].iov_base = ios[i].buffer;
+		iov[i].iov_len	= ios[i].num_bytes;
+		total			+= ios[i].num_bytes;
+	}
+
+	do {
+		done = write ? pwritev(file->fd, iov, count, ios[0].offset) : preadv(file->fd, iov, count, ios[0].offset);
+	} while (done < 0 && EINTR == errno);
+
+	if (done < 0) {
+		return write ? err_file_write_error : err_file_read_error;
+	}
+
+	if (write && (ios[0].offset + done > file->size)) {
+		file->size = ios[0].offset + done;
+	}
+
+	for (i = 0; i < count && done < total; i++) {
+		if ((ssize_t) ios[i].num_bytes <= done) {
+			done	-= ios[i].num_bytes;
+			total	-= ios[i].num_bytes;
+			continue;
+		}
+
+		if (write) {
+			error = ion_fwrite_at(file, ios[i].offset + done, ios[i].num_bytes - (unsigned int) done, ios[i].buffer + done);
+		}
+		else {
+			error = ion_fread_at(file, ios[i].offset + done, ios[i].num_bytes - (unsigned int) done, ios[i].buffer + done);
+		}
+
+		if (err_ok != error) {
+			return error;
+		}
+
+		done = 0;
+	}
+
+	return err_ok;
+}
+
+#endif
+
+/**
+@brief		Moves each piece, a run of adjacent pieces at a time where the
+			system has vectored reads and writes.
+@return		The status of the transfer.
+*/
+static ion_err_t
+ion_fvector(
+	ion_file_handle_t	file,
+	ion_file_io_t		*ios,
+	int					count,
+	ion_boolean_t		write
+) {
+	ion_err_t	error;
+	int			i;
+	int			run;
+
+	for (i = 0; i < count; i += run) {
+		run = 1;
+#if ION_FILE_HAS_PREADV
+
+		while ((i + run < count) && (run < ION_FILE_MAX_IOV) && (ios[i + run - 1].offset + (ion_file_offset_t) ios[i + run - 1].num_bytes == ios[i + run].offset)) {
+			run++;
+		}
+
+		if (run > 1) {
+			error = ion_fvector_run(file, ios + i, run, write);
+		}
+		else
+#endif
+		if (write) {
+			error = ion_fwrite_at(file, ios[i].offset, ios[i].num_bytes, ios[i].buffer);
+		}
+		else {
+			error = ion_fread_at(file, ios[i].offset, ios[i].num_bytes, ios[i].buffer);
+		}
+
+		if (err_ok != error) {
+			return error;
+		}
+	}
+
+	return err_ok;
+}
+
+ion_err_t
+ion_fwritev_at(
+	ion_file_handle_t	file,
+	ion_file_io_t		*ios,
+	int					count
+) {
+	return ion_fvector(file, ios, count, boolean_true);
+}
+
+ion_err_t
+ion_freadv_at(
+	ion_file_handle_t	file,
+	ion_file_io_t		*ios,
+	int					count
+) {
+	return ion_fvector(file, ios, count, boolean_false);
 }
@@ -66,14 +66,62 @@ typedef struct file_handle {
 #include "stdio.h"
 #include "unistd.h"
 
+/* whether files are file descriptors read and written with pread and pwrite rather than stdio streams */
+#if !defined(ION_FILE_POSIX)
+#if defined(__unix__) || defined(__APPLE__)
+#define ION_FILE_POSIX 1
+#else
+#define ION_FILE_POSIX 0
+#endif
+#endif
+
+#if ION_FILE_POSIX
+
+/**
+@brief		An open file, read and written at explicit offsets.
+@details	Reads and writes at an offset do not move @p position, so any
+			number of readers may share one handle.
+*/
+typedef struct {
+	/**> The file descriptor. */
+	int					fd;
+	/**> Where ion_fread and ion_fwrite carry on from. */
+	ion_file_offset_t	position;
+	/**> Length of the file, kept up to date by writes through this handle. */
+	ion_file_offset_t	size;
+} ion_posix_file_t;
+
+typedef ion_posix_file_t *ion_file_handle_t;
+
+#else
+
 typedef FILE *ion_file_handle_t;
 
+#endif
+
 #define ION_NOFILE ((ion_file_handle_t) (NULL))
 
 #endif /* Clause ARDUINO */
 
 #define ION_FILE_NULL -1
 
+/* most pieces handed to the system in one vectored read or write */
+#if !defined(ION_FILE_MAX_IOV)
+#define ION_FILE_MAX_IOV 64
+#endif
+
+/**
+@brief		One piece of a vectored read or write.
+*/
+typedef struct {
+	/**> Where in the file the piece starts. */
+	ion_file_offset_t	offset;
+	/**> Length of the piece. */
+	unsigned int		num_bytes;
+	/**> Memory the piece is read into or written from. */
+	ion_byte_t			*buffer;
+} ion_file_io_t;
+
 ion_boolean_t
 ion_fexists(
 	char *name
@@ -141,6 +189,45 @@ ion_fread_at(
 	ion_byte_t			*write_to
 );
 
+/**
+@brief		Writes several pieces of a file.
+@details	Pieces are written in the order given.  A run of pieces that
+			each start where the one before ends is written with one call
+			where the system has vectored writes.
+@param		file
+				The file to write to.
+@param		ios
+				The pieces to write.
+@param		count
+				The number of pieces in @p ios.
+@return		The status of the writes.
+*/
+ion_err_t
+ion_fwritev_at(
+	ion_file_handle_t	file,
+	ion_file_io_t		*ios,
+	int					count
+);
+
+/**
+@brief		Reads several pieces of a file.
+@details	As @ref ion_fwritev_at, a run of adjacent pieces is read with
+			one call where the system has vectored reads.
+@param		file
+				The file to read from.
+@param		ios
+				The pieces to read.
+@param		count
+				The number of pieces in @p ios.
+@return		The status of the reads.
+*/
+ion_err_t
+ion_freadv_at(
+	ion_file_handle_t	file,
+	ion_file_io_t		*ios,
+	int					count
+);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,813 @@
+/******************************************************************************/
+/**
+@file		record_heap.c
+@brief		Implementation of a persistent heap of records kept in slotted
+			pages.
+@copyright	Copyright 2017
+			The University of British Columbia,
+			IonDB Project Contributors (see AUTHORS.md)
+@par Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+@par 1.Redistributions of source code must retain the above copyright notice,
+	this list of conditions and the following disclaimer.
+
+@par 2.Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+@par 3.Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+@par THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+	ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+	LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+	CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+	SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+	INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+	CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+	ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+/******************************************************************************/
+
+#include "record_heap.h"
+
+/* bytes of a cell before its record */
+#define RH_OVERHEAD			(sizeof(ion_rh_cell_t) + sizeof(ion_file_offset_t))
+
+#define RH_CELL_SIZE(cell)	((uint32_t) ((cell) & ~ION_RH_CELL_FREE))
+
+/* the header: magic, page size, and how many pages the free-space map after it covers */
+#define RH_HEADER_WORDS		3
+
+/* pages after the first whose free space fits in the header page */
+#define RH_MAP_PAGES(heap)	((ion_file_offset_t) (((heap)->page_size - RH_HEADER_WORDS * sizeof(uint32_t)) / sizeof(uint32_t)))
+
+/**
+@brief		Finds where the cells of a page end and how much of them is free.
+*/
+static void
+rh_scan(
+	ion_rh_t		*heap,
+	ion_rh_frame_t	*frame
+) {
+	ion_rh_cell_t	cell;
+	uint32_t		pos;
+	uint32_t		size;
+
+	frame->holes = 0;
+
+	for (pos = 0; pos + sizeof(ion_rh_cell_t) <= heap->page_size; pos += size) {
+		memcpy(&cell, frame->image + pos, sizeof(ion_rh_cell_t));
+		size = RH_CELL_SIZE(cell);
+
+		if ((size < RH_OVERHEAD) || (pos + size > heap->page_size)) {
+			break;
+		}
+
+		if (cell & ION_RH_CELL_FREE) {
+			frame->holes += size;
+		}
+	}
+
+	frame->tail = pos;
+}
+
+/**
+@brief		Records in the free-space map the room a held page has.
+*/
+static void
+rh_note(
+	ion_rh_t		*heap,
+	ion_rh_frame_t	*frame
+) {
+	heap->free_space[frame->page] = frame->holes + heap->page_size - frame->tail;
+}
+
+/**
+@brief		Brings a page into memory, writing back the least recently used
+			page if it must make room.
+@param		heap
+				The record heap.
+@param		page
+				The page to bring in.
+@param		fresh
+				Whether the page is new to the heap, and so starts empty
+				rather than being read.
+@param		frame
+				Written with the frame holding the page.
+@returns	An error code describing the result of the call.
+*/
+static ion_err_t
+rh_load(
+	ion_rh_t			*heap,
+	ion_file_offset_t	page,
+	ion_boolean_t		fresh,
+	ion_rh_frame_t		**frame
+) {
+	ion_rh_frame_t	*victim;
+	ion_err_t		error;
+	int				i;
+
+	heap->tick++;
+	victim = &heap->frames[0];
+
+	for (i = 0; i < ION_RH_CACHE_PAGES; i++) {
+		if (heap->frames[i].page == page) {
+			heap->frames[i].stamp	= heap->tick;
+			*frame					= &heap->frames[i];
+			return err_ok;
+		}
+
+		if (heap->frames[i].stamp < victim->stamp) {
+			victim = &heap->frames[i];
+		}
+	}
+
+	if (victim->dirty) {
+		error = ion_fwrite_at(heap->file_handle, victim->page * heap->page_size, heap->page_size, victim->image);
+
+		if (err_ok != error) {
+			return error;
+		}
+
+		victim->dirty = boolean_false;
+	}
+
+	victim->page = ION_RH_NULL;
+
+	if (fresh) {
+		memset(victim->image, 0, heap->page_size);
+		victim->dirty = boolean_true;
+	}
+	else {
+		error = ion_fread_at(heap->file_handle, page * heap->page_size, heap->page_size, victim->image);
+
+		if (err_ok != error) {
+			return error;
+		}
+	}
+
+	victim->page	= page;
+	victim->stamp	= heap->tick;
+	rh_scan(heap, victim);
+
+	*frame			= victim;
+	return err_ok;
+}
+
+/**
+@brief		Ends the cells of a page at @p pos.
+*/
+static void
+rh_end_cells(
+	ion_rh_t		*heap,
+	ion_rh_frame_t	*frame,
+	uint32_t		pos
+) {
+	frame->tail = pos;
+
+	if (pos + sizeof(ion_rh_cell_t) <= heap->page_size) {
+		memset(frame->image + pos, 0, sizeof(ion_rh_cell_t));
+	}
+}
+
+/**
+@brief		Finds room for a cell on a held page.
+@details	The end of the cells is used if it has room, otherwise the first
+			free cell large enough, joining neighbouring free cells as they
+			are passed.  A free cell is split if the rest can hold a cell.
+@param		heap
+				The record heap.
+@param		frame
+				The frame holding the page.
+@param		size
+				The size of the cell wanted, written with the size taken.
+@param		pos
+				Written with where the cell starts in the page.
+@returns	Whether the cell fits.
+*/
+static ion_boolean_t
+rh_place(
+	ion_rh_t		*heap,
+	ion_rh_frame_t	*frame,
+	uint32_t		*size,
+	uint32_t		*pos
+) {
+	ion_rh_cell_t	cell;
+	uint32_t		cell_size;
+	uint32_t		largest;
+	uint32_t		p;
+
+	largest = heap->page_size - frame->tail;
+
+	if (*size <= largest) {
+		*pos = frame->tail;
+		rh_end_cells(heap, frame, frame->tail + *size);
+		return boolean_true;
+	}
+
+	if (frame->holes < *size) {
+		heap->free_space[frame->page] = frame->holes > largest ? frame->holes : largest;
+		return boolean_false;
+	}
+
+	frame->dirty = boolean_true;
+
+	for (p = 0; p < frame->tail; p += cell_size) {
+		memcpy(&cell, frame->image + p, sizeof(ion_rh_cell_t));
+		cell_size = RH_CELL_SIZE(cell);
+
+		if (!(cell & ION_RH_CELL_FREE)) {
+			continue;
+		}
+
+		while (p + cell_size < frame->tail) {
+			memcpy(&cell, frame->image + p + cell_size, sizeof(ion_rh_cell_t));
+
+			if (!(cell & ION_RH_CELL_FREE)) {
+				break;
+			}
+
+			cell_size += RH_CELL_SIZE(cell);
+		}
+
+		if (p + cell_size == frame->tail) {
+			/* free cells at the end of the page go back to the end */
+			frame->holes -= cell_size;
+			rh_end_cells(heap, frame, p);
+
+			if (*size <= heap->page_size - p) {
+				*pos = p;
+				rh_end_cells(heap, frame, p + *size);
+				return boolean_true;
+			}
+
+			if (heap->page_size - p > largest) {
+				largest = heap->page_size - p;
+			}
+
+			break;
+		}
+
+		if (cell_size >= *size) {
+			if (cell_size - *size >= RH_OVERHEAD) {
+				cell = (cell_size - *size) | ION_RH_CELL_FREE;
+				memcpy(frame->image + p + *size, &cell, sizeof(ion_rh_cell_t));
+			}
+			else {
+				*size = cell_size;
+			}
+
+			frame->holes	-= *size;
+			*pos			= p;
+			return boolean_true;
+		}
+
+		cell = cell_size | ION_RH_CELL_FREE;
+		memcpy(frame->image + p, &cell, sizeof(ion_rh_cell_t));
+
+		if (cell_size > largest) {
+			largest = cell_size;
+		}
+	}
+
+	/* the free space is in pieces too small; remember the largest */
+	heap->free_space[frame->page] = largest;
+	return boolean_false;
+}
+
+/**
+@brief		Finds room for a cell on a page, if the free-space map says it
+			may have some.
+@param		placed
+				Written with whether room was found, in which case @p frame
+				and @p pos say where.
+@returns	An error code describing the result of the call.
+*/
+static ion_err_t
+rh_place_on(
+	ion_rh_t			*heap,
+	ion_file_offset_t	page,
+	uint32_t			*size,
+	ion_rh_frame_t		**frame,
+	uint32_t			*pos,
+	ion_boolean_t		*placed
+) {
+	ion_err_t error;
+
+	*placed = boolean_false;
+
+	if ((page < 1) || (page >= heap->num_pages) || (heap->free_space[page] < *size)) {
+		return err_ok;
+	}
+
+	error = rh_load(heap, page, boolean_false, frame);
+
+	if (err_ok != error) {
+		return error;
+	}
+
+	*placed = rh_place(heap, *frame, size, pos);
+	return err_ok;
+}
+
+/**
+@brief		Brings in the page holding the record at @p offset.
+@param		at
+				Written with where the record starts in the page.
+@returns	An error code describing the result of the call.
+*/
+static ion_err_t
+rh_locate(
+	ion_rh_t			*heap,
+	ion_file_offset_t	offset,
+	ion_rh_frame_t		**frame,
+	uint32_t			*at
+) {
+	ion_file_offset_t	page;
+	ion_err_t			error;
+
+	page = offset / heap->page_size;
+
+	if ((offset < 0) || (page < 1) || (page >= heap->num_pages)) {
+		return err_out_of_bounds;
+	}
+
+	*at = (uint32_t) (offset - page * heap->page_size);
+
+	if ((*at < sizeof(ion_rh_cell_t)) || (*at + sizeof(ion_file_offset_t) > heap->page_size)) {
+		return err_out_of_bounds;
+	}
+
+	error = rh_load(heap, page, boolean_false, frame);
+
+	return error;
+}
+
+ion_err_t
+rh_open(
+	ion_rh_t			*heap,
+	ion_file_handle_t	file_handle,
+	unsigned int		max_record_size
+) {
+	uint32_t			header[RH_HEADER_WORDS];
+	ion_file_offset_t	end;
+	ion_file_offset_t	page;
+	ion_file_offset_t	mapped;
+	ion_byte_t			*images;
+	ion_err_t			error;
+	int					i;
+
+	heap->file_handle	= file_handle;
+	heap->free_space	= NULL;
+	heap->tick			= 0;
+
+	for (i = 0; i < ION_RH_CACHE_PAGES; i++) {
+		heap->frames[i].page	= ION_RH_NULL;
+		heap->frames[i].image	= NULL;
+		heap->frames[i].dirty	= boolean_false;
+		heap->frames[i].stamp	= 0;
+	}
+
+	end = ion_fend(file_handle);
+
+	if (0 == end) {
+		heap->page_size = ION_RH_DEFAULT_PAGE_SIZE;
+
+		if (heap->page_size < RH_OVERHEAD + max_record_size) {
+			heap->page_size = (RH_OVERHEAD + max_record_size + ION_RH_DEFAULT_PAGE_SIZE - 1) / ION_RH_DEFAULT_PAGE_SIZE * ION_RH_DEFAULT_PAGE_SIZE;
+		}
+
+		header[0]	= ION_RH_MAGIC;
+		header[1]	= heap->page_size;
+		header[2]	= 0;
+		error		= ion_fwrite_at(file_handle, 0, sizeof(header), (ion_byte_t *) header);
+
+		if (err_ok != error) {
+			return error;
+		}
+	}
+	else {
+		error = ion_fread_at(file_handle, 0, sizeof(header), (ion_byte_t *) header);
+
+		if (err_ok != error) {
+			return error;
+		}
+
+		if ((ION_RH_MAGIC != header[0]) || (header[1] < RH_OVERHEAD + sizeof(header))) {
+			return err_file_read_error;
+		}
+
+		heap->page_size = header[1];
+
+		if (heap->page_size < RH_OVERHEAD + max_record_size) {
+			return err_out_of_bounds;
+		}
+	}
+
+	heap->num_pages		= (end + heap->page_size - 1) / heap->page_size;
+
+	if (heap->num_pages < 1) {
+		heap->num_pages = 1;
+	}
+
+	heap->reuse_page	= 1;
+	heap->free_space	= malloc(heap->num_pages * sizeof(uint32_t));
+	/* the images of all frames are one block, freed through the first */
+	images				= malloc(ION_RH_CACHE_PAGES * heap->page_size);
+
+	if ((NULL == heap->free_space) || (NULL == images)) {
+		free(heap->free_space);
+		free(images);
+		heap->free_space = NULL;
+		return err_out_of_memory;
+	}
+
+	for (i = 0; i < ION_RH_CACHE_PAGES; i++) {
+		heap->frames[i].image = images + i * heap->page_size;
+	}
+
+	/* a page the stored map does not cover may have room, until a put looks at it */
+	heap->free_space[0] = 0;
+
+	for (page = 1; page < heap->num_pages; page++) {
+		heap->free_space[page] = heap->page_size;
+	}
+
+	mapped = header[2];
+
+	if (mapped > heap->num_pages - 1) {
+		mapped = heap->num_pages - 1;
+	}
+
+	if (mapped > 0) {
+		error = ion_fread_at(file_handle, sizeof(header), mapped * sizeof(uint32_t), (ion_byte_t *) (heap->free_space + 1));
+
+		/* the map is stale once anything changes, until it is written again on close */
+		if (err_ok == error) {
+			header[2]	= 0;
+			error		= ion_fwrite_at(file_handle, 2 * sizeof(uint32_t), sizeof(uint32_t), (ion_byte_t *) &header[2]);
+		}
+
+		if (err_ok != error) {
+			free(heap->free_space);
+			free(images);
+			heap->free_space = NULL;
+
+			for (i = 0; i < ION_RH_CACHE_PAGES; i++) {
+				heap->frames[i].image = NULL;
+			}
+
+			return error;
+		}
+	}
+
+	return err_ok;
+}
+
+ion_err_t
+rh_flush(
+	ion_rh_t *heap
+) {
+	ion_file_io_t	ios[ION_RH_CACHE_PAGES];
+	ion_rh_frame_t	*dirty[ION_RH_CACHE_PAGES];
+	ion_rh_frame_t	*frame;
+	ion_err_t		error;
+	int				count;
+	int				i;
+	int				j;
+
+	count = 0;
+
+	/* in page order, so neighbouring pages go out in one write */
+	for (i = 0; i < ION_RH_CACHE_PAGES; i++) {
+		if (!heap->frames[i].dirty) {
+			continue;
+		}
+
+		frame = &heap->frames[i];
+
+		for (j = count; j > 0 && dirty[j - 1]->page > frame->page; j--) {
+			dirty[j] = dirty[j - 1];
+		}
+
+		dirty[j] = frame;
+		count++;
+	}
+
+	for (i = 0; i < count; i++) {
+		ios[i].offset		= dirty[i]->page * heap->page_size;
+		ios[i].num_bytes	= heap->page_size;
+		ios[i].buffer		= dirty[i]->image;
+	}
+
+	error = ion_fwritev_at(heap->file_handle, ios, count);
+
+	if (err_ok == error) {
+		for (i = 0; i < count; i++) {
+			dirty[i]->dirty = boolean_false;
+		}
+	}
+
+	return error;
+}
+
+ion_err_t
+rh_close(
+	ion_rh_t *heap
+) {
+	ion_file_offset_t	mapped;
+	uint32_t			count;
+	ion_err_t			error;
+	int					i;
+
+	error = err_ok;
+
+	if (NULL != heap->frames[0].image) {
+		error = rh_flush(heap);
+	}
+
+	/* the free-space map goes after the header, so the next open need not look at every page */
+	if ((err_ok == error) && (NULL != heap->free_space) && (heap->num_pages > 1)) {
+		mapped = heap->num_pages - 1;
+
+		if (mapped > RH_MAP_PAGES(heap)) {
+			mapped = RH_MAP_PAGES(heap);
+		}
+
+		error = ion_fwrite_at(heap->file_handle, RH_HEADER_WORDS * sizeof(uint32_t), mapped * sizeof(uint32_t), (ion_byte_t *) (heap->free_space + 1));
+
+		if (err_ok == error) {
+			count	= (uint32_t) mapped;
+			error	= ion_fwrite_at(heap->file_handle, 2 * sizeof(uint32_t), sizeof(uint32_t), (ion_byte_t *) &count);
+		}
+	}
+
+	free(heap->frames[0].image);
+	free(heap->free_space);
+	heap->free_space = NULL;
+
+	for (i = 0; i < ION_RH_CACHE_PAGES; i++) {
+		heap->frames[i].page	= ION_RH_NULL;
+		heap->frames[i].image	= NULL;
+		heap->frames[i].dirty	= boolean_false;
+	}
+
+	return error;
+}
+
+ion_err_t
+rh_put(
+	ion_rh_t			*heap,
+	ion_byte_t			*to_write,
+	unsigned int		num_bytes,
+	ion_file_offset_t	next,
+	ion_file_offset_t	*wrote_at
+) {
+	ion_rh_frame_t		*frame;
+	ion_file_offset_t	page;
+	ion_rh_cell_t		cell;
+	ion_boolean_t		placed;
+	uint32_t			*grown;
+	uint32_t			size;
+	uint32_t			pos;
+	ion_err_t			error;
+
+	if (RH_OVERHEAD + num_bytes > heap->page_size) {
+		return err_out_of_bounds;
+	}
+
+	size	= RH_OVERHEAD + num_bytes;
+	placed	= boolean_false;
+	frame	= NULL;
+	pos		= 0;
+
+	/* beside the rest of its chain */
+	if (ION_RH_NULL != next) {
+		error = rh_place_on(heap, next / heap->page_size, &size, &frame, &pos, &placed);
+
+		if (err_ok != error) {
+			return error;
+		}
+	}
+
+	for (page = heap->reuse_page; !placed && page < heap->num_pages; page++) {
+		error = rh_place_on(heap, page, &size, &frame, &pos, &placed);
+
+		if (err_ok != error) {
+			return error;
+		}
+
+		if (placed) {
+			heap->reuse_page = page;
+		}
+	}
+
+	if (!placed) {
+		grown = realloc(heap->free_space, (heap->num_pages + 1) * sizeof(uint32_t));
+
+		if (NULL == grown) {
+			return err_out_of_memory;
+		}
+
+		heap->free_space	= grown;
+		page				= heap->num_pages++;
+		error				= rh_load(heap, page, boolean_true, &frame);
+
+		if (err_ok != error) {
+			heap->num_pages--;
+			return error;
+		}
+
+		heap->reuse_page = page;
+		rh_place(heap, frame, &size, &pos);
+	}
+
+	cell = size;
+	memcpy(frame->image + pos, &cell, sizeof(ion_rh_cell_t));
+	memcpy(frame->image + pos + sizeof(ion_rh_cell_t), &next, sizeof(ion_file_offset_t));
+	memcpy(frame->image + pos + RH_OVERHEAD, to_write, num_bytes);
+	frame->dirty	= boolean_true;
+	rh_note(heap, frame);
+
+	*wrote_at		= frame->page * heap->page_size + pos + sizeof(ion_rh_cell_t);
+	return err_ok;
+}
+
+ion_err_t
+rh_get(
+	ion_rh_t			*heap,
+	ion_file_offset_t	offset,
+	unsigned int		num_bytes,
+	ion_byte_t			*write_to,
+	ion_file_offset_t	*next
+) {
+	ion_rh_frame_t		*frame;
+	ion_file_offset_t	page;
+	ion_file_io_t		ios[2];
+	uint32_t			at;
+	ion_err_t			error;
+	int					i;
+
+	page = offset / heap->page_size;
+
+	for (i = 0; i < ION_RH_CACHE_PAGES; i++) {
+		if ((heap->frames[i].page == page) && (ION_RH_NULL != page)) {
+			break;
+		}
+	}
+
+	if (i == ION_RH_CACHE_PAGES) {
+		/* a page not held is as it is on disk, so only the record is read */
+		if ((page < 1) || (page >= heap->num_pages) || (offset - page * heap->page_size + sizeof(ion_file_offset_t) + num_bytes > heap->page_size)) {
+			return err_out_of_bounds;
+		}
+
+		ios[0].offset		= offset;
+		ios[0].num_bytes	= sizeof(ion_file_offset_t);
+		ios[0].buffer		= (ion_byte_t *) next;
+		ios[1].offset		= offset + sizeof(ion_file_offset_t);
+		ios[1].num_bytes	= num_bytes;
+		ios[1].buffer		= write_to;
+		error				= ion_freadv_at(heap->file_handle, ios, 2);
+
+		/* the chain goes on in this page, so bring it in for the rest */
+		if ((err_ok == error) && (ION_RH_NULL != *next) && (*next / heap->page_size == page)) {
+			error = rh_load(heap, page, boolean_false, &frame);
+		}
+
+		return error;
+	}
+
+	error = rh_locate(heap, offset, &frame, &at);
+
+	if (err_ok != error) {
+		return error;
+	}
+
+	if (at + sizeof(ion_file_offset_t) + num_bytes > heap->page_size) {
+		return err_out_of_bounds;
+	}
+
+	memcpy(next, frame->image + at, sizeof(ion_file_offset_t));
+	memcpy(write_to, frame->image + at + sizeof(ion_file_offset_t), num_bytes);
+
+	return err_ok;
+}
+
+ion_err_t
+rh_update_next(
+	ion_rh_t			*heap,
+	ion_file_offset_t	offset,
+	ion_file_offset_t	next
+) {
+	ion_rh_frame_t	*frame;
+	uint32_t		at;
+	ion_err_t		error;
+
+	error = rh_locate(heap, offset, &frame, &at);
+
+	if (err_ok != error) {
+		return error;
+	}
+
+	memcpy(frame->image + at, &next, sizeof(ion_file_offset_t));
+	frame->dirty = boolean_true;
+
+	return err_ok;
+}
+
+ion_err_t
+rh_delete_all(
+	ion_rh_t			*heap,
+	ion_file_offset_t	offset,
+	ion_result_count_t	*count
+) {
+	ion_rh_frame_t	*frame;
+	ion_rh_cell_t	cell;
+	uint32_t		at;
+	uint32_t		start;
+	uint32_t		size;
+	ion_err_t		error;
+
+	while (ION_RH_NULL != offset) {
+		error = rh_locate(heap, offset, &frame, &at);
+
+		if (err_ok != error) {
+			return error;
+		}
+
+		start = at - sizeof(ion_rh_cell_t);
+		memcpy(&cell, frame->image + start, sizeof(ion_rh_cell_t));
+
+		if (cell & ION_RH_CELL_FREE) {
+			return err_item_not_found;
+		}
+
+		memcpy(&offset, frame->image + at, sizeof(ion_file_offset_t));
+
+		size = RH_CELL_SIZE(cell);
+
+		if (start + size == frame->tail) {
+			rh_end_cells(heap, frame, start);
+		}
+		else {
+			cell			= size | ION_RH_CELL_FREE;
+			memcpy(frame->image + start, &cell, sizeof(ion_rh_cell_t));
+			frame->holes	+= size;
+		}
+
+		frame->dirty = boolean_true;
+		rh_note(heap, frame);
+
+		if (frame->page < heap->reuse_page) {
+			heap->reuse_page = frame->page;
+		}
+
+		if (NULL != count) {
+			(*count)++;
+		}
+	}
+
+	return err_ok;
+}
+
+ion_err_t
+rh_update_all(
+	ion_rh_t			*heap,
+	ion_file_offset_t	offset,
+	unsigned int		num_bytes,
+	ion_byte_t			*to_write,
+	ion_result_count_t	*count
+) {
+	ion_rh_frame_t	*frame;
+	uint32_t		at;
+	ion_err_t		error;
+
+	while (ION_RH_NULL != offset) {
+		error = rh_locate(heap, offset, &frame, &at);
+
+		if (err_ok != error) {
+			return error;
+		}
+
+		if (at + sizeof(ion_file_offset_t) + num_bytes > heap->page_size) {
+			return err_out_of_bounds;
+		}
+
+		memcpy(frame->image + at + sizeof(ion_file_offset_t), to_write, num_bytes);
+		memcpy(&offset, frame->image + at, sizeof(ion_file_offset_t));
+		frame->dirty = boolean_true;
+
+		if (NULL != count) {
+			(*count)++;
+		}
+	}
+
+	return err_ok;
+}
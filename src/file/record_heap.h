@@ -0,0 +1,278 @@
+/******************************************************************************/
+/**
+@file		record_heap.h
+@brief		API for a persistent heap of records kept in slotted pages.
+@details	Each record is stored as a length prefixed cell holding the
+			offset of the next record in its chain followed by the record's
+			bytes.  A new record is placed on the page of the chain it joins
+			when that page has room, so a chain is mostly read a page at a
+			time.  Space freed by deletes is found again through a map of the
+			free space on each page, which is kept after the header when the
+			heap is closed.  A page the stored map does not cover is taken
+			to have room until a put first looks at it.
+			Pages are cached in memory and written back, so nothing is on
+			disk until the page leaves the cache or @ref rh_flush is called.
+@copyright	Copyright 2017
+			The University of British Columbia,
+			IonDB Project Contributors (see AUTHORS.md)
+@par Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+@par 1.Redistributions of source code must retain the above copyright notice,
+	this list of conditions and the following disclaimer.
+
+@par 2.Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+@par 3.Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+@par THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+	AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+	IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+	ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+	LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+	CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+	SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+	INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+	CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+	ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+	POSSIBILITY OF SUCH DAMAGE.
+*/
+/******************************************************************************/
+
+#if !defined(ION_RECORD_HEAP_H_)
+#define ION_RECORD_HEAP_H_
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "../key_value/kv_system.h"
+#include "ion_file.h"
+
+#define ION_RH_NULL ION_FILE_NULL
+
+/* size of a page unless a record needs a larger one. Stored in the file, so a heap keeps the size it was created with */
+#if !defined(ION_RH_DEFAULT_PAGE_SIZE)
+#if defined(ARDUINO)
+#define ION_RH_DEFAULT_PAGE_SIZE	512
+#else
+#define ION_RH_DEFAULT_PAGE_SIZE	4096
+#endif
+#endif
+
+/* pages held in memory */
+#if !defined(ION_RH_CACHE_PAGES)
+#if defined(ARDUINO)
+#define ION_RH_CACHE_PAGES	1
+#else
+#define ION_RH_CACHE_PAGES	4
+#endif
+#endif
+
+/* first bytes of the first page of a heap file */
+#define ION_RH_MAGIC		0x48524F49UL
+
+/* length prefix of a cell, in bytes, including the prefix. A length of 0 ends the cells of a page */
+typedef uint32_t ion_rh_cell_t;
+
+/* set in the length prefix of a cell that holds no record */
+#define ION_RH_CELL_FREE	0x80000000UL
+
+/**
+@brief		A page held in memory.
+*/
+typedef struct {
+	/**> Number of the page, or @ref ION_RH_NULL if the frame is unused. */
+	ion_file_offset_t	page;
+	/**> The page, as it is or will be on disk. */
+	ion_byte_t			*image;
+	/**> Where the cells of the page end. */
+	uint32_t			tail;
+	/**> Bytes in free cells before @p tail. */
+	uint32_t			holes;
+	/**> Set while the image holds changes not yet written. */
+	ion_boolean_t		dirty;
+	/**> Tick of the last use, for replacement. */
+	unsigned long		stamp;
+} ion_rh_frame_t;
+
+/**
+@brief		A handler struct for a record heap instance.
+*/
+typedef struct recordheap {
+	/**> The file handle for the file where the records are stored. */
+	ion_file_handle_t	file_handle;
+	/**> Size of each page. Page 0 holds only the heap's header. */
+	uint32_t			page_size;
+	/**> Pages in the heap, including the header page. */
+	ion_file_offset_t	num_pages;
+	/**> Largest record cell, in bytes, that may fit on each page. */
+	uint32_t			*free_space;
+	/**> No page before this one has room for the last record placed. */
+	ion_file_offset_t	reuse_page;
+	/**> Pages held in memory. */
+	ion_rh_frame_t		frames[ION_RH_CACHE_PAGES];
+	/**> Count of page uses, for replacement. */
+	unsigned long		tick;
+} ion_rh_t;
+
+/**
+@brief		Opens a record heap in an open file, creating it if the file is
+			empty.
+@param		heap
+				A pointer to the record heap handler object to initialize.
+@param		file_handle
+				The file holding the heap.
+@param		max_record_size
+				The largest record, in bytes, that will be stored.  A new
+				heap makes its pages large enough to hold one.
+@returns	An error code describing the result of the call.
+*/
+ion_err_t
+rh_open(
+	ion_rh_t			*heap,
+	ion_file_handle_t	file_handle,
+	unsigned int		max_record_size
+);
+
+/**
+@brief		Writes every changed page of a record heap to its file.
+@param		heap
+				A pointer to the record heap handler object.
+@returns	An error code describing the result of the call.
+*/
+ion_err_t
+rh_flush(
+	ion_rh_t *heap
+);
+
+/**
+@brief		Writes back and frees the pages of a record heap, and stores its
+			free-space map.
+@details	The file is left open for the caller to close.
+@param		heap
+				A pointer to the record heap handler object.
+@returns	An error code describing the result of the call.
+*/
+ion_err_t
+rh_close(
+	ion_rh_t *heap
+);
+
+/**
+@brief		Add a record to the record heap.
+@param		heap
+				A pointer to the record heap handler object which we wish to
+				add this record to.
+@param		to_write
+				A pointer to the buffer of data to write.
+@param		num_bytes
+				The number of bytes to write from the start of @p to_write.
+@param		next
+				The offset of next record in this chain, if one exists
+				(otherwise, pass in @ref ION_RH_NULL).  The record is placed
+				on the same page if it has room.
+@param		wrote_at
+				Written with the offset of the new record.
+@returns	An error code describing the result of the call.
+*/
+ion_err_t
+rh_put(
+	ion_rh_t			*heap,
+	ion_byte_t			*to_write,
+	unsigned int		num_bytes,
+	ion_file_offset_t	next,
+	ion_file_offset_t	*wrote_at
+);
+
+/**
+@brief		Read a record from the record heap.
+@param		heap
+				A pointer to the record heap handler object.
+@param		offset
+				The offset of the record.
+@param		num_bytes
+				The number of bytes to read into @p write_to.
+@param		write_to
+				A pointer for a memory buffer to write the record into.
+@param		next
+				Written with the offset of the next record in the chain.
+@returns	An error code describing the result of the call.
+*/
+ion_err_t
+rh_get(
+	ion_rh_t			*heap,
+	ion_file_offset_t	offset,
+	unsigned int		num_bytes,
+	ion_byte_t			*write_to,
+	ion_file_offset_t	*next
+);
+
+/**
+@brief		Update the next offset for the record stored at @p offset.
+@param		heap
+				A pointer to the record heap handler object.
+@param		offset
+				The offset of the record to set the next offset of.
+@param		next
+				The offset of the record to be referenced in the record
+				stored starting at @p offset.
+@returns	An error code describing the result of the call.
+*/
+ion_err_t
+rh_update_next(
+	ion_rh_t			*heap,
+	ion_file_offset_t	offset,
+	ion_file_offset_t	next
+);
+
+/**
+@brief		Delete every record of a chain, freeing their space for reuse.
+@param		heap
+				A pointer to the record heap handler object.
+@param		offset
+				The offset of the first record of the chain.
+@param		count
+				If not @c NULL, incremented for each record deleted.
+@returns	An error code describing the result of the call.
+*/
+ion_err_t
+rh_delete_all(
+	ion_rh_t			*heap,
+	ion_file_offset_t	offset,
+	ion_result_count_t	*count
+);
+
+/**
+@brief		Overwrite every record of a chain.
+@param		heap
+				A pointer to the record heap handler object.
+@param		offset
+				The offset of the first record of the chain.
+@param		num_bytes
+				The number of bytes to write from the start of @p to_write.
+				No more than each record was stored with.
+@param		to_write
+				A pointer to the buffer of data to write.
+@param		count
+				If not @c NULL, incremented for each record written.
+@returns	An error code describing the result of the call.
+*/
+ion_err_t
+rh_update_all(
+	ion_rh_t			*heap,
+	ion_file_offset_t	offset,
+	unsigned int		num_bytes,
+	ion_byte_t			*to_write,
+	ion_result_count_t	*count
+);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* ION_RECORD_HEAP_H_ */
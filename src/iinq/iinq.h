@@ -136,7 +136,7 @@ iinq_create_source(#schema_name ".inq", key_type, key_size, value_size)
 iinq_insert(#schema_name ".inq", key, value)
 
 #define UPDATE(schema_name, key, value) \
-iinq_insert(#schema_name ".inq", key, value)
+iinq_update(#schema_name ".inq", key, value)
 
 #define DELETE_FROM(schema_name, key) \
 iinq_delete(#schema_name ".inq", key)
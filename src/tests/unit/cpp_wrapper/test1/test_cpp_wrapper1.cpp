@@ -856,6 +856,69 @@ test_static_delete_all_all(
 /*	delete dict; */
 }
 
+/**
+@brief	This function tests that integer key types pick their comparator
+		from the template argument.
+*/
+void
+test_cpp_wrapper_key_compare(
+	planck_unit_test_t *tc
+) {
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_int32 == DictionaryCompare<int32_t>::select(key_type_numeric_signed, sizeof(int32_t)));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_uint16 == DictionaryCompare<uint16_t>::select(key_type_numeric_unsigned, sizeof(uint16_t)));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_uint64 == DictionaryCompare<uint64_t>::select(key_type_numeric_signed, sizeof(uint64_t)));
+
+	/* key size that is not the template argument's, and non-integer keys */
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_signed_value == DictionaryCompare<int32_t>::select(key_type_numeric_signed, 3));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_switch_compare(key_type_char_array, 8) == DictionaryCompare<double>::select(key_type_char_array, 8));
+
+	SkipList<unsigned int, int> dict(0, key_type_numeric_unsigned, sizeof(unsigned int), sizeof(int), 7);
+
+	ion_dictionary_compare_t native = NativeCompare<sizeof(unsigned int), false>::get();
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, native == dict.dict.instance->compare);
+}
+
+/**
+@brief	This function tests that a dictionary reopened through the wrapper
+		compares keys as it did when it was created, even when the key
+		type given does not match the signedness of the template argument.
+*/
+void
+test_cpp_wrapper_key_compare_reopen(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_compare_t	native	= NativeCompare<sizeof(unsigned int), false>::get();
+	BppTree<unsigned int, int>	*dict	= new BppTree<unsigned int, int>(2, key_type_numeric_signed, sizeof(unsigned int), sizeof(int));
+	unsigned int				key;
+	int							i;
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, native == dict->dict.instance->compare);
+
+	/* half the keys would be negative if they were compared as signed */
+	for (i = 0; i < 200; i++) {
+		key = (i % 2 == 0 ? 0x80000000u : 0) + (unsigned int) i;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dict->insert(key, i).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dict->close());
+
+	ion_dictionary_config_info_t config = {
+		2, 0, key_type_numeric_signed, sizeof(unsigned int), sizeof(int), 0, dictionary_type_bpp_tree_t
+	};
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dict->open(config));
+	PLANCK_UNIT_ASSERT_TRUE(tc, native == dict->dict.instance->compare);
+
+	for (i = 0; i < 200; i++) {
+		key = (i % 2 == 0 ? 0x80000000u : 0) + (unsigned int) i;
+		PLANCK_UNIT_ASSERT_TRUE(tc, i == dict->get(key));
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dict->last_status.error);
+	}
+
+	delete dict;
+}
+
 /**
 @brief		Creates the suite to test.
 @return		Pointer to a test suite.
@@ -872,6 +935,8 @@ cpp_wrapper1_getsuite_1(
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_cpp_wrapper_delete_single_several_all);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_cpp_wrapper_delete_all_all);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_cpp_wrapper_delete_then_insert_all);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_cpp_wrapper_key_compare);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_cpp_wrapper_key_compare_reopen);
 
 	return suite;
 }
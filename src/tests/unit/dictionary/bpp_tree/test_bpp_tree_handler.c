@@ -153,12 +153,1031 @@ run_bpptreehandler_generic_test_set_1(
 	cleanup_generic_dictionary_test(&test);
 }
 
+/**
+@brief		Builds a tree directly through the b_* interface with a buffer pool
+			of @p buf_ct nodes, then checks every key is still reachable after
+			heavy splitting and joining.
+*/
+void
+bpptree_test_buffer_pool(
+	int					buf_ct,
+	planck_unit_test_t	*tc
+) {
+	ion_bpp_open_t				info;
+	ion_bpp_handle_t			tree;
+	ion_bpp_stats_t				stats;
+	ion_bpp_external_address_t	rec;
+	int							num_keys = 2000;
+	int							key;
+	int							i;
+
+	info.iName		= "bpptst.bpt";
+	info.keySize	= sizeof(int);
+	info.dupKeys	= boolean_false;
+	info.sectorSize = 256;
+	info.comp		= dictionary_compare_signed_value;
+	info.bufCt		= buf_ct;
+	info.valSize	= 0;
+
+	ion_fremove(info.iName);
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+
+	/* scatter the insertion order so splits happen all over the tree */
+	for (i = 0; i < num_keys; i++) {
+		key = (i * 7919) % num_keys;
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_insert(tree, &key, key * 10));
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(tree, &i, &rec));
+		PLANCK_UNIT_ASSERT_TRUE(tc, i * 10 == rec);
+	}
+
+	for (i = 0; i < num_keys; i += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_delete(tree, &i, &rec));
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, (i % 2 ? bErrOk : bErrKeyNotFound) == b_get(tree, &i, &rec));
+	}
+
+	i = 0;
+
+	if (bErrOk == b_find_first_key(tree, &key, &rec)) {
+		do {
+			PLANCK_UNIT_ASSERT_TRUE(tc, 2 * i + 1 == key);
+			i++;
+		} while (bErrOk == b_find_next_key(tree, &key, &rec));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_keys / 2 == i);
+
+	b_get_stats(tree, &stats);
+	PLANCK_UNIT_ASSERT_TRUE(tc, (0 == buf_ct ? ION_BPP_DEFAULT_BUFFER_COUNT : ION_BPP_MIN_BUFFER_COUNT) == stats.bufCt);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.nBufHits > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.nBufMisses > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_keys == stats.nKeysIns);
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_keys / 2 == stats.nKeysDel);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.nSplits > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.nMerges > 0);
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_close(tree));
+
+	/* everything must have been written back on close */
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+
+	for (i = 1; i < num_keys; i += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(tree, &i, &rec));
+		PLANCK_UNIT_ASSERT_TRUE(tc, i * 10 == rec);
+	}
+
+	b_close(tree);
+	ion_fremove(info.iName);
+}
+
+void
+test_bpptree_buffer_pool_minimum(
+	planck_unit_test_t *tc
+) {
+	bpptree_test_buffer_pool(1, tc);
+}
+
+void
+test_bpptree_buffer_pool_default(
+	planck_unit_test_t *tc
+) {
+	bpptree_test_buffer_pool(0, tc);
+}
+
+void
+test_bpptree_stats_per_dictionary(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			busy;
+	ion_dictionary_t			idle;
+	ion_dictionary_stats_t		stats;
+	int							i;
+
+	bpptree_init(&handler);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &busy, 2, key_type_numeric_signed, sizeof(int), sizeof(int), ION_BPP_MIN_PAGE_SIZE));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &idle, 3, key_type_numeric_signed, sizeof(int), sizeof(int), -1));
+
+	for (i = 0; i < 500; i++) {
+		dictionary_insert(&busy, &i, &i);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get_stats(&busy, &stats));
+	PLANCK_UNIT_ASSERT_TRUE(tc, 500 == stats.num_inserts);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.num_splits > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.height > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.cache_hits + stats.cache_misses > 0);
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get_stats(&idle, &stats));
+	PLANCK_UNIT_ASSERT_TRUE(tc, 0 == stats.num_inserts);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 0 == stats.num_splits);
+
+	dictionary_delete_dictionary(&busy);
+	dictionary_delete_dictionary(&idle);
+}
+
+/**
+@brief		Bulk loads @p num_keys even keys at @p fill percent through the
+			b_* interface, then checks the tree stays valid under inserts of
+			the odd keys and deletes of a third of the even keys.
+*/
+void
+bpptree_test_bulk_load(
+	int					num_keys,
+	int					fill,
+	planck_unit_test_t	*tc
+) {
+	ion_bpp_open_t				info;
+	ion_bpp_handle_t			tree;
+	ion_bpp_stats_t				stats;
+	ion_bpp_external_address_t	rec;
+	int							key;
+	int							i;
+
+	info.iName		= "bpptst.bpt";
+	info.keySize	= sizeof(int);
+	info.dupKeys	= boolean_false;
+	info.sectorSize = 256;
+	info.comp		= dictionary_compare_signed_value;
+	info.bufCt		= 0;
+	info.valSize	= 0;
+
+	ion_fremove(info.iName);
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_bulk_begin(tree, fill));
+
+	for (i = 0; i < num_keys; i++) {
+		key = 2 * i;
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_bulk_add(tree, &key, key * 10, NULL));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_bulk_end(tree));
+
+	b_get_stats(tree, &stats);
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_keys == stats.nKeysIns);
+
+	for (i = 0; i < num_keys; i++) {
+		key = 2 * i;
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(tree, &key, &rec));
+		PLANCK_UNIT_ASSERT_TRUE(tc, key * 10 == rec);
+		key++;
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrKeyNotFound == b_get(tree, &key, &rec));
+	}
+
+	i = 0;
+
+	if (bErrOk == b_find_first_key(tree, &key, &rec)) {
+		do {
+			PLANCK_UNIT_ASSERT_TRUE(tc, 2 * i == key);
+			i++;
+		} while (bErrOk == b_find_next_key(tree, &key, &rec));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_keys == i);
+
+	i = num_keys;
+
+	if (bErrOk == b_find_last_key(tree, &key, &rec)) {
+		do {
+			i--;
+			PLANCK_UNIT_ASSERT_TRUE(tc, 2 * i == key);
+		} while (bErrOk == b_find_prev_key(tree, &key, &rec));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, 0 == i);
+
+	/* the loaded tree must accept ordinary updates */
+	for (i = 0; i < num_keys; i++) {
+		key = (((i * 7919) % num_keys) * 2) + 1;
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_insert(tree, &key, key * 10));
+	}
+
+	for (i = 0; i < num_keys; i += 3) {
+		key = 2 * i;
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_delete(tree, &key, &rec));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_close(tree));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+
+	for (key = 0; key < 2 * num_keys; key++) {
+		if ((0 == key % 2) && (0 == (key / 2) % 3)) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, bErrKeyNotFound == b_get(tree, &key, &rec));
+		}
+		else {
+			PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(tree, &key, &rec));
+			PLANCK_UNIT_ASSERT_TRUE(tc, key * 10 == rec);
+		}
+	}
+
+	/* a bulk load needs an empty tree */
+	if (num_keys > 1) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrBulkLoad == b_bulk_begin(tree, fill));
+	}
+
+	b_close(tree);
+	ion_fremove(info.iName);
+}
+
+void
+test_bpptree_bulk_load_sizes(
+	planck_unit_test_t *tc
+) {
+	int sizes[]		= { 0, 1, 2, 5, 11, 12, 13, 22, 23, 24, 100, 133, 5000 };
+	int fills[]		= { 0, 50, 70 };
+	int i;
+	int j;
+
+	for (i = 0; i < (int) (sizeof(sizes) / sizeof(sizes[0])); i++) {
+		for (j = 0; j < (int) (sizeof(fills) / sizeof(fills[0])); j++) {
+			bpptree_test_bulk_load(sizes[i], fills[j], tc);
+		}
+	}
+}
+
+void
+test_bpptree_bulk_load_order(
+	planck_unit_test_t *tc
+) {
+	ion_bpp_open_t		info;
+	ion_bpp_handle_t			tree;
+	ion_bpp_external_address_t	rec;
+	int							key;
+
+	info.iName		= "bpptst.bpt";
+	info.keySize	= sizeof(int);
+	info.dupKeys	= boolean_false;
+	info.sectorSize = 256;
+	info.comp		= dictionary_compare_signed_value;
+	info.bufCt		= 0;
+	info.valSize	= 0;
+
+	ion_fremove(info.iName);
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrBulkLoad == b_bulk_add(tree, &key, 0, NULL));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_bulk_begin(tree, 0));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrBulkLoad == b_bulk_begin(tree, 0));
+
+	key = 5;
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_bulk_add(tree, &key, 0, NULL));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrBulkLoad == b_bulk_add(tree, &key, 1, NULL));
+	key = 4;
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrBulkLoad == b_bulk_add(tree, &key, 1, NULL));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_bulk_end(tree));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrBulkLoad == b_bulk_end(tree));
+
+	key = 5;
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(tree, &key, &rec));
+	PLANCK_UNIT_ASSERT_TRUE(tc, 0 == rec);
+
+	b_close(tree);
+	ion_fremove(info.iName);
+}
+
+void
+test_bpptree_bulk_load_dictionary(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			source;
+	ion_dictionary_t			target;
+	ion_predicate_t				predicate;
+	ion_dict_cursor_t			*cursor;
+	ion_dict_cursor_t			*expected;
+	ion_record_t				record;
+	ion_record_t				loaded;
+	ion_status_t				status;
+	int							num_keys = 1000;
+	int							key;
+	int							value;
+	int							key_buf[2];
+	int							value_buf[2];
+	int							i;
+
+	bpptree_init(&handler);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &source, 2, key_type_numeric_signed, sizeof(int), sizeof(int), -1));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &target, 3, key_type_numeric_signed, sizeof(int), sizeof(int), -1));
+
+	/* every tenth key has three values */
+	for (i = 0; i < num_keys; i++) {
+		key		= (i * 7919) % num_keys;
+		value	= key * 3;
+		dictionary_insert(&source, &key, &value);
+
+		if (0 == key % 10) {
+			value++;
+			dictionary_insert(&source, &key, &value);
+			value++;
+			dictionary_insert(&source, &key, &value);
+		}
+	}
+
+	dictionary_build_predicate(&predicate, predicate_all_records);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_find(&source, &predicate, &cursor));
+	status = bpptree_bulk_load(&target, cursor, 70);
+	cursor->destroy(&cursor);
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_keys + 2 * (num_keys / 10) == status.count);
+
+	/* both trees must give the same records in the same order */
+	record.key		= (ion_key_t) &key_buf[0];
+	record.value	= (ion_value_t) &value_buf[0];
+	loaded.key		= (ion_key_t) &key_buf[1];
+	loaded.value	= (ion_value_t) &value_buf[1];
+
+	dictionary_build_predicate(&predicate, predicate_all_records);
+	dictionary_find(&source, &predicate, &expected);
+	dictionary_build_predicate(&predicate, predicate_all_records);
+	dictionary_find(&target, &predicate, &cursor);
+
+	i = 0;
+
+	while (cs_cursor_active == expected->next(expected, &record)) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_active == cursor->next(cursor, &loaded));
+		PLANCK_UNIT_ASSERT_TRUE(tc, key_buf[0] == key_buf[1]);
+		PLANCK_UNIT_ASSERT_TRUE(tc, value_buf[0] == value_buf[1]);
+		i++;
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_end_of_results == cursor->next(cursor, &loaded));
+	PLANCK_UNIT_ASSERT_TRUE(tc, status.count == i);
+	expected->destroy(&expected);
+	cursor->destroy(&cursor);
+
+	/* loaded dictionary must accept ordinary updates */
+	key		= num_keys;
+	value	= 7;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&target, &key, &value).error);
+	value	= 0;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get(&target, &key, &value).error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 7 == value);
+	key		= 20;
+	PLANCK_UNIT_ASSERT_TRUE(tc, 3 == dictionary_delete(&target, &key).count);
+
+	/* a second load is refused since the tree is no longer empty */
+	dictionary_build_predicate(&predicate, predicate_all_records);
+	dictionary_find(&source, &predicate, &cursor);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_unable_to_insert == bpptree_bulk_load(&target, cursor, 0).error);
+	cursor->destroy(&cursor);
+
+	dictionary_delete_dictionary(&source);
+	dictionary_delete_dictionary(&target);
+}
+
+void
+test_bpptree_inline_values(
+	planck_unit_test_t *tc
+) {
+	ion_bpp_open_t				info;
+	ion_bpp_handle_t			tree;
+	ion_bpp_external_address_t	rec;
+	int							num_keys = 2000;
+	int							key;
+	int							value[2];
+	int							i;
+
+	info.iName		= "bpptst.bpt";
+	info.keySize	= sizeof(int);
+	info.dupKeys	= boolean_false;
+	info.sectorSize = 256;
+	info.comp		= dictionary_compare_signed_value;
+	info.bufCt		= 0;
+	info.valSize	= sizeof(value);
+
+	ion_fremove(info.iName);
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrKeyNotFound == b_get_value(tree, value));
+
+	/* values must move with their keys through every split */
+	for (i = 0; i < num_keys; i++) {
+		key			= (i * 7919) % num_keys;
+		value[0]	= key;
+		value[1]	= -key;
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_insert(tree, &key, key * 10));
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_put_value(tree, value));
+	}
+
+	for (i = 0; i < num_keys; i += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_delete(tree, &i, &rec));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_close(tree));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+
+	for (i = 1; i < num_keys; i += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(tree, &i, &rec));
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get_value(tree, value));
+		PLANCK_UNIT_ASSERT_TRUE(tc, i * 10 == rec);
+		PLANCK_UNIT_ASSERT_TRUE(tc, i == value[0] && -i == value[1]);
+	}
+
+	i = 0;
+
+	if (bErrOk == b_find_first_key(tree, &key, &rec)) {
+		do {
+			b_get_value(tree, value);
+			PLANCK_UNIT_ASSERT_TRUE(tc, key == value[0] && -key == value[1]);
+			i++;
+		} while (bErrOk == b_find_next_key(tree, &key, &rec));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_keys / 2 == i);
+	b_close(tree);
+
+	/* bulk loaded values */
+	ion_fremove(info.iName);
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_bulk_begin(tree, 0));
+
+	for (i = 0; i < num_keys; i++) {
+		value[0]	= i;
+		value[1]	= -i;
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_bulk_add(tree, &i, i * 10, value));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_bulk_end(tree));
+
+	for (i = 0; i < num_keys; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(tree, &i, &rec));
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get_value(tree, value));
+		PLANCK_UNIT_ASSERT_TRUE(tc, i == value[0] && -i == value[1]);
+	}
+
+	b_close(tree);
+	ion_fremove(info.iName);
+}
+
+void
+test_bpptree_inline_duplicates(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			small;
+	ion_dictionary_t			large;
+	ion_predicate_t				predicate;
+	ion_dict_cursor_t			*cursor;
+	ion_record_t				record;
+	int							key = 5;
+	int							found;
+	int							value;
+	int							i;
+
+	bpptree_init(&handler);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &small, 2, key_type_numeric_signed, sizeof(int), sizeof(int), -1));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &large, 3, key_type_numeric_signed, sizeof(int), ION_BPP_MAX_INLINE_VALUE_SIZE + 1, -1));
+	PLANCK_UNIT_ASSERT_TRUE(tc, ((ion_bpptree_t *) small.instance)->inline_values);
+	PLANCK_UNIT_ASSERT_TRUE(tc, !((ion_bpptree_t *) large.instance)->inline_values);
+
+	/* older values spill to the value file, newest first */
+	for (i = 1; i <= 3; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&small, &key, &i).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get(&small, &key, &value).error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 3 == value);
+
+	record.key		= (ion_key_t) &found;
+	record.value	= (ion_value_t) &value;
+	dictionary_build_predicate(&predicate, predicate_equality, &key);
+	dictionary_find(&small, &predicate, &cursor);
+
+	for (i = 3; i >= 1; i--) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_active == cursor->next(cursor, &record));
+		PLANCK_UNIT_ASSERT_TRUE(tc, i == value);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_end_of_results == cursor->next(cursor, &record));
+	cursor->destroy(&cursor);
+
+	value = 9;
+	PLANCK_UNIT_ASSERT_TRUE(tc, 3 == dictionary_update(&small, &key, &value).count);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get(&small, &key, &value).error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 9 == value);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 3 == dictionary_delete(&small, &key).count);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == dictionary_get(&small, &key, &value).error);
+
+	dictionary_delete_dictionary(&small);
+	dictionary_delete_dictionary(&large);
+}
+
+void
+test_bpptree_concurrent_cursors(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dictionary;
+	ion_predicate_t				all_predicate;
+	ion_predicate_t				range_predicate;
+	ion_dict_cursor_t			*first;
+	ion_dict_cursor_t			*second;
+	ion_dict_cursor_t			*range;
+	ion_record_t				record;
+	int							num_keys = 1000;
+	int							key;
+	int							value;
+	int							expected;
+	int							i;
+
+	bpptree_init(&handler);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &dictionary, 4, key_type_numeric_signed, sizeof(int), sizeof(int), ION_BPP_MIN_PAGE_SIZE));
+
+	for (i = 0; i < num_keys; i++) {
+		key		= i * 2;
+		value	= key * 3;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &key, &value).error);
+	}
+
+	record.key		= (ion_key_t) &key;
+	record.value	= (ion_value_t) &value;
+	dictionary_build_predicate(&all_predicate, predicate_all_records);
+	dictionary_build_predicate(&range_predicate, predicate_range, IONIZE(301, int), IONIZE(1500, int));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_find(&dictionary, &all_predicate, &first));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_find(&dictionary, &all_predicate, &second));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_find(&dictionary, &range_predicate, &range));
+
+	/* each cursor keeps its own place through the others and through gets */
+	for (i = 0; i < num_keys; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_active == first->next(first, &record));
+		PLANCK_UNIT_ASSERT_TRUE(tc, i * 2 == key && key * 3 == value);
+
+		if (0 == i % 2) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_active == second->next(second, &record));
+			PLANCK_UNIT_ASSERT_TRUE(tc, i == key && key * 3 == value);
+		}
+
+		expected = 302 + i * 2;
+
+		if (expected <= 1500) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_active == range->next(range, &record));
+			PLANCK_UNIT_ASSERT_TRUE(tc, expected == key && key * 3 == value);
+		}
+		else {
+			PLANCK_UNIT_ASSERT_TRUE(tc, cs_end_of_results == range->next(range, &record));
+		}
+
+		key = (i * 7919) % num_keys * 2;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get(&dictionary, &key, &value).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_end_of_results == first->next(first, &record));
+	first->destroy(&first);
+	range->destroy(&range);
+
+	/* keys inserted behind the cursor are skipped, those ahead of it are returned */
+	expected = num_keys;
+
+	while (cs_cursor_active == second->next(second, &record)) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, expected == key && key * 3 == value);
+
+		if ((0 == key % 2) && (key < 1500)) {
+			key		= key + 1;
+			value	= key * 3;
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &key, &value).error);
+			key		= -key;
+			value	= key * 3;
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &key, &value).error);
+		}
+
+		expected += expected < 1500 ? 1 : 2;
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, 2 * num_keys == expected);
+	second->destroy(&second);
+
+	dictionary_delete_dictionary(&dictionary);
+}
+
+/**
+@brief		Checks an all records cursor returns every key in order, the
+			second value first for keys that are a multiple of ten.
+*/
+void
+bpptree_batch_values_scan(
+	planck_unit_test_t	*tc,
+	ion_dictionary_t	*dictionary,
+	int					num_keys
+) {
+	ion_predicate_t		predicate;
+	ion_dict_cursor_t	*cursor;
+	ion_record_t		record;
+	int					key;
+	int					value[4];
+	int					i;
+
+	record.key		= (ion_key_t) &key;
+	record.value	= (ion_value_t) value;
+	dictionary_build_predicate(&predicate, predicate_all_records);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_find(dictionary, &predicate, &cursor));
+
+	for (i = 0; i < num_keys; i++) {
+		if (0 == i % 10) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_active == cursor->next(cursor, &record));
+			PLANCK_UNIT_ASSERT_TRUE(tc, i == key && i == value[0] && 2 == value[3]);
+		}
+
+		PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_active == cursor->next(cursor, &record));
+		PLANCK_UNIT_ASSERT_TRUE(tc, i == key && i == value[0] && 1 == value[3]);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_end_of_results == cursor->next(cursor, &record));
+	cursor->destroy(&cursor);
+}
+
+void
+test_bpptree_batch_values(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dictionary;
+	ion_predicate_t				predicate;
+	ion_dict_cursor_t			*cursor;
+	ion_record_t				record;
+	int							num_keys = 1500;
+	int							key;
+	int							value[4] = { 0 };
+	int							i;
+
+	bpptree_init(&handler);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &dictionary, 5, key_type_numeric_signed, sizeof(int), sizeof(value), ION_BPP_MIN_PAGE_SIZE));
+	PLANCK_UNIT_ASSERT_TRUE(tc, !((ion_bpptree_t *) dictionary.instance)->inline_values);
+
+	/* scattered through the value file, so each leaf's values are out of order */
+	for (i = 0; i < num_keys; i++) {
+		key			= (i * 7919) % num_keys;
+		value[0]	= key;
+		value[3]	= 1;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &key, value).error);
+	}
+
+	for (key = 0; key < num_keys; key += 10) {
+		value[0]	= key;
+		value[3]	= 2;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &key, value).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == bpptree_set_batch_values(&dictionary, boolean_false));
+	bpptree_batch_values_scan(tc, &dictionary, num_keys);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == bpptree_set_batch_values(&dictionary, boolean_true));
+	bpptree_batch_values_scan(tc, &dictionary, num_keys);
+
+	/* a value changed after its leaf was read is returned as changed */
+	record.key		= (ion_key_t) &key;
+	record.value	= (ion_value_t) value;
+	dictionary_build_predicate(&predicate, predicate_range, IONIZE(101, int), IONIZE(109, int));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_find(&dictionary, &predicate, &cursor));
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_active == cursor->next(cursor, &record));
+	PLANCK_UNIT_ASSERT_TRUE(tc, 101 == key && 101 == value[0]);
+
+	value[0]	= -1;
+	key			= 102;
+	PLANCK_UNIT_ASSERT_TRUE(tc, 1 == dictionary_update(&dictionary, &key, value).count);
+
+	for (i = 102; i <= 109; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_active == cursor->next(cursor, &record));
+		PLANCK_UNIT_ASSERT_TRUE(tc, i == key && (102 == i ? -1 : i) == value[0]);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_end_of_results == cursor->next(cursor, &record));
+	cursor->destroy(&cursor);
+
+	dictionary_delete_dictionary(&dictionary);
+}
+
+/**
+@brief		Counts the values of @p key, checking they share one page of the
+			value file.
+*/
+int
+bpptree_value_heap_chain(
+	planck_unit_test_t	*tc,
+	ion_bpptree_t		*bpptree,
+	int					key
+) {
+	ion_file_offset_t	offset;
+	ion_file_offset_t	page;
+	int					value[4];
+	int					count;
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(bpptree->tree, &key, &offset));
+	page = offset / bpptree->values.page_size;
+
+	for (count = 0; ION_RH_NULL != offset; count++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, page == offset / bpptree->values.page_size);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == rh_get(&bpptree->values, offset, sizeof(value), (ion_byte_t *) value, &offset));
+		PLANCK_UNIT_ASSERT_TRUE(tc, key == value[0]);
+	}
+
+	return count;
+}
+
+void
+test_bpptree_value_heap(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dictionary;
+	ion_bpptree_t				*bpptree;
+	ion_file_offset_t			num_pages;
+	int							num_keys = 1000;
+	int							key;
+	int							value[4] = { 0 };
+	int							i;
+
+	bpptree_init(&handler);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &dictionary, 6, key_type_numeric_signed, sizeof(int), sizeof(value), -1));
+	bpptree = (ion_bpptree_t *) dictionary.instance;
+	PLANCK_UNIT_ASSERT_TRUE(tc, !bpptree->inline_values);
+
+	for (key = 0; key < num_keys; key++) {
+		value[0] = key;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &key, value).error);
+	}
+
+	num_pages = bpptree->values.num_pages;
+
+	for (key = 0; key < num_keys; key += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, 1 == dictionary_delete(&dictionary, &key).count);
+	}
+
+	/* duplicates go beside the value already on the page */
+	key			= 1;
+	value[0]	= key;
+
+	for (i = 0; i < 10; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &key, value).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, 11 == bpptree_value_heap_chain(tc, bpptree, key));
+
+	/* the rest of the deleted space is used again before the file grows */
+	for (key = 0; key < num_keys - 40; key += 2) {
+		value[0] = key;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &key, value).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_pages == bpptree->values.num_pages);
+
+	/* and after a reopen, which finds the free space again */
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_close(&dictionary));
+
+	ion_dictionary_config_info_t config = {
+		6, 0, key_type_numeric_signed, sizeof(int), sizeof(value), -1
+	};
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_open(&handler, &dictionary, &config));
+	bpptree = (ion_bpptree_t *) dictionary.instance;
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_pages == bpptree->values.num_pages);
+
+	/* the free-space map was stored on close, so no page was read to open the heap */
+	for (i = 0; i < ION_RH_CACHE_PAGES; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, ION_RH_NULL == bpptree->values.frames[i].page);
+	}
+
+	for (i = 1; i < num_pages; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bpptree->values.free_space[i] < bpptree->values.page_size);
+	}
+	PLANCK_UNIT_ASSERT_TRUE(tc, 11 == bpptree_value_heap_chain(tc, bpptree, 1));
+
+	for (key = num_keys - 40; key < num_keys; key += 2) {
+		value[0] = key;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &key, value).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_pages == bpptree->values.num_pages);
+
+	for (key = 0; key < num_keys; key++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get(&dictionary, &key, value).error);
+		PLANCK_UNIT_ASSERT_TRUE(tc, key == value[0]);
+	}
+
+	dictionary_delete_dictionary(&dictionary);
+}
+
+void
+test_bpptree_page_size(
+	planck_unit_test_t *tc
+) {
+	ion_bpp_open_t				info;
+	ion_bpp_handle_t			tree;
+	ion_bpp_external_address_t	rec;
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dictionary;
+	int							num_keys = 2000;
+	int							value;
+	int							i;
+
+	info.iName		= "bpptst.bpt";
+	info.keySize	= sizeof(int);
+	info.dupKeys	= boolean_false;
+	info.sectorSize = 1024;
+	info.comp		= dictionary_compare_signed_value;
+	info.bufCt		= 0;
+	info.valSize	= 0;
+
+	ion_fremove(info.iName);
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+
+	for (i = 0; i < num_keys; i += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_insert(tree, &i, i * 10));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_close(tree));
+
+	/* the file keeps the sector size it was created with */
+	info.sectorSize = 256;
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+
+	for (i = 1; i < num_keys; i += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_insert(tree, &i, i * 10));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_close(tree));
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+
+	for (i = 0; i < num_keys; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(tree, &i, &rec));
+		PLANCK_UNIT_ASSERT_TRUE(tc, i * 10 == rec);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_close(tree));
+
+	/* a different record layout is refused */
+	info.keySize = sizeof(long long);
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrHeader == b_open(info, &tree));
+	info.keySize = sizeof(int);
+	info.valSize = sizeof(int);
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrHeader == b_open(info, &tree));
+	ion_fremove(info.iName);
+
+	/* page size through the dictionary interface survives a reopen with another size */
+	bpptree_init(&handler);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &dictionary, 2, key_type_numeric_signed, sizeof(int), sizeof(int), 512));
+
+	for (i = 0; i < num_keys; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dictionary, &i, &i).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_close(&dictionary));
+
+	ion_dictionary_config_info_t config = {
+		2, 0, key_type_numeric_signed, sizeof(int), sizeof(int), -1
+	};
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_open(&handler, &dictionary, &config));
+
+	for (i = 0; i < num_keys; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get(&dictionary, &i, &value).error);
+		PLANCK_UNIT_ASSERT_TRUE(tc, i == value);
+	}
+
+	dictionary_delete_dictionary(&dictionary);
+}
+
+/**
+@brief		Writes @p v into @p key as a native integer of @p size bytes.
+*/
+void
+bpptree_test_native_key(
+	void		*key,
+	int			size,
+	long long	v
+) {
+	uint8_t		v8	= (uint8_t) v;
+	uint16_t	v16 = (uint16_t) v;
+	uint32_t	v32 = (uint32_t) v;
+	uint64_t	v64 = (uint64_t) v;
+
+	switch (size) {
+		case 1:
+			memcpy(key, &v8, size);
+			break;
+
+		case 2:
+			memcpy(key, &v16, size);
+			break;
+
+		case 4:
+			memcpy(key, &v32, size);
+			break;
+
+		default:
+			memcpy(key, &v64, size);
+			break;
+	}
+}
+
+/**
+@brief		Checks exact and nearest-key lookups of @p size byte integer keys
+			spread over their whole range, so that sign and high bits matter.
+*/
+void
+bpptree_test_search_kernel(
+	int					size,
+	ion_boolean_t		is_signed,
+	planck_unit_test_t	*tc
+) {
+	ion_bpp_open_t				info;
+	ion_bpp_handle_t			tree;
+	ion_bpp_external_address_t	rec;
+	unsigned long long			step = 1ULL << (8 * size - 8);
+	int							num_keys = 200;
+	uint64_t					key;
+	uint64_t					found;
+	int							i;
+
+	info.iName		= "bpptst.bpt";
+	info.keySize	= size;
+	info.dupKeys	= boolean_false;
+	info.sectorSize = 256;
+	info.comp		= is_signed ? dictionary_compare_signed_value : dictionary_compare_unsigned_value;
+	info.bufCt		= 0;
+	info.valSize	= 0;
+
+	ion_fremove(info.iName);
+	PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_open(info, &tree));
+
+	/* even ranks only, so odd ranks fall between keys */
+	for (i = 0; i < num_keys; i++) {
+		int rank = (i * 7) % num_keys;
+
+		if (0 == rank % 2) {
+			bpptree_test_native_key(&key, size, is_signed ? (rank - num_keys / 2) * (long long) step : (long long) (rank * step));
+			PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_insert(tree, &key, rank));
+		}
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		bpptree_test_native_key(&key, size, is_signed ? (i - num_keys / 2) * (long long) step : (long long) (i * step));
+
+		if (0 == i % 2) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_get(tree, &key, &rec));
+			PLANCK_UNIT_ASSERT_TRUE(tc, i == rec);
+		}
+		else {
+			PLANCK_UNIT_ASSERT_TRUE(tc, bErrKeyNotFound == b_get(tree, &key, &rec));
+
+			if (i < num_keys - 1) {
+				PLANCK_UNIT_ASSERT_TRUE(tc, bErrOk == b_find_first_greater_or_equal(tree, &key, &found, &rec));
+				PLANCK_UNIT_ASSERT_TRUE(tc, i + 1 == rec);
+			}
+			else {
+				PLANCK_UNIT_ASSERT_TRUE(tc, bErrKeyNotFound == b_find_first_greater_or_equal(tree, &key, &found, &rec));
+			}
+		}
+	}
+
+	i = 0;
+
+	if (bErrOk == b_find_first_key(tree, &found, &rec)) {
+		do {
+			PLANCK_UNIT_ASSERT_TRUE(tc, i == rec);
+			i += 2;
+		} while (bErrOk == b_find_next_key(tree, &found, &rec));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_keys == i);
+
+	b_close(tree);
+	ion_fremove(info.iName);
+}
+
+void
+test_bpptree_search_kernels(
+	planck_unit_test_t *tc
+) {
+	int size;
+
+	for (size = 1; size <= 8; size *= 2) {
+		bpptree_test_search_kernel(size, boolean_true, tc);
+		bpptree_test_search_kernel(size, boolean_false, tc);
+	}
+}
+
 planck_unit_suite_t *
 bpptreehandler_get_suite(
 ) {
 	planck_unit_suite_t *suite = planck_unit_new_suite();
 
 	PLANCK_UNIT_ADD_TO_SUITE(suite, run_bpptreehandler_generic_test_set_1);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_buffer_pool_minimum);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_buffer_pool_default);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_stats_per_dictionary);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_bulk_load_sizes);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_bulk_load_order);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_bulk_load_dictionary);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_inline_values);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_inline_duplicates);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_concurrent_cursors);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_batch_values);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_value_heap);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_page_size);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_bpptree_search_kernels);
 
 	return suite;
 }
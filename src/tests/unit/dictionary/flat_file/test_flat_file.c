@@ -533,6 +533,49 @@ test_flat_file_sort_binary_search_cases(
 	ftest_takedown(tc, &flat_file);
 }
 
+/**
+@brief		Tests a sorted binary search over many more rows than fit in the buffer,
+			with runs of duplicates that cross block boundaries.
+*/
+void
+test_flat_file_sort_binary_search_blocks(
+	planck_unit_test_t *tc
+) {
+	ion_flat_file_t flat_file;
+	int				i;
+
+	ftest_create(tc, &flat_file, key_type_numeric_signed, sizeof(int), sizeof(int), 4);
+	flat_file.sorted_mode = boolean_true;
+
+	/* keys 0, 2, 4, ... 98, with 40 written five times at rows 20 to 24 */
+	for (i = 0; i < 50; i++) {
+		ftest_insert(tc, &flat_file, IONIZE(i * 2, int), IONIZE(i, int), err_ok, 1, boolean_true);
+
+		if (20 == i) {
+			ftest_insert(tc, &flat_file, IONIZE(40, int), IONIZE(-1, int), err_ok, 1, boolean_true);
+			ftest_insert(tc, &flat_file, IONIZE(40, int), IONIZE(-2, int), err_ok, 1, boolean_true);
+			ftest_insert(tc, &flat_file, IONIZE(40, int), IONIZE(-3, int), err_ok, 1, boolean_true);
+			ftest_insert(tc, &flat_file, IONIZE(40, int), IONIZE(-4, int), err_ok, 1, boolean_true);
+		}
+	}
+
+	ftest_file_binary_search(tc, &flat_file, IONIZE(0, int), err_ok, 0);
+	ftest_file_binary_search(tc, &flat_file, IONIZE(38, int), err_ok, 19);
+	ftest_file_binary_search(tc, &flat_file, IONIZE(40, int), err_ok, 20);
+	ftest_file_binary_search(tc, &flat_file, IONIZE(41, int), err_ok, 24);
+	ftest_file_binary_search(tc, &flat_file, IONIZE(42, int), err_ok, 25);
+	ftest_file_binary_search(tc, &flat_file, IONIZE(77, int), err_ok, 42);
+	ftest_file_binary_search(tc, &flat_file, IONIZE(98, int), err_ok, 53);
+	ftest_file_binary_search(tc, &flat_file, IONIZE(500, int), err_ok, 53);
+	ftest_file_binary_search(tc, &flat_file, IONIZE(-1, int), err_item_not_found, -1);
+
+	ftest_get(tc, &flat_file, IONIZE(40, int), err_ok, IONIZE(20, int));
+	ftest_get(tc, &flat_file, IONIZE(78, int), err_ok, IONIZE(39, int));
+	ftest_get(tc, &flat_file, IONIZE(79, int), err_item_not_found, IONIZE(0, int));
+
+	ftest_takedown(tc, &flat_file);
+}
+
 /**
 @brief		Tests a sorted get on an empty store.
 */
@@ -790,6 +833,7 @@ flat_file_getsuite(
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_flat_file_insert_bad_sort);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_flat_file_insert_good_sort);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_flat_file_sort_binary_search_cases);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_flat_file_sort_binary_search_blocks);
 
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_flat_file_sort_get_empty);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_flat_file_sort_get_single_nonexist);
@@ -36,11 +36,147 @@
 
 #include "test_flat_file_dictionary_handler.h"
 
+/**
+@brief		Reads a cursor to the end and checks it returns exactly the keys in
+			@p expected_keys, in order.
+*/
+void
+ffhtest_cursor_keys(
+	planck_unit_test_t	*tc,
+	ion_dictionary_t	*dict,
+	ion_predicate_t		*predicate,
+	int					*expected_keys,
+	int					num_expected
+) {
+	ion_dict_cursor_t	*cursor;
+	ion_record_t		record;
+	int					key;
+	int					value;
+	int					count = 0;
+
+	record.key		= &key;
+	record.value	= &value;
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_find(dict, predicate, &cursor));
+
+	while (cs_cursor_active == cursor->next(cursor, &record)) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, count < num_expected);
+
+		if (count < num_expected) {
+			PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, expected_keys[count], key);
+			PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, key * 10, value);
+		}
+
+		count++;
+	}
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, num_expected, count);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, cs_end_of_results, cursor->status);
+
+	cursor->destroy(&cursor);
+}
+
+/**
+@brief		Tests equality and range cursors on a sorted flat file holding many
+			more rows than it buffers.
+*/
+void
+test_flat_file_handler_sorted_cursors(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dict;
+	ion_predicate_t				predicate;
+	int							i;
+	int							equal_keys[]	= { 30, 30, 30, 30, 30, 30 };
+	int							range_keys[]	= { 28, 30, 30, 30, 30, 30, 30, 32, 34 };
+	int							tail_keys[]		= { 96, 98 };
+
+	ffdict_init(&handler);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_create(&handler, &dict, 1, key_type_numeric_signed, sizeof(int), sizeof(int), 4));
+	((ion_flat_file_t *) dict.instance)->sorted_mode = boolean_true;
+
+	/* keys 0, 2, 4, ... 98, with 30 written six times */
+	for (i = 0; i < 50; i++) {
+		int key		= i * 2;
+		int value	= key * 10;
+		int copies	= 30 == key ? 6 : 1;
+
+		while (copies-- > 0) {
+			PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_insert(&dict, &key, &value).error);
+		}
+	}
+
+	dictionary_build_predicate(&predicate, predicate_equality, IONIZE(30, int));
+	ffhtest_cursor_keys(tc, &dict, &predicate, equal_keys, 6);
+
+	dictionary_build_predicate(&predicate, predicate_equality, IONIZE(31, int));
+	ffhtest_cursor_keys(tc, &dict, &predicate, NULL, 0);
+
+	dictionary_build_predicate(&predicate, predicate_range, IONIZE(27, int), IONIZE(35, int));
+	ffhtest_cursor_keys(tc, &dict, &predicate, range_keys, 9);
+
+	dictionary_build_predicate(&predicate, predicate_range, IONIZE(95, int), IONIZE(200, int));
+	ffhtest_cursor_keys(tc, &dict, &predicate, tail_keys, 2);
+
+	dictionary_build_predicate(&predicate, predicate_range, IONIZE(-20, int), IONIZE(-1, int));
+	ffhtest_cursor_keys(tc, &dict, &predicate, NULL, 0);
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_delete_dictionary(&dict));
+}
+
+/**
+@brief		Tests the counters a flat file reports through the dictionary interface.
+*/
+void
+test_flat_file_handler_stats(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dict;
+	ion_dictionary_stats_t		stats;
+	int							i;
+	int							value;
+
+	ffdict_init(&handler);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_create(&handler, &dict, 1, key_type_numeric_signed, sizeof(int), sizeof(int), 4));
+
+	for (i = 0; i < 20; i++) {
+		value = i * 10;
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_insert(&dict, &i, &value).error);
+	}
+
+	for (i = 0; i < 20; i += 2) {
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_get(&dict, &i, &value).error);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, i * 10, value);
+	}
+
+	for (i = 0; i < 5; i++) {
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 1, dictionary_delete(&dict, &i).count);
+	}
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_get_stats(&dict, &stats));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 20, stats.num_inserts);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 5, stats.num_deletes);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 15, stats.num_lookups);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 15, stats.num_records);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.num_probes > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.num_writes >= 25);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.bytes_written > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.num_reads > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.bytes_read > 0);
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_delete_dictionary(&dict));
+}
+
 planck_unit_suite_t *
 flat_file_handler_getsuite(
 ) {
 	planck_unit_suite_t *suite = planck_unit_new_suite();
 
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_flat_file_handler_sorted_cursors);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_flat_file_handler_stats);
+
 	return suite;
 }
 
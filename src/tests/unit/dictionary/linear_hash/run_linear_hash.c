@@ -35,11 +35,12 @@
 /******************************************************************************/
 
 #include "test_linear_hash.h"
+#include "test_linear_hash_dictionary_handler.h"
 
 int
 main(
 ) {
 	runalltests_linear_hash();
-	/* runalltests_flat_file_handler(); */
+	runalltests_linear_hash_handler();
 	return 0;
 }
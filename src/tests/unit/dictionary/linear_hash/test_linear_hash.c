@@ -459,6 +459,63 @@ test_linear_hash_local_record_increments_decrements(
 	test_linear_hash_takedown(tc, linear_hash);
 }
 
+/**
+@brief		Tests the bucket cache with a one bucket budget, which evicts on nearly every access, and with the default
+			budget, which holds the whole table; then that written back buckets and state survive a close and reopen.
+*/
+void
+test_linear_hash_bucket_cache(
+	planck_unit_test_t *tc
+) {
+	linear_hash_table_t *linear_hash	= malloc(sizeof(linear_hash_table_t));
+	int					num_keys		= 300;
+	unsigned long		misses;
+	int					i;
+
+	test_linear_hash_setup(tc, linear_hash);
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_set_cache_size(LINEAR_HASH_BUCKET_SIZE(linear_hash), linear_hash));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 1, linear_hash->bucket_cache.num_frames);
+
+	for (i = 0; i < num_keys; i++) {
+		test_linear_hash_insert(tc, IONIZE(i, int), IONIZE(i * 2, int), err_ok, 1, boolean_false, linear_hash);
+	}
+
+	for (i = 0; i < num_keys; i++) {
+		test_linear_hash_get(tc, IONIZE(i, int), err_ok, 1, IONIZE(i * 2, int), linear_hash);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, linear_hash->stats.cache_misses > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, linear_hash->stats.num_writes > 0);
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_set_cache_size(LINEAR_HASH_DEFAULT_CACHE_SIZE, linear_hash));
+
+	for (i = 0; i < num_keys; i++) {
+		test_linear_hash_get(tc, IONIZE(i, int), err_ok, 1, IONIZE(i * 2, int), linear_hash);
+	}
+
+	/* every bucket is resident now, so a second pass never goes to the file */
+	misses = linear_hash->stats.cache_misses;
+
+	for (i = 0; i < num_keys; i++) {
+		test_linear_hash_get(tc, IONIZE(i, int), err_ok, 1, IONIZE(i * 2, int), linear_hash);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, misses == linear_hash->stats.cache_misses);
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_close(linear_hash));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_init(1, 4, key_type_numeric_signed, sizeof(int), sizeof(int), 2, 85, 4, linear_hash));
+	linear_hash->super.compare = dictionary_compare_signed_value;
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, num_keys, linear_hash->num_records);
+
+	for (i = 0; i < num_keys; i++) {
+		test_linear_hash_get(tc, IONIZE(i, int), err_ok, 1, IONIZE(i * 2, int), linear_hash);
+	}
+
+	test_linear_hash_takedown(tc, linear_hash);
+}
+
 /**
 @brief		Tests some basic creation and destruction stuff for the flat file.
 */
@@ -472,6 +529,156 @@ test_linear_hash_create_destroy(
 	test_linear_hash_takedown(tc, linear_hash);
 }
 
+/**
+@brief		Spreads splits over inserts, one bucket per insert, and checks that
+			every record stays reachable while a chain is half split.
+*/
+void
+test_linear_hash_incremental_split(
+	planck_unit_test_t *tc
+) {
+	linear_hash_table_t *linear_hash	= malloc(sizeof(linear_hash_table_t));
+	int					num_keys		= 300;
+	ion_boolean_t		split_seen		= boolean_false;
+	int					i;
+	int					j;
+
+	test_linear_hash_setup(tc, linear_hash);
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_set_split_work(1, linear_hash));
+
+	for (i = 0; i < num_keys; i++) {
+		test_linear_hash_insert(tc, IONIZE(i, int), IONIZE(i * 2, int), err_ok, 1, boolean_false, linear_hash);
+
+		if (linear_hash->split_in_progress) {
+			split_seen = boolean_true;
+
+			for (j = 0; j <= i; j++) {
+				test_linear_hash_get(tc, IONIZE(j, int), err_ok, 1, IONIZE(j * 2, int), linear_hash);
+			}
+		}
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, split_seen);
+
+	/* delete the even keys from the first batch while a second batch keeps splits going */
+	for (i = num_keys; i < 2 * num_keys; i++) {
+		test_linear_hash_insert(tc, IONIZE(i, int), IONIZE(i * 2, int), err_ok, 1, boolean_false, linear_hash);
+
+		if (0 == i % 2) {
+			test_linear_hash_delete(tc, IONIZE(i - num_keys, int), err_ok, 1, linear_hash);
+		}
+	}
+
+	for (i = 0; i < 2 * num_keys; i++) {
+		if ((i < num_keys) && (0 == i % 2)) {
+			test_linear_hash_get(tc, IONIZE(i, int), err_item_not_found, 0, IONIZE(0, int), linear_hash);
+		}
+		else {
+			test_linear_hash_get(tc, IONIZE(i, int), err_ok, 1, IONIZE(i * 2, int), linear_hash);
+		}
+	}
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, num_keys + num_keys / 2, linear_hash->num_records);
+
+	/* closing finishes the split in progress */
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_close(linear_hash));
+	PLANCK_UNIT_ASSERT_TRUE(tc, !linear_hash->split_in_progress);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_init(1, 4, key_type_numeric_signed, sizeof(int), sizeof(int), 2, 85, 4, linear_hash));
+	linear_hash->super.compare = dictionary_compare_signed_value;
+
+	for (i = num_keys; i < 2 * num_keys; i++) {
+		test_linear_hash_get(tc, IONIZE(i, int), err_ok, 1, IONIZE(i * 2, int), linear_hash);
+	}
+
+	test_linear_hash_takedown(tc, linear_hash);
+}
+
+/**
+@brief		Deletes from a half of a split that still starts in the chain being
+			split until that chain's first bucket is empty, then finishes the
+			split and looks for a key that is not there.
+*/
+void
+test_linear_hash_split_delete_head(
+	planck_unit_test_t *tc
+) {
+	linear_hash_table_t		*linear_hash	= malloc(sizeof(linear_hash_table_t));
+	int						num_keys		= 300;
+	/* 1 for a deleted key, 2 for the key inserted first after the deletes */
+	char					deleted[600]	= { 0 };
+	linear_hash_bucket_t	head;
+	int						halves[2];
+	int						half;
+	int						key;
+	int						i;
+
+	test_linear_hash_setup(tc, linear_hash);
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_set_split_work(1, linear_hash));
+
+	/* stop once a half still starts in a chain of more than one bucket being split */
+	half = -1;
+
+	for (key = 0; key < num_keys && half < 0; key++) {
+		test_linear_hash_insert(tc, IONIZE(key, int), IONIZE(key * 2, int), err_ok, 1, boolean_false, linear_hash);
+
+		if (!linear_hash->split_in_progress) {
+			continue;
+		}
+
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_get_bucket(linear_hash->split_remainder, &head, linear_hash));
+
+		halves[0]	= linear_hash->next_split;
+		halves[1]	= linear_hash->num_buckets - 1;
+
+		for (i = 0; i < 2 && head.overflow_location != linear_hash_end_of_list; i++) {
+			if (bucket_idx_to_ion_fpos_t(halves[i], linear_hash) == linear_hash->split_remainder) {
+				half = i;
+			}
+		}
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, half >= 0);
+
+	/* each delete takes a record from the head, whichever half its key belongs to */
+	for (i = 0; i < key && head.record_count > 0; i++) {
+		if (hash_to_bucket((ion_byte_t *) &i, linear_hash) == halves[half]) {
+			test_linear_hash_delete(tc, IONIZE(i, int), err_ok, 1, linear_hash);
+			deleted[i] = 1;
+			PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, linear_hash_get_bucket(linear_hash->split_remainder, &head, linear_hash));
+		}
+	}
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 0, head.record_count);
+	PLANCK_UNIT_ASSERT_TRUE(tc, linear_hash->split_in_progress);
+
+	/* the half gets a bucket of its own before the split moves on */
+	for (i = key; hash_to_bucket((ion_byte_t *) &i, linear_hash) != halves[half]; i++) {}
+
+	test_linear_hash_insert(tc, IONIZE(i, int), IONIZE(i * 2, int), err_ok, 1, boolean_false, linear_hash);
+	deleted[i] = 2;
+
+	for (i = key; i < 2 * num_keys; i++) {
+		if (2 != deleted[i]) {
+			test_linear_hash_insert(tc, IONIZE(i, int), IONIZE(i * 2, int), err_ok, 1, boolean_false, linear_hash);
+		}
+	}
+
+	test_linear_hash_get(tc, IONIZE(-1, int), err_item_not_found, 0, IONIZE(0, int), linear_hash);
+
+	for (i = 0; i < 2 * num_keys; i++) {
+		if (1 == deleted[i]) {
+			test_linear_hash_get(tc, IONIZE(i, int), err_item_not_found, 0, IONIZE(0, int), linear_hash);
+		}
+		else {
+			test_linear_hash_get(tc, IONIZE(i, int), err_ok, 1, IONIZE(i * 2, int), linear_hash);
+		}
+	}
+
+	test_linear_hash_takedown(tc, linear_hash);
+}
+
 planck_unit_suite_t *
 linear_hash_getsuite(
 ) {
@@ -485,6 +692,9 @@ linear_hash_getsuite(
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_linear_hash_correct_bucket_after_split);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_linear_hash_global_record_increments_decrements);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_linear_hash_local_record_increments_decrements);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_linear_hash_bucket_cache);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_linear_hash_incremental_split);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_linear_hash_split_delete_head);
 	return suite;
 }
 
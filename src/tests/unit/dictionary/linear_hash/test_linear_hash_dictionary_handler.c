@@ -33,14 +33,188 @@
 	POSSIBILITY OF SUCH DAMAGE.
 */
 /******************************************************************************/
-
 #include "test_linear_hash_dictionary_handler.h"
 
+#define LH_TEST_NUM_KEYS 200
+
+/**
+@brief		Creates a linear hash holding every key in [0, LH_TEST_NUM_KEYS), each
+			mapped to its negation, plus extra copies of key 5. Enough keys are
+			inserted to force splits and overflow buckets.
+*/
+void
+linear_hash_handler_test_setup(
+	ion_generic_test_t	*test,
+	planck_unit_test_t	*tc
+) {
+	int i;
+
+	init_generic_dictionary_test(test, linear_hash_dict_init, key_type_numeric_signed, sizeof(int), sizeof(int), 15);
+	dictionary_test_init(test, tc);
+
+	for (i = 0; i < LH_TEST_NUM_KEYS; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&test->dictionary, IONIZE(i, int), IONIZE(-i, int)).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&test->dictionary, IONIZE(5, int), IONIZE(55, int)).error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&test->dictionary, IONIZE(5, int), IONIZE(555, int)).error);
+}
+
+/**
+@brief		Counts the records a cursor returns for @p predicate, checking
+			every one satisfies it.
+*/
+int
+linear_hash_handler_test_count(
+	ion_generic_test_t	*test,
+	ion_predicate_t		*predicate,
+	planck_unit_test_t	*tc
+) {
+	ion_dict_cursor_t	*cursor = NULL;
+	ion_record_t		record;
+	int					key;
+	int					value;
+	int					count	= 0;
+
+	record.key		= &key;
+	record.value	= &value;
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_find(&test->dictionary, predicate, &cursor));
+
+	while (cs_cursor_active == cursor->next(cursor, &record)) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, test_predicate(cursor, &key));
+		PLANCK_UNIT_ASSERT_TRUE(tc, (5 == key && (55 == value || 555 == value)) || -key == value);
+		count++;
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_end_of_results == cursor->status);
+	cursor->destroy(&cursor);
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == cursor);
+
+	return count;
+}
+
+/**
+@brief		Tests that an all records cursor returns every record exactly once,
+			including those in overflow buckets, and skips deleted ones.
+*/
+void
+test_linear_hash_handler_cursor_all_records(
+	planck_unit_test_t *tc
+) {
+	ion_generic_test_t	test;
+	ion_dict_cursor_t	*cursor = NULL;
+	ion_predicate_t		predicate;
+	ion_record_t		record;
+	int					seen[LH_TEST_NUM_KEYS] = { 0 };
+	int					key;
+	int					value;
+	int					i;
+
+	linear_hash_handler_test_setup(&test, tc);
+
+	record.key		= &key;
+	record.value	= &value;
+
+	dictionary_build_predicate(&predicate, predicate_all_records);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_find(&test.dictionary, &predicate, &cursor));
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_cursor_initialized == cursor->status);
+
+	while (cs_cursor_active == cursor->next(cursor, &record)) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, key >= 0 && key < LH_TEST_NUM_KEYS);
+		seen[key]++;
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_end_of_results == cursor->status);
+	cursor->destroy(&cursor);
+
+	for (i = 0; i < LH_TEST_NUM_KEYS; i++) {
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 5 == i ? 3 : 1, seen[i]);
+	}
+
+	for (i = 0; i < LH_TEST_NUM_KEYS; i += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_delete(&test.dictionary, IONIZE(i, int)).error);
+	}
+
+	dictionary_build_predicate(&predicate, predicate_all_records);
+	/* the odd keys are left, key 5 three times */
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, LH_TEST_NUM_KEYS / 2 + 2, linear_hash_handler_test_count(&test, &predicate, tc));
+
+	/* the reopened table scans the same records, plus the one the open/close test adds */
+	dictionary_test_open_close(&test, tc);
+	dictionary_test_all_records(&test, LH_TEST_NUM_KEYS / 2 + 3, tc);
+
+	cleanup_generic_dictionary_test(&test);
+}
+
+/**
+@brief		Tests equality cursors, including duplicate keys and absent keys.
+*/
+void
+test_linear_hash_handler_cursor_equality(
+	planck_unit_test_t *tc
+) {
+	ion_generic_test_t	test;
+	ion_dict_cursor_t	*cursor = NULL;
+	ion_predicate_t		predicate;
+	int					i;
+
+	linear_hash_handler_test_setup(&test, tc);
+
+	dictionary_build_predicate(&predicate, predicate_equality, IONIZE(5, int));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 3, linear_hash_handler_test_count(&test, &predicate, tc));
+
+	for (i = 0; i < LH_TEST_NUM_KEYS; i += 17) {
+		dictionary_build_predicate(&predicate, predicate_equality, IONIZE(i, int));
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 5 == i ? 3 : 1, linear_hash_handler_test_count(&test, &predicate, tc));
+	}
+
+	dictionary_build_predicate(&predicate, predicate_equality, IONIZE(LH_TEST_NUM_KEYS, int));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_find(&test.dictionary, &predicate, &cursor));
+	PLANCK_UNIT_ASSERT_TRUE(tc, cs_end_of_results == cursor->status);
+	cursor->destroy(&cursor);
+
+	dictionary_test_equality(&test, IONIZE(42, int), tc);
+
+	cleanup_generic_dictionary_test(&test);
+}
+
+/**
+@brief		Tests range cursors over a linear hash.
+*/
+void
+test_linear_hash_handler_cursor_range(
+	planck_unit_test_t *tc
+) {
+	ion_generic_test_t	test;
+	ion_predicate_t		predicate;
+
+	linear_hash_handler_test_setup(&test, tc);
+
+	dictionary_build_predicate(&predicate, predicate_range, IONIZE(-10, int), IONIZE(9, int));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 12, linear_hash_handler_test_count(&test, &predicate, tc));
+
+	dictionary_build_predicate(&predicate, predicate_range, IONIZE(150, int), IONIZE(1000, int));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, LH_TEST_NUM_KEYS - 150, linear_hash_handler_test_count(&test, &predicate, tc));
+
+	dictionary_build_predicate(&predicate, predicate_range, IONIZE(1000, int), IONIZE(2000, int));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 0, linear_hash_handler_test_count(&test, &predicate, tc));
+
+	dictionary_test_range(&test, IONIZE(20, int), IONIZE(40, int), tc);
+	dictionary_test_all_records(&test, LH_TEST_NUM_KEYS + 2, tc);
+
+	cleanup_generic_dictionary_test(&test);
+}
+
 planck_unit_suite_t *
 linear_hash_handler_getsuite(
 ) {
 	planck_unit_suite_t *suite = planck_unit_new_suite();
 
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_linear_hash_handler_cursor_all_records);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_linear_hash_handler_cursor_equality);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_linear_hash_handler_cursor_range);
+
 	return suite;
 }
 
@@ -45,9 +45,10 @@ extern "C" {
 #include <string.h>
 #include "../../../planck-unit/src/planck_unit.h"
 #include "../../../../dictionary/linear_hash/linear_hash_handler.h"
+#include "../generic_dictionary_test.h"
 
 void
-runalltests_flat_file_handler(
+runalltests_linear_hash_handler(
 );
 
 #if defined(__cplusplus)
@@ -250,6 +250,9 @@ test_open_address_file_hashmap_find_item_location(
 			/* printf("current file pos: %i\n",(int)	ftell(map.file)); */
 		}
 
+		/* the file was written behind the map's back, so drop the blocks it holds */
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_block_cache(&map, OAFH_DEFAULT_BLOCK_SIZE, OAFH_DEFAULT_CACHE_BLOCKS));
+
 		/* and now check key positions */
 		for (i = 0; i < map.map_size; i++) {
 			int location;
@@ -1008,6 +1011,388 @@ test_open_address_file_hashmap_capacity(
 	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_destroy(&map));
 }
 
+/**
+@brief	  Tests robin hood placement under churn: deletes leave no
+			tombstones in the file, every record is still found, and robin
+			hood placement can be turned on again for a map that holds
+			records.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_file_hashmap_robin_hood(
+	planck_unit_test_t *tc
+) {
+	ion_file_hashmap_t	map;
+	ion_record_info_t	record;
+	ion_status_t		status;
+	char				value[10]	= "robin";
+	char				slot_status;
+	unsigned long		probes;
+	int					key;
+	int					round;
+	int					i;
+
+	record.key_size		= sizeof(int);
+	record.value_size	= 10;
+	map.super.key_type	= key_type_numeric_signed;
+	initialize_file_hash_map(64, &record, &map);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_robin_hood(&map, boolean_true));
+
+	/* every round's keys crowd into four home slots; the last round's are deleted */
+	for (round = 0; round < 4; round++) {
+		for (i = 0; i < 30; i++) {
+			key		= (round * 30 + i) * 64 + i % 4;
+			status	= oafh_insert(&map, &key, value);
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		}
+
+		for (i = 0; round > 0 && i < 30; i++) {
+			key		= ((round - 1) * 30 + i) * 64 + i % 4;
+			status	= oafh_delete(&map, &key);
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		}
+
+		for (i = 0; i < 30; i++) {
+			key		= (round * 30 + i) * 64 + i % 4;
+			status	= oafh_get(&map, &key, value);
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+			PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, "robin", value);
+		}
+
+		key		= 1000 * 64 + 1;
+		probes	= map.stats.num_probes;
+		status	= oafh_get(&map, &key, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == status.error);
+		PLANCK_UNIT_ASSERT_TRUE(tc, map.stats.num_probes - probes <= map.stats.max_displacement + 1);
+	}
+
+	for (i = 0; i < map.map_size; i++) {
+		fseek(map.file, i * (record.key_size + record.value_size + SIZEOF(STATUS)), SEEK_SET);
+		PLANCK_UNIT_ASSERT_TRUE(tc, 1 == fread(&slot_status, SIZEOF(STATUS), 1, map.file));
+		PLANCK_UNIT_ASSERT_TRUE(tc, ION_DELETED != slot_status);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, 120 == map.stats.num_inserts);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 90 == map.stats.num_deletes);
+
+	/* records placed by linear probing are placed again when it is switched back on */
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_robin_hood(&map, boolean_false));
+
+	for (i = 0; i < 10; i++) {
+		key		= (200 + i) * 64 + i % 4;
+		status	= oafh_insert(&map, &key, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_robin_hood(&map, boolean_true));
+	PLANCK_UNIT_ASSERT_TRUE(tc, 130 == map.stats.num_inserts);
+
+	for (i = 0; i < 10; i++) {
+		key		= (200 + i) * 64 + i % 4;
+		status	= oafh_get(&map, &key, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_destroy(&map));
+}
+
+/**
+@brief	  Tests turning robin hood placement on for a map reopened with
+			records placed by linear probing and tombstones left by deletes.
+			The records are placed again and the tombstones cleared.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_file_hashmap_robin_hood_reopen(
+	planck_unit_test_t *tc
+) {
+	ion_file_hashmap_t	*map;
+	ion_record_info_t	record;
+	ion_status_t		status;
+	char				value[10];
+	char				slot_status;
+	unsigned long		probes;
+	int					key;
+	int					i;
+
+	record.key_size		= sizeof(int);
+	record.value_size	= 10;
+
+	/* the keys crowd into four home slots and every other one is deleted */
+	map = malloc(sizeof(ion_file_hashmap_t));
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL != map);
+	map->super.key_type = key_type_numeric_signed;
+	initialize_file_hash_map(64, &record, map);
+
+	for (i = 0; i < 40; i++) {
+		key = i * 64 + i % 4;
+		snprintf(value, sizeof(value), "%i", key);
+		status = oafh_insert(map, &key, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	}
+
+	for (i = 0; i < 40; i += 2) {
+		key		= i * 64 + i % 4;
+		status	= oafh_delete(map, &key);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_close(map));
+
+	map = malloc(sizeof(ion_file_hashmap_t));
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL != map);
+	map->super.key_type = key_type_numeric_signed;
+	initialize_file_hash_map(64, &record, map);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_robin_hood(map, boolean_true));
+	PLANCK_UNIT_ASSERT_TRUE(tc, 0 == map->stats.num_inserts);
+
+	for (i = 0; i < map->map_size; i++) {
+		fseek(map->file, i * (record.key_size + record.value_size + SIZEOF(STATUS)), SEEK_SET);
+		PLANCK_UNIT_ASSERT_TRUE(tc, 1 == fread(&slot_status, SIZEOF(STATUS), 1, map->file));
+		PLANCK_UNIT_ASSERT_TRUE(tc, ION_DELETED != slot_status);
+	}
+
+	for (i = 0; i < 40; i++) {
+		key		= i * 64 + i % 4;
+		status	= oafh_get(map, &key, value);
+
+		if (i % 2 == 0) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == status.error);
+		}
+		else {
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+			PLANCK_UNIT_ASSERT_TRUE(tc, key == atoi(value));
+		}
+	}
+
+	/* a miss stops once it has passed the records displaced furthest */
+	key		= 1000 * 64 + 1;
+	probes	= map->stats.num_probes;
+	status	= oafh_get(map, &key, value);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == status.error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, map->stats.num_probes - probes <= map->stats.max_displacement + 1);
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_destroy(map));
+	free(map);
+}
+
+/**
+@brief	  Tests that an insert into a full robin hood map fails without
+			moving or losing any record already in it.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_file_hashmap_robin_hood_full(
+	planck_unit_test_t *tc
+) {
+	ion_file_hashmap_t	map;
+	ion_record_info_t	record;
+	ion_status_t		status;
+	char				value[10];
+	int					keys[]	= { 0, 4, 8, 3 };
+	int					key;
+	int					i;
+
+	record.key_size		= sizeof(int);
+	record.value_size	= 10;
+	map.super.key_type	= key_type_numeric_signed;
+	initialize_file_hash_map(4, &record, &map);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_robin_hood(&map, boolean_true));
+
+	for (i = 0; i < 4; i++) {
+		snprintf(value, sizeof(value), "%i", keys[i]);
+		status = oafh_insert(&map, &keys[i], value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	}
+
+	/* 1 would displace 3, which has nowhere left to go */
+	key		= 1;
+	status	= oafh_insert(&map, &key, value);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_max_capacity == status.error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == oafh_get(&map, &key, value).error);
+
+	for (i = 0; i < 4; i++) {
+		status = oafh_get(&map, &keys[i], value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_TRUE(tc, keys[i] == atoi(value));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, 4 == map.stats.num_inserts);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_destroy(&map));
+}
+
+/**
+@brief	  Tests probing through a cache of small blocks: probe sequences that
+			cross blocks, the short last block and the wrap to the first, and
+			that every write reached the file.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_file_hashmap_block_cache(
+	planck_unit_test_t *tc
+) {
+	ion_file_hashmap_t	map;
+	ion_record_info_t	record;
+	ion_status_t		status;
+	char				value[10];
+	char				expected[10];
+	int					record_size;
+	int					round;
+	int					key;
+	int					i;
+
+	record.key_size		= sizeof(int);
+	record.value_size	= 10;
+	record_size			= SIZEOF(STATUS) + record.key_size + record.value_size;
+	map.super.key_type	= key_type_numeric_signed;
+
+	for (round = 0; round < 2; round++) {
+		initialize_file_hash_map(20, &record, &map);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_out_of_bounds == oafh_set_block_cache(&map, 0, 1));
+		/* three slots a block, so the last block holds two */
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_block_cache(&map, 3 * record_size + record_size / 2, 2));
+		PLANCK_UNIT_ASSERT_TRUE(tc, 3 == map.block_slots);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_robin_hood(&map, 1 == round));
+
+		/* every key's home slot is 18, so the run wraps past the end of the file */
+		for (i = 0; i < 10; i++) {
+			key = i * 20 + 18;
+			sprintf(value, "v%d", i);
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_insert(&map, &key, value).error);
+		}
+
+		for (i = 1; i < 10; i += 2) {
+			key = i * 20 + 18;
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_delete(&map, &key).error);
+		}
+
+		key = 4 * 20 + 18;
+		sprintf(value, "updated");
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_update(&map, &key, value).error);
+
+		/* and again with nothing held in memory, from the file alone */
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_block_cache(&map, 3 * record_size, 1));
+
+		for (i = 0; i < 10; i++) {
+			key		= i * 20 + 18;
+			status	= oafh_get(&map, &key, value);
+
+			if (1 == i % 2) {
+				PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == status.error);
+				continue;
+			}
+
+			if (4 == i) {
+				strcpy(expected, "updated");
+			}
+			else {
+				sprintf(expected, "v%d", i);
+			}
+
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+			PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, expected, value);
+		}
+
+		PLANCK_UNIT_ASSERT_TRUE(tc, map.stats.cache_hits > 0);
+		PLANCK_UNIT_ASSERT_TRUE(tc, map.stats.cache_misses == map.stats.num_reads);
+		PLANCK_UNIT_ASSERT_TRUE(tc, map.stats.num_reads < map.stats.num_probes);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_destroy(&map));
+	}
+}
+
+/**
+@brief	  Tests a map with its file mapped into memory: lookups and changes
+			go to no file calls, and what was changed in place is in the file.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_file_hashmap_mmap(
+	planck_unit_test_t *tc
+) {
+	ion_file_hashmap_t	map;
+	ion_status_t		status;
+	ion_err_t			err;
+	char				value[10];
+	char				expected[10];
+	char				updated[10] = "updated";
+	unsigned long		num_reads;
+	unsigned long		num_writes;
+	int					record_size;
+	int					loc;
+	int					key;
+	int					i;
+
+	initialize_file_hash_map_std_conditions(&map);
+	record_size = SIZEOF(STATUS) + map.super.record.key_size + map.super.record.value_size;
+	err			= oafh_set_mmap(&map, boolean_true);
+
+	if (!OAFH_HAS_MMAP) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_not_implemented == err);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_destroy(&map));
+		return;
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == err);
+	num_reads	= map.stats.num_reads;
+	num_writes	= map.stats.num_writes;
+
+	for (i = 0; i < ION_STD_MAP_SIZE; i++) {
+		key = i;
+		sprintf(value, "v%d", i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_insert(&map, &key, value).error);
+	}
+
+	key = 3;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_delete(&map, &key).error);
+	key = 4;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_update(&map, &key, updated).error);
+
+	for (i = 0; i < ION_STD_MAP_SIZE; i++) {
+		key		= i;
+		status	= oafh_get(&map, &key, value);
+
+		if (3 == i) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == status.error);
+			continue;
+		}
+
+		sprintf(expected, "v%d", i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, 4 == i ? updated : expected, value);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_reads == map.stats.num_reads);
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_writes == map.stats.num_writes);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_flush(&map));
+
+	/* the update made in place is in the file */
+	key = 4;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_find_item_loc(&map, &key, &loc));
+	fseek(map.file, loc * record_size + SIZEOF(STATUS) + map.super.record.key_size, SEEK_SET);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 1 == fread(value, map.super.record.value_size, 1, map.file));
+	PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, updated, value);
+
+	/* and is read back a block at a time once the map is unmapped */
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_set_mmap(&map, boolean_false));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_get(&map, &key, value).error);
+	PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, updated, value);
+	key = 3;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == oafh_get(&map, &key, value).error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_reads < map.stats.num_reads);
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oafh_destroy(&map));
+}
+
 planck_unit_suite_t *
 open_address_file_hashmap_getsuite(
 ) {
@@ -1027,6 +1412,11 @@ open_address_file_hashmap_getsuite(
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_file_hashmap_delete_1);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_file_hashmap_delete_2);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_file_hashmap_capacity);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_file_hashmap_robin_hood);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_file_hashmap_robin_hood_reopen);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_file_hashmap_robin_hood_full);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_file_hashmap_block_cache);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_file_hashmap_mmap);
 
 	return suite;
 }
@@ -1001,6 +1001,417 @@ test_open_address_hashmap_capacity(
 	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_destroy(&map));
 }
 
+/**
+@brief	  Tests that a map with a grow load doubles instead of filling up,
+			and shrinks back once most records are deleted.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_hashmap_resize(
+	planck_unit_test_t *tc
+) {
+	ion_hashmap_t	map;
+	ion_status_t	status;
+	char			value[10];
+	int				i;
+
+	initialize_hash_map_std_conditions(&map);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_out_of_bounds == oah_set_resize(&map, 75, 40, 0));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_set_resize(&map, 75, 20, 0));
+
+	for (i = 0; i < ION_MAX_HASH_TEST; i++) {
+		snprintf(value, sizeof(value), "%02u is key", (unsigned) i % 100u);
+		status = oah_insert(&map, &i, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_TRUE(tc, map.num_records * 100 <= 75 * map.map_size);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, ION_MAX_HASH_TEST == map.num_records);
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == map.old_entry);
+
+	for (i = 0; i < ION_MAX_HASH_TEST; i++) {
+		status = oah_get(&map, &i, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_TRUE(tc, i % 100 == atoi(value));
+	}
+
+	for (i = 0; i < ION_MAX_HASH_TEST - 5; i++) {
+		status = oah_delete(&map, &i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, 5 == map.num_records);
+	PLANCK_UNIT_ASSERT_TRUE(tc, ION_STD_MAP_SIZE <= map.map_size);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 40 >= map.map_size);
+
+	for (i = ION_MAX_HASH_TEST - 5; i < ION_MAX_HASH_TEST; i++) {
+		status = oah_get(&map, &i, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_TRUE(tc, i % 100 == atoi(value));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_destroy(&map));
+}
+
+/**
+@brief	  Tests that a map rehashed a slot per operation finds, updates and
+			deletes records while they are split between two arrays.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_hashmap_incremental_resize(
+	planck_unit_test_t *tc
+) {
+	ion_hashmap_t	map;
+	ion_status_t	status;
+	char			value[10];
+	char			updated[10]	= "updated";
+	int				migrating	= 0;
+	int				i;
+	int				j;
+
+	initialize_hash_map_std_conditions(&map);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_set_resize(&map, 75, 0, 1));
+
+	for (i = 0; i < ION_MAX_HASH_TEST; i++) {
+		snprintf(value, sizeof(value), "%02u is key", (unsigned) i % 100u);
+		status = oah_insert(&map, &i, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+
+		if (NULL == map.old_entry) {
+			continue;
+		}
+
+		migrating = 1;
+
+		/* every record so far is found in one array or the other */
+		for (j = 0; j <= i; j++) {
+			status = oah_get(&map, &j, value);
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+			PLANCK_UNIT_ASSERT_TRUE(tc, j % 100 == atoi(value));
+		}
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, migrating);
+
+	/* start a rehash, then change records on both sides of it */
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_resize(&map, map.map_size * 2));
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL != map.old_entry);
+
+	for (i = 0; i < ION_MAX_HASH_TEST; i += 2) {
+		status = oah_delete(&map, &i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	}
+
+	for (i = 1; i < ION_MAX_HASH_TEST; i += 2) {
+		status = oah_update(&map, &i, updated);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, ION_MAX_HASH_TEST / 2 == map.num_records);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_migrate(&map, map.old_map_size));
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == map.old_entry);
+
+	for (i = 0; i < ION_MAX_HASH_TEST; i++) {
+		status = oah_get(&map, &i, value);
+
+		if (0 == i % 2) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == status.error);
+		}
+		else {
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+			PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, updated, value);
+		}
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_destroy(&map));
+}
+
+/**
+@brief	  Tests robin hood placement under churn: no tombstones are left,
+			records stay in displacement order, and a miss stops within the
+			largest displacement.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_hashmap_robin_hood(
+	planck_unit_test_t *tc
+) {
+	ion_hashmap_t		map;
+	ion_record_info_t	record;
+	ion_status_t		status;
+	ion_hash_bucket_t	*item;
+	char				value[10]	= "robin";
+	unsigned long		probes;
+	int					previous;
+	int					distance;
+	int					key;
+	int					round;
+	int					i;
+
+	record.key_size		= sizeof(int);
+	record.value_size	= 10;
+	map.super.key_type	= key_type_numeric_signed;
+	initialize_hash_map(64, &record, &map);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_set_robin_hood(&map, boolean_true));
+
+	/* every round's keys crowd into four home slots; the last round's are deleted */
+	for (round = 0; round < 5; round++) {
+		for (i = 0; i < 30; i++) {
+			key		= (round * 30 + i) * 64 + i % 4;
+			status	= oah_insert(&map, &key, value);
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		}
+
+		for (i = 0; round > 0 && i < 30; i++) {
+			key		= ((round - 1) * 30 + i) * 64 + i % 4;
+			status	= oah_delete(&map, &key);
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		}
+
+		PLANCK_UNIT_ASSERT_TRUE(tc, 0 == map.num_deleted);
+
+		for (i = 0; i < 30; i++) {
+			key		= (round * 30 + i) * 64 + i % 4;
+			status	= oah_get(&map, &key, value);
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		}
+
+		/* each record is at most one slot further from home than the one before it */
+		previous = 0;
+
+		for (i = 0; i < map.map_size; i++) {
+			item = (ion_hash_bucket_t *) (map.entry + (record.key_size + record.value_size + SIZEOF(STATUS)) * i);
+
+			if (ION_IN_USE != item->status) {
+				PLANCK_UNIT_ASSERT_TRUE(tc, ION_EMPTY == item->status);
+				previous = -1;
+				continue;
+			}
+
+			memcpy(&key, item->data, sizeof(key));
+			distance = (i - key % 64 + 64) % 64;
+			PLANCK_UNIT_ASSERT_TRUE(tc, distance <= previous + 1);
+			previous = distance;
+		}
+
+		key		= 1000 * 64 + 1;
+		probes	= map.stats.num_probes;
+		status	= oah_get(&map, &key, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == status.error);
+		PLANCK_UNIT_ASSERT_TRUE(tc, map.stats.num_probes - probes <= map.stats.max_displacement + 1);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, 150 == map.stats.num_inserts);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 120 == map.stats.num_deletes);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_destroy(&map));
+
+	/* turning robin hood on places the records of a linear probing map again */
+	initialize_hash_map_std_conditions(&map);
+
+	for (i = 0; i < ION_STD_MAP_SIZE; i++) {
+		key = i * ION_STD_MAP_SIZE;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_insert(&map, &key, value).error);
+	}
+
+	for (i = 0; i < ION_STD_MAP_SIZE; i += 2) {
+		key = i * ION_STD_MAP_SIZE;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_delete(&map, &key).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, ION_STD_MAP_SIZE / 2 == map.num_deleted);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_set_robin_hood(&map, boolean_true));
+	PLANCK_UNIT_ASSERT_TRUE(tc, 0 == map.num_deleted);
+
+	for (i = 0; i < ION_STD_MAP_SIZE; i++) {
+		key		= i * ION_STD_MAP_SIZE;
+		status	= oah_get(&map, &key, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, (0 == i % 2 ? err_item_not_found : err_ok) == status.error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_destroy(&map));
+}
+
+/**
+@brief	  Tests the grouped layout: records carried over from the row layout,
+			growth, updates, deletes and misses, and the way back.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_hashmap_groups(
+	planck_unit_test_t *tc
+) {
+	ion_hashmap_t	map;
+	ion_status_t	status;
+	char			value[10];
+	char			expected[10];
+	char			updated[10] = "updated";
+	int				in_use;
+	int				key;
+	int				i;
+
+	initialize_hash_map_std_conditions(&map);
+
+	for (i = 0; i < 5; i++) {
+		key = i * ION_STD_MAP_SIZE;
+		sprintf(value, "v%d", i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_insert(&map, &key, value).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_set_layout(&map, oah_layout_groups));
+	PLANCK_UNIT_ASSERT_TRUE(tc, OAH_GROUP_WIDTH == map.map_size);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_not_implemented == oah_set_robin_hood(&map, boolean_true));
+
+	for (i = 0; i < 5; i++) {
+		key		= i * ION_STD_MAP_SIZE;
+		status	= oah_get(&map, &key, value);
+		sprintf(expected, "v%d", i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, expected, value);
+	}
+
+	/* strided keys that would all share a home slot by the simple hash */
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_set_resize(&map, 75, 0, 0));
+
+	for (i = 5; i < 200; i++) {
+		key = i * 1024;
+		sprintf(value, "v%d", i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_insert(&map, &key, value).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, 0 == map.map_size % OAH_GROUP_WIDTH);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 200 * 100 <= 75 * map.map_size);
+
+	key = 8 * 1024;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_duplicate_key == oah_insert(&map, &key, value).error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_update(&map, &key, updated).error);
+
+	for (i = 5; i < 200; i += 2) {
+		key = i * 1024;
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_delete(&map, &key).error);
+	}
+
+	for (i = 5; i < 200; i++) {
+		key		= i * 1024;
+		status	= oah_get(&map, &key, value);
+
+		if (1 == i % 2) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == status.error);
+			continue;
+		}
+
+		sprintf(expected, "v%d", i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, 8 == i ? updated : expected, value);
+	}
+
+	in_use = 0;
+
+	for (i = 0; i < map.map_size; i++) {
+		if (NULL != oah_slot_key(&map, i)) {
+			in_use++;
+		}
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, map.num_records == in_use);
+	PLANCK_UNIT_ASSERT_TRUE(tc, 5 + 97 == in_use);
+
+	/* and back to rows */
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_set_layout(&map, oah_layout_rows));
+	key = 8 * 1024;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_get(&map, &key, value).error);
+	PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, updated, value);
+	key = 3 * ION_STD_MAP_SIZE;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_get(&map, &key, value).error);
+	PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, "v3", value);
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_destroy(&map));
+}
+
+/**
+@brief	  Tests writing a map part way through a rehash to a snapshot, and
+			rebuilding it in a smaller map.
+
+@param	  tc
+				Test case.
+*/
+void
+test_open_address_hashmap_snapshot(
+	planck_unit_test_t *tc
+) {
+	ion_hashmap_t		map;
+	ion_hashmap_t		loaded;
+	ion_record_info_t	record		= { sizeof(int), 4 };
+	ion_status_t		status;
+	FILE				*file;
+	char				value[16];
+	int					i;
+
+	initialize_hash_map_std_conditions(&map);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_set_resize(&map, 75, 0, 1));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_set_robin_hood(&map, boolean_true));
+
+	for (i = 0; i < ION_MAX_HASH_TEST; i++) {
+		sprintf(value, "%02i is key", i % 100);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_insert(&map, &i, value).error);
+	}
+
+	/* leave records in both arrays */
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_resize(&map, map.map_size * 2));
+
+	for (i = 0; i < ION_MAX_HASH_TEST; i += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_delete(&map, &i).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL != map.old_entry);
+
+	file = fopen("snapshot.oas", "w+b");
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL != file);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_save(&map, file));
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL != map.old_entry);
+
+	rewind(file);
+	initialize_hash_map_std_conditions(&loaded);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_load(&loaded, file));
+	PLANCK_UNIT_ASSERT_TRUE(tc, loaded.robin_hood);
+	PLANCK_UNIT_ASSERT_TRUE(tc, loaded.map_size == map.map_size);
+	PLANCK_UNIT_ASSERT_TRUE(tc, ION_MAX_HASH_TEST / 2 == loaded.num_records);
+
+	for (i = 0; i < ION_MAX_HASH_TEST; i++) {
+		status = oah_get(&loaded, &i, value);
+
+		if (0 == i % 2) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == status.error);
+			continue;
+		}
+
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_TRUE(tc, i % 100 == atoi(value));
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_destroy(&loaded));
+
+	/* records of another size are refused */
+	rewind(file);
+	loaded.super.key_type = key_type_numeric_signed;
+	initialize_hash_map(ION_STD_MAP_SIZE, &record, &loaded);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_file_read_error == oah_load(&loaded, file));
+	PLANCK_UNIT_ASSERT_TRUE(tc, 0 == loaded.num_records);
+
+	fclose(file);
+	fremove("snapshot.oas");
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_destroy(&loaded));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == oah_destroy(&map));
+}
+
 planck_unit_suite_t *
 open_address_hashmap_getsuite(
 ) {
@@ -1020,6 +1431,11 @@ open_address_hashmap_getsuite(
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_hashmap_delete_1);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_hashmap_delete_2);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_hashmap_capacity);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_hashmap_resize);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_hashmap_incremental_resize);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_hashmap_robin_hood);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_hashmap_groups);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_hashmap_snapshot);
 
 	return suite;
 }
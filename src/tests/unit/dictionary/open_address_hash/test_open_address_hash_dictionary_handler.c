@@ -39,6 +39,7 @@ extern "C" {
 #endif
 
 #include "test_open_address_hash_dictionary_handler.h"
+#include "../../../../dictionary/flat_file/flat_file_dictionary_handler.h"
 
 #define ION_MAX_HASH_TEST 100
 
@@ -538,6 +539,41 @@ test_open_address_dictionary_cursor_range(
 	dictionary_delete_dictionary(&test_dictionary);
 }
 
+/**
+@brief		Tests that destroying a dictionary with no snapshot removes the flat
+			file copy left by an earlier close.
+@param		tc
+				Test case.
+*/
+void
+test_open_address_dictionary_destroy_flat_file_copy(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	ff_handler;
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dict;
+	char						filename[ION_MAX_FILENAME_LENGTH];
+	FILE						*file;
+	int							key		= 1;
+	int							value	= 10;
+
+	ffdict_init(&ff_handler);
+	oadict_init(&handler);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_create(&ff_handler, &dict, 41, key_type_numeric_signed, sizeof(int), sizeof(int), 4));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_insert(&dict, &key, &value).error);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_close(&dict));
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_destroy_dictionary(&handler, 41));
+
+	dictionary_get_filename(41, "ffs", filename);
+	file = fopen(filename, "rb");
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == file);
+
+	if (NULL != file) {
+		fclose(file);
+	}
+}
+
 planck_unit_suite_t *
 open_address_hashmap_handler_getsuite(
 ) {
@@ -552,6 +588,7 @@ open_address_hashmap_handler_getsuite(
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_dictionary_handler_query_with_results);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_dictionary_handler_query_no_results);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_dictionary_cursor_range);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_open_address_dictionary_destroy_flat_file_copy);
 
 	return suite;
 }
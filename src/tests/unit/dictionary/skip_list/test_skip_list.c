@@ -1954,6 +1954,254 @@ test_skiplist_big_keys(
 @brief	  Creates the suite to test using PlanckUnit test cases.
 @return	 Pointer to a PlanckUnit test suite.
 */
+/**
+@brief	  Tests nodes carved from slabs: each node is one block, the records
+			read back, and deleted nodes are reused before a new slab is cut.
+
+@param	  tc
+				Test case.
+*/
+void
+test_skiplist_slabs(
+	planck_unit_test_t *tc
+) {
+	PRINT_HEADER();
+
+	ion_skiplist_t	skiplist;
+	ion_sl_node_t	*cursor;
+	ion_sl_slab_t	*slab;
+	ion_status_t	status;
+	char			value[16];
+	char			expected[16];
+	int				num_slabs;
+	int				key;
+	int				i;
+
+	initialize_skiplist_std_conditions(&skiplist);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_out_of_bounds == sl_set_slab_size(&skiplist, -1));
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_set_slab_size(&skiplist, 256));
+
+	/* every key twice, so half the nodes are duplicates */
+	for (i = 0; i < 200; i++) {
+		key = i / 2;
+		sprintf(value, "v%d", i / 2);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_insert(&skiplist, &key, value).error);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_not_implemented == sl_set_slab_size(&skiplist, 0));
+
+	for (i = 0; i < 100; i++) {
+		status = sl_get(&skiplist, &i, value);
+		sprintf(expected, "v%d", i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, expected, value);
+	}
+
+	for (cursor = skiplist.head->next[0]; NULL != cursor; cursor = cursor->next[0]) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, (ion_byte_t *) cursor->next == (ion_byte_t *) (cursor + 1));
+		PLANCK_UNIT_ASSERT_TRUE(tc, (ion_byte_t *) cursor->key == (ion_byte_t *) (cursor->next + cursor->height + 1));
+		PLANCK_UNIT_ASSERT_TRUE(tc, NULL == cursor->next[0] || *(int *) cursor->key <= *(int *) cursor->next[0]->key);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL != skiplist.slabs && NULL != skiplist.slabs->next);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_destroy(&skiplist));
+
+	/* with p = 0 every node is one level high, so a deleted node always fits the next */
+	initialize_skiplist(&skiplist, key_type_numeric_signed, dictionary_compare_signed_value, 7, sizeof(int), 10, 0, 4);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_set_slab_size(&skiplist, 512));
+	memset(value, 0, sizeof(value));
+	strcpy(value, "fresh");
+
+	for (i = 0; i < 50; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_insert(&skiplist, &i, value).error);
+	}
+
+	num_slabs = 0;
+
+	for (slab = skiplist.slabs; NULL != slab; slab = slab->next) {
+		num_slabs++;
+	}
+
+	for (i = 0; i < 50; i += 2) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_delete(&skiplist, &i).error);
+	}
+
+	strcpy(value, "reused");
+
+	for (i = 100; i < 125; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_insert(&skiplist, &i, value).error);
+	}
+
+	for (slab = skiplist.slabs; NULL != slab; slab = slab->next) {
+		num_slabs--;
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, 0 == num_slabs);
+	key = 110;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_get(&skiplist, &key, value).error);
+	PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, "reused", value);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_destroy(&skiplist));
+}
+
+/**
+@brief	  Tests a sorted batch insert followed by searches that start from
+			the finger, or start over when the key is behind it, and checks
+			every level stays ordered.
+
+@param	  tc
+				Test case.
+*/
+void
+test_skiplist_insert_batch(
+	planck_unit_test_t *tc
+) {
+	PRINT_HEADER();
+
+	ion_skiplist_t	skiplist;
+	ion_sl_node_t	*cursor;
+	ion_status_t	status;
+	ion_sl_level_t	h;
+	int				keys[300];
+	char			values[300][10];
+	char			value[16];
+	char			expected[16];
+	int				num_nodes;
+	int				i;
+
+	initialize_skiplist_std_conditions(&skiplist);
+	memset(values, 0, sizeof(values));
+
+	/* every even key twice */
+	for (i = 0; i < 300; i++) {
+		keys[i] = i / 2 * 2;
+		sprintf(values[i], "b%d", i);
+	}
+
+	status = sl_insert_batch(&skiplist, keys, values, 300);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 300, status.count);
+
+	/* each key is behind the one before, so every search starts over */
+	memset(value, 0, sizeof(value));
+
+	for (i = 299; i > 0; i -= 2) {
+		sprintf(value, "o%d", i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_insert(&skiplist, &i, value).error);
+	}
+
+	for (i = 0; i < 300; i++) {
+		sprintf(expected, i % 2 ? "o%d" : "b%d", i);
+		status = sl_get(&skiplist, &i, value);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, expected, value);
+	}
+
+	/* duplicates keep their batch order */
+	i		= 10;
+	cursor	= sl_find_node(&skiplist, &i);
+	PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, "b10", (char *) cursor->value);
+	PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, "b11", (char *) cursor->next[0]->value);
+
+	for (i = 0; i < 300; i += 3) {
+		status = sl_delete(&skiplist, &i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, i % 2 ? 1 : 2, status.count);
+	}
+
+	i = 3;
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == sl_delete(&skiplist, &i).error);
+
+	for (h = 0; h <= skiplist.head->height; h++) {
+		num_nodes = 0;
+
+		for (cursor = skiplist.head->next[h]; NULL != cursor; cursor = cursor->next[h]) {
+			PLANCK_UNIT_ASSERT_TRUE(tc, cursor->height >= h);
+			PLANCK_UNIT_ASSERT_TRUE(tc, NULL == cursor->next[h] || *(int *) cursor->key <= *(int *) cursor->next[h]->key);
+			num_nodes++;
+		}
+
+		if (0 == h) {
+			PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 300, num_nodes);
+		}
+	}
+
+	/* a batch out of order keeps the records before the violation */
+	keys[0] = 1000;
+	keys[1] = 999;
+	status	= sl_insert_batch(&skiplist, keys, values, 2);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_sorted_order_violation == status.error);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 1, status.count);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_get(&skiplist, &keys[0], value).error);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_item_not_found == sl_get(&skiplist, &keys[1], value).error);
+
+	sl_destroy(&skiplist);
+}
+
+/**
+@brief	  Tests writing a skiplist with duplicates to a snapshot and
+			rebuilding it in key order.
+
+@param	  tc
+				Test case.
+*/
+void
+test_skiplist_snapshot(
+	planck_unit_test_t *tc
+) {
+	PRINT_HEADER();
+
+	ion_skiplist_t	skiplist;
+	ion_skiplist_t	loaded;
+	ion_sl_node_t	*cursor;
+	ion_sl_node_t	*expected;
+	FILE			*file;
+	char			value[10];
+	int				key;
+	int				i;
+
+	initialize_skiplist_std_conditions(&skiplist);
+	memset(value, 0, sizeof(value));
+
+	/* descending, with every key three times */
+	for (i = 0; i < 150; i++) {
+		key = 50 - i / 3;
+		sprintf(value, "s%d", i);
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_insert(&skiplist, &key, value).error);
+	}
+
+	file = fopen("snapshot.sls", "w+b");
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL != file);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_save(&skiplist, file));
+
+	rewind(file);
+	initialize_skiplist_std_conditions(&loaded);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == sl_load(&loaded, file));
+
+	/* the same records in the same order, equal keys included */
+	expected = skiplist.head->next[0];
+
+	for (cursor = loaded.head->next[0]; NULL != cursor; cursor = cursor->next[0]) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, NULL != expected);
+		PLANCK_UNIT_ASSERT_TRUE(tc, *(int *) expected->key == *(int *) cursor->key);
+		PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, (char *) expected->value, (char *) cursor->value);
+		expected = expected->next[0];
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == expected);
+	sl_destroy(&loaded);
+
+	/* records of another size are refused */
+	rewind(file);
+	initialize_skiplist(&loaded, key_type_numeric_signed, dictionary_compare_signed_value, 7, sizeof(int), 4, 1, 4);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_file_read_error == sl_load(&loaded, file));
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == loaded.head->next[0]);
+
+	fclose(file);
+	fremove("snapshot.sls");
+	sl_destroy(&loaded);
+	sl_destroy(&skiplist);
+}
+
 planck_unit_suite_t *
 skiplist_getsuite_1(
 ) {
@@ -2054,6 +2302,9 @@ skiplist_getsuite_3(
 	/* Variation Tests */
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_skiplist_different_size);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_skiplist_big_keys);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_skiplist_slabs);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_skiplist_insert_batch);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_skiplist_snapshot);
 
 	return suite;
 }
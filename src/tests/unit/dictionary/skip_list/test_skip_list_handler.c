@@ -35,6 +35,7 @@
 /******************************************************************************/
 
 #include "test_skip_list_handler.h"
+#include "../../../../dictionary/flat_file/flat_file_dictionary_handler.h"
 
 /**
 @brief	  Helper function that constructs a sample dictionary based on the
@@ -157,7 +158,7 @@ test_dictionary_creation(
 	ion_skiplist_t *skiplist = (ion_skiplist_t *) dict.instance;
 
 	PLANCK_UNIT_ASSERT_TRUE(tc, dict.instance->key_type == key_type_numeric_signed);
-	PLANCK_UNIT_ASSERT_TRUE(tc, dict.instance->compare == dictionary_compare_signed_value);
+	PLANCK_UNIT_ASSERT_TRUE(tc, dict.instance->compare == dictionary_switch_compare(key_type_numeric_signed, sizeof(int)));
 	PLANCK_UNIT_ASSERT_TRUE(tc, dict.instance->record.key_size == sizeof(int));
 	PLANCK_UNIT_ASSERT_TRUE(tc, dict.instance->record.value_size == 10);
 	PLANCK_UNIT_ASSERT_TRUE(tc, skiplist != NULL);
@@ -483,6 +484,125 @@ test_slhandler_cursor_range_exact_results(
 	dictionary_delete_dictionary(&dict);
 }
 
+/**
+@brief	  Tests a batch of sorted records inserted through the handler.
+@param	  tc
+				Test case.
+*/
+void
+test_slhandler_insert_batch(
+	planck_unit_test_t *tc
+) {
+	PRINT_HEADER();
+
+	ion_dictionary_t			dict;
+	ion_dictionary_handler_t	handler;
+	ion_status_t				status;
+	int							keys[20];
+	char						values[20][10];
+	char						value[10];
+	int							i;
+
+	sldict_init(&handler);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &dict, 1, key_type_numeric_signed, sizeof(int), 10, 7));
+	memset(values, 0, sizeof(values));
+
+	for (i = 0; i < 20; i++) {
+		keys[i] = 1000 + i * 10;
+		sprintf(values[i], "t%d", i);
+	}
+
+	status = sldict_insert_batch(&dict, keys, values, 20);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == status.error);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 20, status.count);
+
+	for (i = 0; i < 20; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get(&dict, &keys[i], value).error);
+		PLANCK_UNIT_ASSERT_STR_ARE_EQUAL(tc, values[i], value);
+	}
+
+	dictionary_delete_dictionary(&dict);
+}
+
+/**
+@brief	  Tests the counters a skip list reports through the dictionary interface.
+@param	  tc
+				Test case.
+*/
+void
+test_slhandler_stats(
+	planck_unit_test_t *tc
+) {
+	PRINT_HEADER();
+
+	ion_dictionary_t			dict;
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_stats_t		stats;
+	char						value[10];
+	int							i;
+
+	sldict_init(&handler);
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_create(&handler, &dict, 1, key_type_numeric_signed, sizeof(int), 10, 7));
+	memset(value, 0, sizeof(value));
+
+	for (i = 0; i < 20; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_insert(&dict, &i, value).error);
+	}
+
+	for (i = 0; i < 10; i++) {
+		PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get(&dict, &i, value).error);
+	}
+
+	for (i = 0; i < 4; i++) {
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 1, dictionary_delete(&dict, &i).count);
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, err_ok == dictionary_get_stats(&dict, &stats));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 20, stats.num_inserts);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 4, stats.num_deletes);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 16, stats.num_records);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.num_lookups >= 10);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.num_probes > 0);
+	PLANCK_UNIT_ASSERT_TRUE(tc, stats.height > 0);
+
+	dictionary_delete_dictionary(&dict);
+}
+
+/**
+@brief	  Tests that destroying a dictionary with no snapshot removes the flat
+			file copy left by an earlier close.
+@param	  tc
+				Test case.
+*/
+void
+test_slhandler_destroy_flat_file_copy(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	ff_handler;
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dict;
+	char						filename[ION_MAX_FILENAME_LENGTH];
+	FILE						*file;
+	int							key		= 1;
+	int							value	= 10;
+
+	ffdict_init(&ff_handler);
+	sldict_init(&handler);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_create(&ff_handler, &dict, 41, key_type_numeric_signed, sizeof(int), sizeof(int), 4));
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_insert(&dict, &key, &value).error);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_close(&dict));
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, dictionary_destroy_dictionary(&handler, 41));
+
+	dictionary_get_filename(41, "ffs", filename);
+	file = fopen(filename, "rb");
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == file);
+
+	if (NULL != file) {
+		fclose(file);
+	}
+}
+
 /**
 @brief	  Creates the suite to test using PlanckUnit test cases.
 @return	 Pointer to a PlanckUnit test suite.
@@ -506,6 +626,15 @@ skiplist_handler_getsuite(
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_slhandler_cursor_range_lower_missing);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_slhandler_cursor_range_exact_results);
 
+	/* Batch insert test */
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_slhandler_insert_batch);
+
+	/* Counters test */
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_slhandler_stats);
+
+	/* Destruction test */
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_slhandler_destroy_flat_file_copy);
+
 	return suite;
 }
 
@@ -177,6 +177,62 @@ test_dictionary_compare_numerics(
 	}
 }
 
+/**
+@brief		Checks that the native comparators picked for each key size order
+			keys the same way as the byte-wise ones.
+*/
+void
+test_dictionary_compare_fixed_width(
+	planck_unit_test_t *tc
+) {
+	int64_t		values[]	= { INT64_MIN, -65536, -129, -128, -1, 0, 1, 127, 128, 255, 256, 65535, INT32_MAX, INT64_MAX };
+	int			num_values	= sizeof(values) / sizeof(values[0]);
+	int			size;
+	int			i;
+	int			j;
+
+	for (size = 1; size <= 8; size *= 2) {
+		ion_dictionary_compare_t	is_signed	= dictionary_switch_compare(key_type_numeric_signed, size);
+		ion_dictionary_compare_t	is_unsigned = dictionary_switch_compare(key_type_numeric_unsigned, size);
+
+		PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_signed_value != is_signed);
+		PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_unsigned_value != is_unsigned);
+
+		for (i = 0; i < num_values; i++) {
+			for (j = 0; j < num_values; j++) {
+				ion_byte_t	first[sizeof(int64_t)];
+				ion_byte_t	second[sizeof(int64_t)];
+
+				/* truncate to the key width the way a cast would */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+				memcpy(first, &values[i], size);
+				memcpy(second, &values[j], size);
+#else
+				memcpy(first, (ion_byte_t *) &values[i] + sizeof(int64_t) - size, size);
+				memcpy(second, (ion_byte_t *) &values[j] + sizeof(int64_t) - size, size);
+#endif
+
+				PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_signed_value(first, second, size) == is_signed(first, second, size));
+				PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_unsigned_value(first, second, size) == is_unsigned(first, second, size));
+			}
+		}
+	}
+
+	/* other sizes keep the byte-wise comparators */
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_signed_value == dictionary_switch_compare(key_type_numeric_signed, 3));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_compare_unsigned_value == dictionary_switch_compare(key_type_numeric_unsigned, 16));
+
+	/* char arrays compare every byte, including any after a NUL */
+	{
+		ion_dictionary_compare_t compare = dictionary_switch_compare(key_type_char_array, 4);
+
+		PLANCK_UNIT_ASSERT_TRUE(tc, ION_IS_EQUAL == compare("ab\0x", "ab\0x", 4));
+		PLANCK_UNIT_ASSERT_TRUE(tc, ION_ZERO > compare("ab\0x", "ab\0y", 4));
+		PLANCK_UNIT_ASSERT_TRUE(tc, 1 == compare("\xff", "\x00", 1));
+		PLANCK_UNIT_ASSERT_TRUE(tc, -1 == compare("\x00", "\xff", 1));
+	}
+}
+
 void
 test_dictionary_master_table(
 	planck_unit_test_t *tc
@@ -326,13 +382,284 @@ test_dictionary_master_table(
 	/**************/
 }
 
+/**
+@brief		Tests that a master table of an older format is refused on open.
+*/
+void
+test_dictionary_master_table_version(
+	planck_unit_test_t *tc
+) {
+	ion_err_t						err;
+	ion_dictionary_config_info_t	old_master_row = { .id = 1 };
+
+	err = ion_close_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	fremove(ION_MASTER_TABLE_FILENAME);
+
+	/* The master row as it was written before the format had a version */
+	err = ion_init_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	err = ion_master_table_write(&old_master_row, 0);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	err = ion_close_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	err = ion_init_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_file_read_error, err);
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == ion_master_table_file);
+
+	err = ion_delete_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+}
+
+void
+test_dictionary_hash_functions(
+	planck_unit_test_t *tc
+) {
+	char	key_one[16]		= "abc";
+	char	key_two[16]		= "abc";
+	int		int_one			= 42;
+	int		int_two			= 43;
+	char	prefix_key[16];
+	char	slots[64];
+	int		num_slots;
+	int		i;
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == dictionary_switch_hash(dictionary_hash_type_builtin, key_type_char_array));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_mix64 == dictionary_switch_hash(dictionary_hash_type_mix64, key_type_numeric_signed));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_fnv1a == dictionary_switch_hash(dictionary_hash_type_fnv1a, key_type_char_array));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_mix64_string == dictionary_switch_hash(dictionary_hash_type_mix64, key_type_null_terminated_string));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_fnv1a_string == dictionary_switch_hash(dictionary_hash_type_fnv1a, key_type_null_terminated_string));
+
+	/* Fixed-width fast paths are deterministic and tell neighbouring keys apart */
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_mix64(&int_one, sizeof(int)) == dictionary_hash_mix64(&(int) { 42 }, sizeof(int)));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_mix64(&int_one, sizeof(int)) != dictionary_hash_mix64(&int_two, sizeof(int)));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_fnv1a(&int_one, sizeof(int)) != dictionary_hash_fnv1a(&int_two, sizeof(int)));
+
+	/* Fixed-width keys hash every byte, strings stop at the terminator */
+	key_two[8] = 'x';
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_mix64(key_one, sizeof(key_one)) != dictionary_hash_mix64(key_two, sizeof(key_two)));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_mix64_string(key_one, sizeof(key_one)) == dictionary_hash_mix64_string(key_two, sizeof(key_two)));
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_fnv1a_string(key_one, sizeof(key_one)) == dictionary_hash_fnv1a_string(key_two, sizeof(key_two)));
+
+	/* Keys sharing a long prefix still spread over the slots */
+	memset(slots, 0, sizeof(slots));
+	num_slots = 0;
+
+	for (i = 0; i < 64; i++) {
+		memset(prefix_key, 0, sizeof(prefix_key));
+		sprintf(prefix_key, "key_%05d", i);
+
+		int slot = (int) (dictionary_hash_mix64(prefix_key, sizeof(prefix_key)) % 64);
+
+		if (!slots[slot]) {
+			slots[slot] = 1;
+			num_slots++;
+		}
+	}
+
+	PLANCK_UNIT_ASSERT_TRUE(tc, num_slots >= 32);
+}
+
+void
+test_dictionary_hash_dictionary(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t		handler;
+	ion_dictionary_t				dictionary;
+	ion_dictionary_config_info_t	config;
+	ion_err_t						err;
+	ion_status_t					status;
+	char							key[16];
+	int								value;
+	int								i;
+
+	/* Cleanup, just in case */
+	err = ion_close_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	fremove(ION_MASTER_TABLE_FILENAME);
+
+	err = ion_init_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	linear_hash_dict_init(&handler);
+	err = ion_master_table_create_dictionary_with_hash(&handler, &dictionary, key_type_char_array, sizeof(key), sizeof(int), 0, dictionary_hash_type_mix64);
+
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_type_mix64 == dictionary.instance->hash_type);
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_mix64 == dictionary.instance->hash);
+
+	for (i = 0; i < 100; i++) {
+		memset(key, 0, sizeof(key));
+		sprintf(key, "key_%05d", i);
+		status = dictionary_insert(&dictionary, key, &i);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, status.error);
+	}
+
+	err = ion_lookup_in_master_table(dictionary.instance->id, &config);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_type_mix64 == config.hash_type);
+
+	/* The hash is rebound on open, before any key is placed */
+	ion_dictionary_id_t id = dictionary.instance->id;
+
+	err = ion_close_dictionary(&dictionary);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	err = ion_open_dictionary(&handler, &dictionary, id);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_type_mix64 == dictionary.instance->hash_type);
+	PLANCK_UNIT_ASSERT_TRUE(tc, dictionary_hash_mix64 == dictionary.instance->hash);
+
+	for (i = 0; i < 100; i++) {
+		memset(key, 0, sizeof(key));
+		sprintf(key, "key_%05d", i);
+		status = dictionary_get(&dictionary, key, &value);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, status.error);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, i, value);
+	}
+
+	err = ion_delete_dictionary(&dictionary, id);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	/* An in-memory hash map places keys the same way */
+	oadict_init(&handler);
+	err = dictionary_create_with_hash(&handler, &dictionary, 1, key_type_char_array, sizeof(key), sizeof(int), 200, dictionary_hash_type_fnv1a);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	for (i = 0; i < 100; i++) {
+		memset(key, 0, sizeof(key));
+		sprintf(key, "key_%05d", i);
+		status = dictionary_insert(&dictionary, key, &i);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, status.error);
+	}
+
+	for (i = 0; i < 100; i++) {
+		memset(key, 0, sizeof(key));
+		sprintf(key, "key_%05d", i);
+		status = dictionary_get(&dictionary, key, &value);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, status.error);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, i, value);
+	}
+
+	err = dictionary_delete_dictionary(&dictionary);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	err = ion_close_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	err = ion_delete_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+}
+
+void
+test_dictionary_snapshot(
+	planck_unit_test_t *tc
+) {
+	ion_dictionary_handler_t	handler;
+	ion_dictionary_t			dictionary;
+	ion_dictionary_id_t			id;
+	ion_err_t					err;
+	ion_status_t				status;
+	char						filename[ION_MAX_FILENAME_LENGTH];
+	FILE						*file;
+	char						key[16];
+	int							value;
+	int							i;
+
+	/* Cleanup, just in case */
+	err = ion_close_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	fremove(ION_MASTER_TABLE_FILENAME);
+
+	err = ion_init_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	/* A skiplist is written out in key order, duplicates included */
+	sldict_init(&handler);
+	err = ion_master_table_create_dictionary(&handler, &dictionary, key_type_numeric_signed, sizeof(int), sizeof(int), 7);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	for (i = 0; i < 300; i++) {
+		value	= i % 150;
+		status	= dictionary_insert(&dictionary, &value, &i);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, status.error);
+	}
+
+	id	= dictionary.instance->id;
+	err = ion_close_dictionary(&dictionary);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	dictionary_get_filename(id, "sls", filename);
+	file = fopen(filename, "rb");
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL != file);
+	fclose(file);
+
+	err = ion_open_dictionary(&handler, &dictionary, id);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	PLANCK_UNIT_ASSERT_TRUE(tc, NULL == fopen(filename, "rb"));
+
+	for (i = 0; i < 150; i++) {
+		status = dictionary_get(&dictionary, &i, &value);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, status.error);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, i, value);
+
+		status = dictionary_delete(&dictionary, &i);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, 2, status.count);
+	}
+
+	err = ion_delete_dictionary(&dictionary, id);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	/* A grouped hash map is refilled by the hash it was created with */
+	oadict_init(&handler);
+	err = ion_master_table_create_dictionary_with_hash(&handler, &dictionary, key_type_char_array, sizeof(key), sizeof(int), 40, dictionary_hash_type_mix64);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, oah_set_layout((ion_hashmap_t *) dictionary.instance, oah_layout_groups));
+
+	for (i = 0; i < 100; i++) {
+		memset(key, 0, sizeof(key));
+		sprintf(key, "key_%05d", i);
+		status = dictionary_insert(&dictionary, key, &i);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, status.error);
+	}
+
+	id	= dictionary.instance->id;
+	err = ion_close_dictionary(&dictionary);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	err = ion_open_dictionary(&handler, &dictionary, id);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	PLANCK_UNIT_ASSERT_TRUE(tc, oah_layout_groups == ((ion_hashmap_t *) dictionary.instance)->layout);
+
+	for (i = 0; i < 100; i++) {
+		memset(key, 0, sizeof(key));
+		sprintf(key, "key_%05d", i);
+		status = dictionary_get(&dictionary, key, &value);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, status.error);
+		PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, i, value);
+	}
+
+	err = ion_delete_dictionary(&dictionary, id);
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+
+	err = ion_close_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+	err = ion_delete_master_table();
+	PLANCK_UNIT_ASSERT_INT_ARE_EQUAL(tc, err_ok, err);
+}
+
 planck_unit_suite_t *
 dictionary_getsuite(
 ) {
 	planck_unit_suite_t *suite = planck_unit_new_suite();
 
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_dictionary_compare_numerics);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_dictionary_compare_fixed_width);
 	PLANCK_UNIT_ADD_TO_SUITE(suite, test_dictionary_master_table);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_dictionary_master_table_version);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_dictionary_hash_functions);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_dictionary_hash_dictionary);
+	PLANCK_UNIT_ADD_TO_SUITE(suite, test_dictionary_snapshot);
 
 	return suite;
 }